@@ -0,0 +1,288 @@
+//
+//  vxfission_golden_test.cpp
+//  VXFission Tests
+//
+//  Golden-output regression test. Renders every case in goldenCases() and
+//  compares a compact fingerprint of each output with the one stored in
+//  Tests/Golden/vxfission_golden.txt:
+//    - rms:   level of every 1024-frame window per channel, in dB
+//    - probe: 16 samples per channel, evenly spaced through the render
+//  Levels must agree within kRmsToleranceDb (windows quieter than
+//  kQuietFloorDb only need to stay quiet) and samples within
+//  kProbeAbsTolerance + kProbeRelTolerance × |golden|. That admits the
+//  reassociation noise of SIMD and block-processing rewrites (~1e-6) and
+//  rejects anything audible.
+//
+//  Each case is also rendered with the core's state saved partway through and
+//  restored into a second core for the rest (saveState() / restoreState()),
+//  as the Audio Unit renders a bounce, and in place, with the input in the
+//  output buffers (see RenderOptions). Each must match the plain render
+//  exactly.
+//
+//  Dense delay-time automation (jumps and ramps at arbitrary offsets) is
+//  rendered both ways the Audio Unit can apply it: split into one process()
+//  call per event, and queued with scheduleDelayTime() into one call per
+//  buffer. The two must be bit-identical.
+//
+//    vxfission_golden_test [golden.txt]            compare
+//    vxfission_golden_test --update [golden.txt]   rewrite the golden file
+//
+//  The goldens are for the default Haas interpolator; other builds skip.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "vxfission_test_renders.hpp"
+
+namespace {
+
+constexpr size_t kWindow            = 1024;
+constexpr int    kProbes            = 16;
+constexpr double kRmsToleranceDb    = 0.05;
+constexpr double kQuietFloorDb      = -90.0;
+constexpr double kSilenceDb         = -200.0;  // stored for all-zero windows
+constexpr double kProbeAbsTolerance = 1e-4;
+constexpr double kProbeRelTolerance = 1e-3;
+constexpr int    kSkipped           = 77;      // ctest SKIP_RETURN_CODE
+
+struct Fingerprint {
+    std::vector<std::vector<double>> rms;    // [channel][window], dB
+    std::vector<std::vector<double>> probe;  // [channel][probe]
+};
+
+Fingerprint fingerprint(const vxfission_test::Render &render) {
+    Fingerprint print;
+    for (const std::vector<float> &channel : render.output) {
+        std::vector<double> levels;
+        for (size_t start = 0; start < channel.size(); start += kWindow) {
+            const size_t end = std::min(channel.size(), start + kWindow);
+            double sum = 0.0;
+            for (size_t t = start; t < end; ++t) sum += (double)channel[t] * channel[t];
+            double meanSquare = sum / (double)(end - start);
+            levels.push_back(meanSquare > 0.0 ? 10.0 * std::log10(meanSquare) : kSilenceDb);
+        }
+        std::vector<double> probes;
+        for (int p = 0; p < kProbes; ++p) probes.push_back(channel[(channel.size() - 1) * p / (kProbes - 1)]);
+        print.rms.push_back(levels);
+        print.probe.push_back(probes);
+    }
+    return print;
+}
+
+void writeRow(std::FILE *f, const char *label, size_t channel, const std::vector<double> &values, const char *format) {
+    std::fprintf(f, "%s%zu", label, channel);
+    for (double v : values) {
+        std::fputc(' ', f);
+        std::fprintf(f, format, v);
+    }
+    std::fputc('\n', f);
+}
+
+// Golden file: a configuration line, then per case a "case <name>" line and
+// one "rms<c>" and "probe<c>" line per output channel. '#' lines are comments.
+bool readGoldens(const std::string &path, std::string &configuration, std::map<std::string, Fingerprint> &goldens) {
+    std::ifstream file(path);
+    if (!file) return false;
+    std::string line;
+    Fingerprint *current = nullptr;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        std::string key;
+        fields >> key;
+        if (key == "config") {
+            std::getline(fields >> std::ws, configuration);
+        } else if (key == "case") {
+            std::string name;
+            fields >> name;
+            current = &goldens[name];
+        } else if (current && (key.rfind("rms", 0) == 0 || key.rfind("probe", 0) == 0)) {
+            std::vector<double> values;
+            for (double v; fields >> v; ) values.push_back(v);
+            (key[0] == 'r' ? current->rms : current->probe).push_back(values);
+        }
+    }
+    return true;
+}
+
+bool writeGoldens(const std::string &path, const std::vector<vxfission_test::RenderCase> &cases) {
+    std::FILE *f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+    std::fprintf(f, "# VX Fission golden renders (%.1f s each, %u-frame blocks).\n", vxfission_test::kSeconds, vxfission_test::kBlockSize);
+    std::fprintf(f, "# rms<c>: dB per %zu-frame window; probe<c>: %d evenly spaced samples.\n", kWindow, kProbes);
+    std::fprintf(f, "# Regenerate with: vxfission_golden_test --update\n");
+    std::fprintf(f, "config %s\n", vxfission_test::buildConfiguration().c_str());
+    for (const vxfission_test::RenderCase &c : cases) {
+        vxfission_test::Render render = vxfission_test::makeRender(c);
+        vxfission_test::renderCase(c, render);
+        Fingerprint print = fingerprint(render);
+        std::fprintf(f, "case %s\n", c.name.c_str());
+        for (size_t ch = 0; ch < print.rms.size(); ++ch) {
+            writeRow(f, "rms", ch, print.rms[ch], "%.2f");
+            writeRow(f, "probe", ch, print.probe[ch], "%.6g");
+        }
+    }
+    return std::fclose(f) == 0;
+}
+
+// Returns an empty string when `actual` matches `golden`, else what differs.
+std::string compare(const Fingerprint &golden, const Fingerprint &actual) {
+    char message[160];
+    if (golden.rms.size() != actual.rms.size() || golden.probe.size() != actual.probe.size()) return "channel count differs";
+    for (size_t ch = 0; ch < actual.rms.size(); ++ch) {
+        if (golden.rms[ch].size() != actual.rms[ch].size()) return "length differs";
+        for (size_t w = 0; w < actual.rms[ch].size(); ++w) {
+            double g = golden.rms[ch][w], a = actual.rms[ch][w];
+            bool quiet = g < kQuietFloorDb && a < kQuietFloorDb;
+            if (!quiet && std::abs(g - a) > kRmsToleranceDb) {
+                std::snprintf(message, sizeof message, "ch %zu window %zu: %.2f dB, golden %.2f dB", ch, w, a, g);
+                return message;
+            }
+        }
+        if (golden.probe[ch].size() != actual.probe[ch].size()) return "probe count differs";
+        for (size_t p = 0; p < actual.probe[ch].size(); ++p) {
+            double g = golden.probe[ch][p], a = actual.probe[ch][p];
+            if (std::abs(g - a) > kProbeAbsTolerance + kProbeRelTolerance * std::abs(g)) {
+                std::snprintf(message, sizeof message, "ch %zu probe %zu: %.6g, golden %.6g", ch, p, a, g);
+                return message;
+            }
+        }
+    }
+    return {};
+}
+
+// Pink noise, stereo, 128-frame buffers with 16 events each (half jumps, half
+// ramps of up to 20 ms), bypassed for a stretch in the middle so queued
+// events also land on the bypass path. Returns the output.
+std::vector<std::vector<float>> renderAutomation(bool coalesced) {
+    constexpr uint32_t kBuffer   = 128;
+    constexpr int      kPerBuffer = 16;
+    constexpr double   kRate     = 48000.0;
+    const size_t frames  = (size_t)(vxfission_test::kSeconds * kRate);
+    const size_t buffers = frames / kBuffer;
+    std::vector<std::vector<float>> input, output(2, std::vector<float>(frames, 0.0f));
+    for (int ch = 0; ch < 2; ++ch) input.push_back(vxfission_test::makeStimulus(vxfission_test::Stimulus::PinkNoise, kRate, frames, ch));
+
+    VXFissionExtensionDSPCore core;
+    core.setMaximumFramesToRender(kBuffer);
+    core.initialize(2, 2, kRate);
+    uint32_t seed = 0x5eed1234u;
+    auto next = [&seed] { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+    struct Event { uint32_t offset; float valueMs; uint32_t rampFrames; };
+    for (size_t b = 0; b < buffers; ++b) {
+        std::vector<Event> events;
+        for (int k = 0; k < kPerBuffer; ++k) {
+            const uint32_t offset = next() % kBuffer;
+            const float    value  = (float)(next() % 101) - 50.0f;
+            const uint32_t ramp   = (next() & 1) ? next() % (uint32_t)(0.020 * kRate) : 0;
+            events.push_back({ offset, value, ramp });
+        }
+        std::stable_sort(events.begin(), events.end(), [](const Event &a, const Event &c) { return a.offset < c.offset; });
+        core.setBypass(b >= buffers * 2 / 5 && b < buffers * 3 / 5);
+
+        const size_t pos = b * kBuffer;
+        auto render = [&](uint32_t from, uint32_t to) {
+            const float *in[2]  = { input[0].data() + pos + from, input[1].data() + pos + from };
+            float       *out[2] = { output[0].data() + pos + from, output[1].data() + pos + from };
+            core.process(std::span<const float *>(in, 2), std::span<float *>(out, 2), to - from);
+        };
+        if (coalesced) {
+            for (const Event &e : events) core.scheduleDelayTime(e.offset, e.valueMs, e.rampFrames);
+            render(0, kBuffer);
+            continue;
+        }
+        uint32_t done = 0;
+        for (const Event &e : events) {
+            if (e.offset > done) render(done, e.offset);
+            done = std::max(done, e.offset);
+            core.rampDelayTime(e.valueMs, e.rampFrames);
+        }
+        if (done < kBuffer) render(done, kBuffer);
+    }
+    return output;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bool update = false;
+    std::string path = VXFISSION_TESTS_DIR "/Golden/vxfission_golden.txt";
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--update") == 0) update = true;
+        else path = argv[i];
+    }
+
+    const std::vector<vxfission_test::RenderCase> cases = vxfission_test::goldenCases();
+    if (update) {
+        if (!writeGoldens(path, cases)) {
+            std::fprintf(stderr, "error: cannot write %s\n", path.c_str());
+            return 1;
+        }
+        std::printf("wrote %zu cases to %s\n", cases.size(), path.c_str());
+        return 0;
+    }
+
+    std::string configuration;
+    std::map<std::string, Fingerprint> goldens;
+    if (!readGoldens(path, configuration, goldens)) {
+        std::fprintf(stderr, "error: cannot read %s (run with --update to create it)\n", path.c_str());
+        return 1;
+    }
+    if (configuration != vxfission_test::buildConfiguration()) {
+        std::printf("skipped: goldens are for '%s', this build is '%s'\n",
+                    configuration.c_str(), vxfission_test::buildConfiguration().c_str());
+        return kSkipped;
+    }
+
+    int failures = 0;
+    for (const vxfission_test::RenderCase &c : cases) {
+        auto golden = goldens.find(c.name);
+        if (golden == goldens.end()) {
+            std::printf("FAIL %s: no golden (run with --update)\n", c.name.c_str());
+            ++failures;
+            continue;
+        }
+        vxfission_test::Render render = vxfission_test::makeRender(c);
+        vxfission_test::renderCase(c, render);
+        std::string difference = compare(golden->second, fingerprint(render));
+        if (!difference.empty()) {
+            std::printf("FAIL %s: %s\n", c.name.c_str(), difference.c_str());
+            ++failures;
+        }
+
+        // Resumed from a snapshot at the block edge nearest 40 % of the way in.
+        vxfission_test::Render resumed = vxfission_test::makeRender(c);
+        const size_t resumeAt = render.input[0].size() * 2 / 5 / vxfission_test::kBlockSize * vxfission_test::kBlockSize;
+        if (vxfission_test::renderCase(c, resumed, { .resumeAt = resumeAt }) < 0.0 || resumed.output != render.output) {
+            std::printf("FAIL %s: differs when resumed from a state snapshot at frame %zu\n", c.name.c_str(), resumeAt);
+            ++failures;
+        }
+
+        vxfission_test::Render offline = vxfission_test::makeRender(c);
+        vxfission_test::renderCase(c, offline, { .asOfflineHost = true });
+        if (offline.output != render.output) {
+            std::printf("FAIL %s: differs when rendered offline as the Audio Unit does\n", c.name.c_str());
+            ++failures;
+        }
+
+        vxfission_test::Render inPlace = vxfission_test::makeRender(c);
+        if (vxfission_test::renderCase(c, inPlace, { .inPlace = true }) < 0.0 || inPlace.output != render.output) {
+            std::printf("FAIL %s: differs when rendered in place\n", c.name.c_str());
+            ++failures;
+        }
+    }
+    if (renderAutomation(false) != renderAutomation(true)) {
+        std::printf("FAIL automation: coalesced events differ from split renders\n");
+        ++failures;
+    }
+    std::printf("%zu cases and the automation check, %d failed\n", cases.size(), failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,176 @@
+//
+//  vxfission_perf_test.cpp
+//  VXFission Tests
+//
+//  Performance gate. Times a representative subset of the golden renders
+//  (median of kRepeats) and fails when any case's ns/sample regresses past
+//  its stored baseline in Tests/Baselines/vxfission_perf_baseline.txt by more
+//  than the threshold (default 25 %).
+//
+//  Timings are divided by a fixed scalar calibration workload timed in the
+//  same run, also the median of kRepeats, so the baseline holds cost relative
+//  to the machine rather than nanoseconds; a baseline recorded on one machine
+//  stays roughly meaningful on another. Medians rather than best times keep
+//  one lucky repeat, on either side of the ratio, from setting the result.
+//  Still, re-record it (--update) when the reference machine or compiler
+//  changes, from the median of several runs.
+//
+//    vxfission_perf_test [--threshold 0.25] [baseline.txt]
+//    vxfission_perf_test --update [baseline.txt]
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "vxfission_test_renders.hpp"
+
+namespace {
+
+constexpr int kRepeats = 15;
+constexpr int kSkipped = 77;  // ctest SKIP_RETURN_CODE
+
+double median(std::vector<double> values) {
+    std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+    return values[values.size() / 2];
+}
+
+// Fixed-size scalar work with a serial dependency (a one-pole filter over a
+// noise buffer), median of kRepeats: ns per sample of it.
+double calibrationNsPerSample() {
+    std::vector<float> x(1 << 20);
+    uint32_t seed = 1;
+    for (float &v : x) {
+        seed = seed * 1664525u + 1013904223u;
+        v = (float)(seed >> 8) / 8388608.0f - 1.0f;
+    }
+    std::vector<double> times;
+    volatile float sink = 0.0f;
+    for (int r = 0; r < kRepeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        float y = 0.0f;
+        for (float v : x) y += 0.01f * (v - y);
+        sink = y;
+        auto stop = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double>(stop - start).count());
+    }
+    (void)sink;
+    return median(times) * 1e9 / (double)x.size();
+}
+
+std::vector<vxfission_test::RenderCase> perfCases() {
+    static const char *names[] = {
+        "pink/44100/knob25", "pink/48000/knob25", "pink/96000/knob25",
+        "pink/48000/sweep-bounce", "sweep/48000/knob-50", "impulse/48000/knob25",
+        "silence/48000/knob25", "pink/48000/6to6", "pink/48000/1to2-os4",
+    };
+    std::vector<vxfission_test::RenderCase> cases;
+    for (const vxfission_test::RenderCase &c : vxfission_test::goldenCases()) {
+        if (std::find_if(std::begin(names), std::end(names), [&](const char *n) { return c.name == n; }) != std::end(names)) {
+            cases.push_back(c);
+        }
+    }
+    return cases;
+}
+
+// ns per frame, median of kRepeats, each render repeated to at least ~20 ms.
+double timeCase(const vxfission_test::RenderCase &c) {
+    vxfission_test::Render render = vxfission_test::makeRender(c);
+    const double frames = (double)render.input[0].size();
+    std::vector<double> times;
+    for (int r = 0; r < kRepeats; ++r) {
+        double seconds = 0.0;
+        int    passes  = 0;
+        while (seconds < 0.02 || passes < 2) {
+            seconds += vxfission_test::renderCase(c, render);
+            ++passes;
+        }
+        times.push_back(seconds / passes);
+    }
+    return median(times) * 1e9 / frames;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bool   update    = false;
+    double threshold = 0.25;
+    std::string path = VXFISSION_TESTS_DIR "/Baselines/vxfission_perf_baseline.txt";
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--update") == 0) update = true;
+        else if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) threshold = std::strtod(argv[++i], nullptr);
+        else path = argv[i];
+    }
+
+    const double calibration = calibrationNsPerSample();
+    const std::vector<vxfission_test::RenderCase> cases = perfCases();
+    const std::string configuration = vxfission_test::buildConfiguration() + " simd=" + simdInstructionSetName()
+                                    + (VXFISSION_PROFILING ? " profiling" : "");
+
+    if (update) {
+        std::FILE *f = std::fopen(path.c_str(), "w");
+        if (!f) {
+            std::fprintf(stderr, "error: cannot write %s\n", path.c_str());
+            return 1;
+        }
+        std::fprintf(f, "# VX Fission performance baseline: ns/sample divided by the calibration\n");
+        std::fprintf(f, "# workload's ns/sample (%.3f ns on the recording machine).\n", calibration);
+        std::fprintf(f, "# Regenerate with: vxfission_perf_test --update\n");
+        std::fprintf(f, "config %s\n", configuration.c_str());
+        for (const vxfission_test::RenderCase &c : cases) {
+            double ns = timeCase(c);
+            std::fprintf(f, "case %s %.3f\n", c.name.c_str(), ns / calibration);
+            std::printf("%-28s %8.2f ns/sample\n", c.name.c_str(), ns);
+        }
+        std::fclose(f);
+        return 0;
+    }
+
+    std::ifstream file(path);
+    if (!file) {
+        std::fprintf(stderr, "error: cannot read %s (run with --update to create it)\n", path.c_str());
+        return 1;
+    }
+    std::string baselineConfiguration;
+    std::map<std::string, double> baselines;
+    for (std::string line; std::getline(file, line); ) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        std::string key, name;
+        fields >> key;
+        if (key == "config") {
+            std::getline(fields >> std::ws, baselineConfiguration);
+        } else if (key == "case" && (fields >> name)) {
+            fields >> baselines[name];
+        }
+    }
+    if (baselineConfiguration != configuration) {
+        std::printf("skipped: baseline is for '%s', this build is '%s'\n", baselineConfiguration.c_str(), configuration.c_str());
+        return kSkipped;
+    }
+
+    std::printf("calibration %.3f ns/sample, threshold +%.0f%%\n", calibration, threshold * 100.0);
+    std::printf("%-28s %12s %12s %10s\n", "case", "ns/sample", "baseline", "change");
+    int failures = 0;
+    for (const vxfission_test::RenderCase &c : cases) {
+        const double ns = timeCase(c);
+        auto baseline = baselines.find(c.name);
+        if (baseline == baselines.end()) {
+            std::printf("%-28s %12.2f %12s %10s\n", c.name.c_str(), ns, "-", "new");
+            continue;
+        }
+        const double expected = baseline->second * calibration;
+        const double change   = ns / expected - 1.0;
+        const bool   failed   = change > threshold;
+        std::printf("%-28s %12.2f %12.2f %+9.1f%%%s\n", c.name.c_str(), ns, expected, change * 100.0, failed ? "  FAIL" : "");
+        failures += failed;
+    }
+    std::printf("%zu cases, %d regressed\n", cases.size(), failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,307 @@
+//
+//  vxfission_test_renders.hpp
+//  VXFission Tests
+//
+//  The fixed renders shared by the golden-output and performance tests: every
+//  stimulus at every test rate and knob setting, plus a few channel layouts.
+//  Stimuli are generated here (seeded, no files), so a case name alone
+//  reproduces its input exactly.
+//
+
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "VXFissionExtensionDSPCore.hpp"
+
+namespace vxfission_test {
+
+constexpr double   kSeconds   = 0.5;   // each render
+constexpr uint32_t kBlockSize = 256;   // host block size for every render
+
+enum class Stimulus { Impulse, Sweep, PinkNoise, Silence, DC };
+
+// A fixed knob, or an automation sweep applied as sample-accurate ramps.
+enum class Knob { Fixed, SweepUp, SweepBounce };
+
+// Bypass engaged over the middle third of the render, with or without trails.
+enum class Bypass { Off, MidRender, MidRenderTrails };
+
+struct RenderCase {
+    std::string name;
+    Stimulus stimulus     = Stimulus::PinkNoise;
+    double   sampleRate   = 48000.0;
+    Knob     knob         = Knob::Fixed;
+    float    delayTimeMs  = 0.0f;      // Knob::Fixed only
+    int      inChannels   = 1;
+    int      outChannels  = 2;
+    int      oversampling = 1;
+    VXFissionReverbEngine reverb = VXFissionReverbEngine::Freeverb;
+    Bypass   bypass       = Bypass::Off;
+    VXFissionQualityMode quality = VXFissionQualityMode::Standard;
+    std::optional<VXFissionQualityMode> qualityAtThird;  // forced switch a third of the way in
+};
+
+inline const char *stimulusName(Stimulus stimulus) {
+    switch (stimulus) {
+        case Stimulus::Impulse:   return "impulse";
+        case Stimulus::Sweep:     return "sweep";
+        case Stimulus::PinkNoise: return "pink";
+        case Stimulus::Silence:   return "silence";
+        case Stimulus::DC:        return "dc";
+    }
+    return "?";
+}
+
+inline const char *qualityModeName(VXFissionQualityMode mode) {
+    switch (mode) {
+        case VXFissionQualityMode::Auto:     return "auto";
+        case VXFissionQualityMode::Eco:      return "eco";
+        case VXFissionQualityMode::Standard: return "standard";
+        case VXFissionQualityMode::High:     return "high";
+    }
+    return "?";
+}
+
+// Every stimulus × 44.1/48/96 kHz × knob −50/−25/0/+25/+50 and two sweeps,
+// mono in to stereo out; then pink noise through the other layouts and the
+// oversampled compressor, a few renders through the convolution reverb (its
+// synthetic room, tail inline), bypass engaged and released mid-render, and
+// the eco and high quality tiers, fixed and switched mid-render.
+inline std::vector<RenderCase> goldenCases() {
+    std::vector<RenderCase> cases;
+    for (Stimulus stimulus : { Stimulus::Impulse, Stimulus::Sweep, Stimulus::PinkNoise, Stimulus::Silence, Stimulus::DC }) {
+        for (double rate : { 44100.0, 48000.0, 96000.0 }) {
+            const std::string prefix = std::string(stimulusName(stimulus)) + "/" + std::to_string((int)rate) + "/";
+            for (float knob : { -50.0f, -25.0f, 0.0f, 25.0f, 50.0f }) {
+                RenderCase c;
+                c.name        = prefix + "knob" + std::to_string((int)knob);
+                c.stimulus    = stimulus;
+                c.sampleRate  = rate;
+                c.delayTimeMs = knob;
+                cases.push_back(c);
+            }
+            for (Knob sweep : { Knob::SweepUp, Knob::SweepBounce }) {
+                RenderCase c;
+                c.name       = prefix + (sweep == Knob::SweepUp ? "sweep-up" : "sweep-bounce");
+                c.stimulus   = stimulus;
+                c.sampleRate = rate;
+                c.knob       = sweep;
+                cases.push_back(c);
+            }
+        }
+    }
+    struct Layout { int in, out, oversampling; };
+    for (Layout layout : { Layout { 1, 1, 1 }, Layout { 2, 2, 1 }, Layout { 6, 6, 1 }, Layout { 1, 2, 2 }, Layout { 1, 2, 4 } }) {
+        RenderCase c;
+        c.name = "pink/48000/" + std::to_string(layout.in) + "to" + std::to_string(layout.out)
+               + (layout.oversampling > 1 ? "-os" + std::to_string(layout.oversampling) : "");
+        c.stimulus     = Stimulus::PinkNoise;
+        c.knob         = Knob::SweepBounce;
+        c.inChannels   = layout.in;
+        c.outChannels  = layout.out;
+        c.oversampling = layout.oversampling;
+        cases.push_back(c);
+    }
+    struct Convolution { Stimulus stimulus; double rate; Knob knob; };
+    for (Convolution conv : { Convolution { Stimulus::Impulse, 48000.0, Knob::Fixed },
+                              Convolution { Stimulus::PinkNoise, 48000.0, Knob::SweepBounce },
+                              Convolution { Stimulus::Sweep, 44100.0, Knob::Fixed } }) {
+        RenderCase c;
+        c.name        = std::string(stimulusName(conv.stimulus)) + "/" + std::to_string((int)conv.rate) + "/convolution";
+        c.stimulus    = conv.stimulus;
+        c.sampleRate  = conv.rate;
+        c.knob        = conv.knob;
+        c.delayTimeMs = 25.0f;
+        c.reverb      = VXFissionReverbEngine::Convolution;
+        cases.push_back(c);
+    }
+    struct BypassRender { Stimulus stimulus; Bypass bypass; VXFissionReverbEngine reverb; };
+    for (BypassRender bypass : { BypassRender { Stimulus::PinkNoise, Bypass::MidRender,       VXFissionReverbEngine::Freeverb },
+                                 BypassRender { Stimulus::PinkNoise, Bypass::MidRenderTrails, VXFissionReverbEngine::Freeverb },
+                                 BypassRender { Stimulus::Impulse,   Bypass::MidRenderTrails, VXFissionReverbEngine::Freeverb },
+                                 BypassRender { Stimulus::PinkNoise, Bypass::MidRenderTrails, VXFissionReverbEngine::Convolution } }) {
+        RenderCase c;
+        c.name        = std::string(stimulusName(bypass.stimulus)) + "/48000/bypass"
+                      + (bypass.bypass == Bypass::MidRenderTrails ? "-trails" : "")
+                      + (bypass.reverb == VXFissionReverbEngine::Convolution ? "-convolution" : "");
+        c.stimulus    = bypass.stimulus;
+        c.delayTimeMs = 25.0f;
+        c.reverb      = bypass.reverb;
+        c.bypass      = bypass.bypass;
+        cases.push_back(c);
+    }
+    struct QualityRender { Stimulus stimulus; Knob knob; VXFissionQualityMode quality; std::optional<VXFissionQualityMode> atThird; };
+    for (QualityRender quality : { QualityRender { Stimulus::Impulse,   Knob::Fixed,       VXFissionQualityMode::Eco,  {} },
+                                   QualityRender { Stimulus::Impulse,   Knob::Fixed,       VXFissionQualityMode::High, {} },
+                                   QualityRender { Stimulus::PinkNoise, Knob::SweepBounce, VXFissionQualityMode::Eco,  {} },
+                                   QualityRender { Stimulus::PinkNoise, Knob::SweepBounce, VXFissionQualityMode::High, {} },
+                                   QualityRender { Stimulus::PinkNoise, Knob::SweepBounce, VXFissionQualityMode::High, VXFissionQualityMode::Eco } }) {
+        RenderCase c;
+        c.name = std::string(stimulusName(quality.stimulus)) + "/48000/"
+               + qualityModeName(quality.quality)
+               + (quality.atThird ? std::string("-to-") + qualityModeName(*quality.atThird) : "");
+        c.stimulus       = quality.stimulus;
+        c.knob           = quality.knob;
+        c.delayTimeMs    = 25.0f;
+        c.quality        = quality.quality;
+        c.qualityAtThird = quality.atThird;
+        cases.push_back(c);
+    }
+    return cases;
+}
+
+// Input channel `channel` of a stimulus. Channels after the first get their
+// own noise seed, so multichannel renders do not collapse to copies.
+inline std::vector<float> makeStimulus(Stimulus stimulus, double sampleRate, size_t frames, int channel) {
+    std::vector<float> x(frames, 0.0f);
+    switch (stimulus) {
+        case Stimulus::Impulse:
+            x[(size_t)(0.01 * sampleRate)] = 1.0f;
+            break;
+        case Stimulus::Sweep: {
+            // Exponential sine sweep, 20 Hz to 20 kHz (or 0.45 × rate), at −6 dBFS.
+            const double f0 = 20.0, f1 = std::min(20000.0, 0.45 * sampleRate);
+            const double duration = (double)frames / sampleRate;
+            const double k = std::log(f1 / f0);
+            for (size_t t = 0; t < frames; ++t) {
+                double time = (double)t / sampleRate;
+                x[t] = 0.5f * (float)std::sin(2.0 * M_PI * f0 * duration / k * (std::exp(time / duration * k) - 1.0));
+            }
+            break;
+        }
+        case Stimulus::PinkNoise: {
+            // Paul Kellet's economy pink filter over a seeded LCG.
+            uint32_t seed = 0x9e3779b9u + 0x1000193u * (uint32_t)channel;
+            float b0 = 0.0f, b1 = 0.0f, b2 = 0.0f;
+            for (float &v : x) {
+                seed = seed * 1664525u + 1013904223u;
+                float white = (float)(seed >> 8) / 8388608.0f - 1.0f;
+                b0 = 0.99765f * b0 + white * 0.0990460f;
+                b1 = 0.96300f * b1 + white * 0.2965164f;
+                b2 = 0.57000f * b2 + white * 1.0526913f;
+                v  = 0.25f * (b0 + b1 + b2 + white * 0.1848f);
+            }
+            break;
+        }
+        case Stimulus::Silence:
+            break;
+        case Stimulus::DC:
+            std::fill(x.begin(), x.end(), 0.5f);
+            break;
+    }
+    return x;
+}
+
+struct Render {
+    std::vector<std::vector<float>> input;   // one vector per input channel
+    std::vector<std::vector<float>> output;  // one vector per output channel
+};
+
+inline Render makeRender(const RenderCase &c) {
+    const size_t frames = (size_t)(kSeconds * c.sampleRate);
+    Render render;
+    for (int ch = 0; ch < c.inChannels; ++ch) render.input.push_back(makeStimulus(c.stimulus, c.sampleRate, frames, ch));
+    render.output.assign(c.outChannels, std::vector<float>(frames, 0.0f));
+    return render;
+}
+
+// Ways of rendering a case that should not change its output:
+//   - resumeAt (a block edge): the core's state is saved there and a second
+//     core, restored from it, renders the rest.
+//   - asOfflineHost: the core is set up as the Audio Unit has it for a
+//     bounce: the convolution tail on its worker, quality on Auto (where the
+//     case renders at standard), and rendering offline switched on only
+//     after initialize(). The governor
+//     steps down after any render it times, so only a render that is
+//     neither late nor timed leaves the output unchanged.
+//   - inPlace: the input is copied into the output buffers and rendered
+//     from there, each input channel aliasing the output of the same index,
+//     as the Audio Unit pulls it. Needs no more inputs than outputs.
+struct RenderOptions {
+    size_t resumeAt      = 0;
+    bool   asOfflineHost = false;
+    bool   inPlace       = false;
+};
+
+// Renders the case into render.output through a freshly initialised core and
+// returns the wall time of the process() calls alone.
+inline double renderCase(const RenderCase &c, Render &render, const RenderOptions &options = {}) {
+    const size_t frames   = render.input[0].size();
+    const size_t resumeAt = options.resumeAt;
+    const bool   asOfflineHost = options.asOfflineHost;
+    VXFissionExtensionDSPCore cores[2];
+    for (int i = 0; i < (resumeAt > 0 ? 2 : 1); ++i) {
+        cores[i].setMaximumFramesToRender(kBlockSize);
+        cores[i].setOversampling(c.oversampling);
+        cores[i].setReverbEngine(c.reverb);
+        cores[i].setBypassTrails(c.bypass == Bypass::MidRenderTrails);
+        cores[i].setQualityMode(c.quality);
+        if (asOfflineHost) {
+            VXFissionGovernorSettings settings;
+            settings.panicLoad = 0.0;
+            cores[i].setGovernorSettings(settings);
+            if (c.quality == VXFissionQualityMode::Standard) cores[i].setQualityMode(VXFissionQualityMode::Auto);
+            cores[i].setConvolutionTailThread(ConvolutionTailThread::Worker);
+        }
+        cores[i].initialize(c.inChannels, c.outChannels, c.sampleRate);
+        if (asOfflineHost) cores[i].setRenderingOffline(true);
+    }
+    VXFissionExtensionDSPCore *core = &cores[0];
+
+    // Sweeps are host automation: ramps of a given length, as the Audio Unit
+    // schedules them from parameter ramp events. The bounce goes 0 → +50 over
+    // the first third, then +50 → −50 over the next, starting on block edges.
+    // Bypass, likewise, goes on and off at the same two edges, and a quality
+    // switch lands on the first.
+    const uint32_t third = (uint32_t)(frames / 3 / kBlockSize * kBlockSize);
+    switch (c.knob) {
+        case Knob::Fixed:       core->setDelayTime(c.delayTimeMs); break;
+        case Knob::SweepUp:     core->setDelayTime(-50.0f);        break;
+        case Knob::SweepBounce: core->setDelayTime(0.0f);          break;
+    }
+
+    if (options.inPlace) {
+        if (c.inChannels > c.outChannels) return -1.0;
+        for (int ch = 0; ch < c.inChannels; ++ch) render.output[ch] = render.input[ch];
+    }
+    const std::vector<std::vector<float>> &source = options.inPlace ? render.output : render.input;
+
+    const float *in[VXFissionChannelMap::kMaxChannels];
+    float       *out[VXFissionChannelMap::kMaxChannels];
+    auto start = std::chrono::steady_clock::now();
+    for (size_t pos = 0; pos < frames; pos += kBlockSize) {
+        if (resumeAt > 0 && pos == resumeAt && !cores[1].restoreState(core->saveState())) return -1.0;
+        if (resumeAt > 0 && pos == resumeAt) core = &cores[1];
+        if (c.knob == Knob::SweepUp && pos == 0) core->rampDelayTime(50.0f, (uint32_t)frames);
+        if (c.knob == Knob::SweepBounce) {
+            if (pos == 0)     core->rampDelayTime(50.0f, third);
+            if (pos == third) core->rampDelayTime(-50.0f, third);
+        }
+        if (c.bypass != Bypass::Off && (pos == third || pos == 2 * third)) core->setBypass(pos == third);
+        if (c.qualityAtThird && pos == third) core->setQualityMode(*c.qualityAtThird);
+        uint32_t n = (uint32_t)std::min<size_t>(kBlockSize, frames - pos);
+        for (int ch = 0; ch < c.inChannels;  ++ch) in[ch]  = source[ch].data() + pos;
+        for (int ch = 0; ch < c.outChannels; ++ch) out[ch] = render.output[ch].data() + pos;
+        core->process(std::span<const float *>(in, c.inChannels), std::span<float *>(out, c.outChannels), n);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+// Configuration the stored results depend on, checked before comparing.
+inline std::string buildConfiguration() {
+    std::string configuration = std::string("haas=") + VXFISSION_HAAS_INTERPOLATOR::kName;
+    if (!std::is_same_v<VXFISSION_DELAY_SAMPLE, float>) configuration += std::string(" delay=") + DelayFormat<VXFISSION_DELAY_SAMPLE>::kName;
+    return configuration;
+}
+
+} // namespace vxfission_test
@@ -0,0 +1,220 @@
+//
+//  vxfission_batch.cpp
+//  VXFission Tools
+//
+//  Offline bounce farm: renders every stem listed in a manifest through its
+//  own instance of the effect, all in one process on a work-stealing thread
+//  pool (VXFissionBatchRenderer), and reports the aggregate realtime factor.
+//  With --threads given a list it renders the batch once per thread count to
+//  show the scaling. Without a manifest, --synthetic renders K generated stems.
+//
+//  Manifest: one stem per line, '#' starts a comment.
+//    <input> [<output.wav>] [delay=<ms>] [oversampling=<1|2|4>]
+//  Inputs are read as in vxfission_bench (WAV, or raw float32 with --channels
+//  and --rate); outputs are float32 WAV, written after the last pass.
+//
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "VXFissionBatchRenderer.hpp"
+
+namespace {
+
+struct BatchOptions {
+    std::string manifestPath;
+    std::vector<uint32_t> threadCounts;
+    uint32_t blockSize   = 256;
+    int      synthetic   = 0;
+    double   sampleRate  = 48000.0;
+    int      rawChannels = 1;
+    double   seconds     = 10.0;
+    int      repeats     = 1;
+};
+
+struct ManifestEntry {
+    std::string input;
+    std::string output;
+    float delayTimeMs  = 25.0f;
+    int   oversampling = 1;
+};
+
+void printUsage(const char *argv0) {
+    std::printf(
+        "usage: %s [options] [manifest.txt]\n"
+        "  --threads <list>   comma-separated worker counts (default: hardware threads)\n"
+        "  --block <frames>   host block size (default 256)\n"
+        "  --synthetic <k>    render k generated stems instead of a manifest\n"
+        "  --seconds <s>      length of each synthetic stem (default 10)\n"
+        "  --rate <hz>        sample rate for raw or synthetic input (default 48000)\n"
+        "  --channels <n>     channel count of raw float32 input (default 1)\n"
+        "  --repeat <n>       timed passes per thread count, best is reported (default 1)\n"
+        "manifest lines: <input> [<output.wav>] [delay=<ms>] [oversampling=<1|2|4>]\n",
+        argv0);
+}
+
+std::vector<uint32_t> parseSizeList(const char *text) {
+    std::vector<uint32_t> sizes;
+    while (*text) {
+        char *end = nullptr;
+        unsigned long v = std::strtoul(text, &end, 10);
+        if (end == text) break;
+        if (v > 0) sizes.push_back((uint32_t)v);
+        text = (*end == ',') ? end + 1 : end;
+    }
+    return sizes;
+}
+
+bool parseArguments(int argc, char **argv, BatchOptions &options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--help" || arg == "-h") { printUsage(argv[0]); std::exit(0); }
+        else if (arg == "--threads"   && hasValue) options.threadCounts = parseSizeList(argv[++i]);
+        else if (arg == "--block"     && hasValue) options.blockSize    = (uint32_t)std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--synthetic" && hasValue) options.synthetic    = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--seconds"   && hasValue) options.seconds      = std::strtod(argv[++i], nullptr);
+        else if (arg == "--rate"      && hasValue) options.sampleRate   = std::strtod(argv[++i], nullptr);
+        else if (arg == "--channels"  && hasValue) options.rawChannels  = std::atoi(argv[++i]);
+        else if (arg == "--repeat"    && hasValue) options.repeats      = std::max(1, std::atoi(argv[++i]));
+        else if (!arg.empty() && arg[0] != '-' && options.manifestPath.empty()) options.manifestPath = arg;
+        else { std::fprintf(stderr, "unknown or incomplete option: %s\n", arg.c_str()); return false; }
+    }
+    return !options.manifestPath.empty() || options.synthetic > 0;
+}
+
+bool readManifest(const std::string &path, std::vector<ManifestEntry> &entries, std::string &error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::string line;
+    for (int lineNumber = 1; std::getline(file, line); ++lineNumber) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string field;
+        ManifestEntry entry;
+        while (fields >> field) {
+            if (field.rfind("delay=", 0) == 0) {
+                entry.delayTimeMs = std::clamp(std::strtof(field.c_str() + 6, nullptr), -50.0f, 50.0f);
+            } else if (field.rfind("oversampling=", 0) == 0) {
+                entry.oversampling = std::atoi(field.c_str() + 13);
+            } else if (entry.input.empty()) {
+                entry.input = field;
+            } else if (entry.output.empty()) {
+                entry.output = field;
+            } else {
+                error = path + ":" + std::to_string(lineNumber) + ": unexpected '" + field + "'";
+                return false;
+            }
+        }
+        if (!entry.input.empty()) entries.push_back(entry);
+    }
+    return true;
+}
+
+// Mono noise "stems" of slightly different lengths, so the pool has uneven
+// jobs to balance, with the knob spread across its range.
+void makeSyntheticStems(const BatchOptions &options, std::vector<ManifestEntry> &entries, std::vector<VXFissionAudioData> &inputs) {
+    uint32_t seed = 0x2468ace1u;
+    for (int k = 0; k < options.synthetic; ++k) {
+        VXFissionAudioData data;
+        data.sampleRate = options.sampleRate;
+        const size_t frames = (size_t)(options.sampleRate * options.seconds * (0.75 + 0.5 * (k % 5) / 4.0));
+        data.channels.assign(1, std::vector<float>(frames));
+        float lp = 0.0f;
+        for (float &x : data.channels[0]) {
+            seed = seed * 1664525u + 1013904223u;
+            lp += 0.2f * ((float)(seed >> 8) / 8388608.0f - 1.0f - lp);
+            x = 0.8f * lp;
+        }
+        inputs.push_back(std::move(data));
+        ManifestEntry entry;
+        entry.input       = "<synthetic " + std::to_string(k) + ">";
+        entry.delayTimeMs = -50.0f + 100.0f * (float)((k * 7) % 11) / 10.0f;
+        entries.push_back(entry);
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    BatchOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    std::vector<ManifestEntry>      entries;
+    std::vector<VXFissionAudioData> inputs;
+    std::string error;
+    if (options.manifestPath.empty()) {
+        makeSyntheticStems(options, entries, inputs);
+    } else {
+        if (!readManifest(options.manifestPath, entries, error)) {
+            std::fprintf(stderr, "error: %s\n", error.c_str());
+            return 1;
+        }
+        inputs.resize(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (!readAudioFile(entries[i].input, options.rawChannels, options.sampleRate, inputs[i], error)) {
+                std::fprintf(stderr, "error: %s\n", error.c_str());
+                return 1;
+            }
+            if (inputs[i].frameCount() == 0 || inputs[i].channelCount() > VXFissionChannelMap::kMaxChannels) {
+                std::fprintf(stderr, "error: %s: no audio, or more than %d channels\n",
+                             entries[i].input.c_str(), VXFissionChannelMap::kMaxChannels);
+                return 1;
+            }
+        }
+    }
+    if (entries.empty()) {
+        std::fprintf(stderr, "error: nothing to render\n");
+        return 1;
+    }
+
+    std::vector<VXFissionAudioData>  outputs(entries.size());
+    std::vector<VXFissionBatchVoice> voices(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        voices[i].input        = &inputs[i];
+        voices[i].output       = &outputs[i];
+        voices[i].delayTimeMs  = entries[i].delayTimeMs;
+        voices[i].oversampling = entries[i].oversampling;
+    }
+
+    if (options.threadCounts.empty()) options.threadCounts.push_back(std::max(1u, std::thread::hardware_concurrency()));
+
+    std::printf("%zu stems, %u-frame blocks, %u hardware threads\n",
+                entries.size(), options.blockSize, std::thread::hardware_concurrency());
+    std::printf("%8s %12s %14s %12s %10s\n", "threads", "wall s", "realtime x", "speedup", "steals");
+    double singleThread = 0.0;
+    for (uint32_t threads : options.threadCounts) {
+        VXFissionBatchRenderer renderer((int)threads, options.blockSize);
+        VXFissionBatchStats best;
+        for (int r = 0; r < options.repeats; ++r) {
+            VXFissionBatchStats stats = renderer.render(voices);
+            if (r == 0 || stats.wallSeconds < best.wallSeconds) best = stats;
+        }
+        if (threads == 1) singleThread = best.wallSeconds;
+        char speedup[16] = "-";  // against the 1-thread row, when there is one
+        if (singleThread > 0.0) std::snprintf(speedup, sizeof speedup, "%.2fx", singleThread / best.wallSeconds);
+        std::printf("%8u %12.3f %14.1f %12s %10zu\n",
+                    threads, best.wallSeconds, best.realtimeFactor(), speedup, best.steals);
+    }
+
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].output.empty()) continue;
+        if (!writeWavFloatFile(entries[i].output, outputs[i], error)) {
+            std::fprintf(stderr, "error: %s\n", error.c_str());
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,154 @@
+//
+//  vxfission_stream.cpp
+//  VXFission Tools
+//
+//  Renders one file of any length through the effect in constant memory
+//  (VXFissionStreamRenderer): the input is memory-mapped, or streamed when it
+//  is a pipe, and read, processed and written on three threads at once.
+//  Logs the read and write throughput, the realtime factor, how busy each
+//  stage was and the peak resident memory to stderr, so stdout can carry
+//  the audio.
+//
+//    vxfission_stream [options] <input.wav | input.raw | -> <output.wav | ->
+//
+//  Input is WAV (PCM 16/24/32-bit or float32, RIFF or RF64), or anything else
+//  as raw interleaved float32 with --channels and --rate; "-" is stdin.
+//  Output is a WAV in the --format encoding; "-" is stdout.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <sys/resource.h>
+
+#include "VXFissionStreamRenderer.hpp"
+
+namespace {
+
+struct StreamOptions {
+    std::string inputPath;
+    std::string outputPath;
+    VXFissionStreamSettings settings;
+    VXFissionSampleEncoding encoding = VXFissionSampleEncoding::float32;
+    double sampleRate  = 48000.0;
+    int    rawChannels = 1;
+    bool   progress    = false;
+};
+
+void printUsage(const char *argv0) {
+    std::fprintf(stderr,
+        "usage: %s [options] <input.wav | input.raw | -> <output.wav | ->\n"
+        "  --delay <ms>        knob position, -50..50 (default 25)\n"
+        "  --oversampling <n>  compressor oversampling, 1, 2 or 4 (default 1)\n"
+        "  --block <n>         frames per process() call (default 512)\n"
+        "  --chunk <n>         frames per pipeline slot (default 8192)\n"
+        "  --slots <n>         chunks in flight between the stages (default 8)\n"
+        "  --format <f>        output encoding: pcm16, pcm24, pcm32 or float32 (default float32)\n"
+        "  --rate <hz>         sample rate of raw float32 input (default 48000)\n"
+        "  --channels <n>      channel count of raw float32 input (default 1)\n"
+        "  --progress          log progress once a second\n",
+        argv0);
+}
+
+bool parseEncoding(const std::string &name, VXFissionSampleEncoding &encoding) {
+    for (VXFissionSampleEncoding e : { VXFissionSampleEncoding::pcm16, VXFissionSampleEncoding::pcm24,
+                                       VXFissionSampleEncoding::pcm32, VXFissionSampleEncoding::float32 }) {
+        if (name == encodingName(e)) { encoding = e; return true; }
+    }
+    return false;
+}
+
+bool parseArguments(int argc, char **argv, StreamOptions &options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--help" || arg == "-h") { printUsage(argv[0]); std::exit(0); }
+        else if (arg == "--delay"        && hasValue) options.settings.delayTimeMs  = std::strtof(argv[++i], nullptr);
+        else if (arg == "--oversampling" && hasValue) options.settings.oversampling = std::atoi(argv[++i]);
+        else if (arg == "--block"        && hasValue) options.settings.blockSize    = (uint32_t)std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--chunk"        && hasValue) options.settings.chunkFrames  = (uint32_t)std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--slots"        && hasValue) options.settings.slots        = (uint32_t)std::max(2, std::atoi(argv[++i]));
+        else if (arg == "--format"       && hasValue) { if (!parseEncoding(argv[++i], options.encoding)) return false; }
+        else if (arg == "--rate"         && hasValue) options.sampleRate  = std::strtod(argv[++i], nullptr);
+        else if (arg == "--channels"     && hasValue) options.rawChannels = std::atoi(argv[++i]);
+        else if (arg == "--progress")                 options.progress    = true;
+        else if (!arg.empty() && (arg[0] != '-' || arg == "-") && options.inputPath.empty())  options.inputPath  = arg;
+        else if (!arg.empty() && (arg[0] != '-' || arg == "-") && options.outputPath.empty()) options.outputPath = arg;
+        else { std::fprintf(stderr, "unknown or incomplete option: %s\n", arg.c_str()); return false; }
+    }
+    return !options.inputPath.empty() && !options.outputPath.empty();
+}
+
+// Peak resident set of this process, in MB.
+double peakResidentMB() {
+    struct rusage usage {};
+    ::getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return (double)usage.ru_maxrss / 1e6;   // bytes
+#else
+    return (double)usage.ru_maxrss / 1e3;   // KiB
+#endif
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    StreamOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    std::string error;
+    VXFissionByteSource source;
+    VXFissionStreamFormat input;
+    if (!source.open(options.inputPath, error) ||
+        !readStreamHeader(source, options.rawChannels, options.sampleRate, input, error)) {
+        std::fprintf(stderr, "error: %s: %s\n", options.inputPath.c_str(), error.c_str());
+        return 1;
+    }
+    if (input.channels > VXFissionChannelMap::kMaxChannels) {
+        std::fprintf(stderr, "error: more than %d channels\n", VXFissionChannelMap::kMaxChannels);
+        return 1;
+    }
+
+    VXFissionStreamFormat output;
+    output.sampleRate = input.sampleRate;
+    output.channels   = VXFissionStreamRenderer::outputChannels(input.channels);
+    output.encoding   = options.encoding;
+    output.frames     = input.frames;
+    VXFissionWavStreamWriter writer;
+    if (!writer.open(options.outputPath, output, error)) {
+        std::fprintf(stderr, "error: %s: %s\n", options.outputPath.c_str(), error.c_str());
+        return 1;
+    }
+
+    std::fprintf(stderr, "%s: %s %d ch %s, %.0f Hz, %s; -> %d ch %s\n",
+                 options.inputPath.c_str(), input.isWav ? "wav" : "raw", input.channels,
+                 encodingName(input.encoding), input.sampleRate,
+                 source.isMapped() ? "mapped" : "streamed", output.channels, encodingName(output.encoding));
+
+    auto last = std::chrono::steady_clock::now();
+    VXFissionStreamRenderer renderer(options.settings);
+    VXFissionStreamStats stats = renderer.render(source, input, writer, [&](uint64_t frames) {
+        if (!options.progress) return;
+        auto now = std::chrono::steady_clock::now();
+        if (now - last < std::chrono::seconds(1)) return;
+        last = now;
+        std::fprintf(stderr, "  %.1f s of audio\n", (double)frames / input.sampleRate);
+    });
+    if (!stats.ok) {
+        std::fprintf(stderr, "error: %s\n", stats.error.c_str());
+        return 1;
+    }
+
+    std::fprintf(stderr, "%.1f s of audio in %.2f s: %.1fx realtime, read %.1f MB/s, write %.1f MB/s\n",
+                 stats.audioSeconds, stats.wallSeconds, stats.realtimeFactor(), stats.readMBps(), stats.writeMBps());
+    std::fprintf(stderr, "busy: read %.0f%%, process %.0f%%, write %.0f%%; peak resident %.1f MB\n",
+                 100.0 * stats.busyShare(VXFissionStreamRenderer::kRead),
+                 100.0 * stats.busyShare(VXFissionStreamRenderer::kProcess),
+                 100.0 * stats.busyShare(VXFissionStreamRenderer::kWrite), peakResidentMB());
+    return 0;
+}
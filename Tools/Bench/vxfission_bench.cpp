@@ -0,0 +1,372 @@
+//
+//  vxfission_bench.cpp
+//  VXFission Tools
+//
+//  Offline render benchmark for VXFissionExtensionDSPCore. Renders a WAV or raw
+//  float file (or a synthetic vocal-like stimulus) through the full signal path
+//  as fast as possible and reports ns/sample, realtime factor and throughput for
+//  each host block size. With --control it also sweeps the control-rate
+//  interval and reports each one's error against per-frame control updates.
+//  With --surround it renders the input copied onto N channels, N in to N out,
+//  and reports the cost per frame and per channel-sample for each N.
+//  With --layouts it renders the first input channel mono in to stereo out,
+//  then the same signal on both inputs of a stereo in/out, and reports each
+//  one's cost and the mono layout's saving.
+//  With --bypass it times the effect held bypassed (the copy path) or with
+//  bypass automated on and off every 250 ms (the crossfades), optionally with
+//  trails.
+//
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "VXFissionExtensionDSPCore.hpp"
+#include "VXFissionAudioFile.hpp"
+
+namespace {
+
+struct BenchOptions {
+    std::string inputPath;
+    std::string outputPath;
+    std::string profilePath;
+    std::vector<uint32_t> blockSizes { 32, 64, 128, 256, 512, 1024 };
+    std::vector<uint32_t> controlIntervals;
+    std::vector<uint32_t> surroundCounts;
+    bool   compareLayouts = false;
+    std::string bypassMode;             // "", "on", "toggle" or "trails"
+    float  delayTimeMs  = 25.0f;
+    int    oversampling = 1;
+    double sampleRate   = 48000.0;
+    int    rawChannels  = 1;
+    double seconds      = 10.0;
+    double gapSeconds   = 0.6;
+    int    repeats      = 3;
+};
+
+void printUsage(const char *argv0) {
+    std::printf(
+        "usage: %s [options] [input.wav | input.raw]\n"
+        "  --delay <ms>       knob position, -50..50 (default 25)\n"
+        "  --blocks <list>    comma-separated host block sizes (default 32,64,128,256,512,1024)\n"
+        "  --control <list>   comma-separated control-rate intervals to compare against 1 (per frame)\n"
+        "  --surround <list>  comma-separated channel counts (up to 16) to render N in to N out\n"
+        "  --layouts          compare mono in / stereo out against stereo in / stereo out\n"
+        "  --bypass <mode>    on: held bypassed; toggle / trails: bypass flips every 250 ms\n"
+        "  --oversampling <n> compressor oversampling, 1, 2 or 4 (default 1)\n"
+        "  --rate <hz>        sample rate for raw or synthetic input (default 48000)\n"
+        "  --channels <n>     channel count of raw float32 input (default 1)\n"
+        "  --seconds <s>      length of the synthetic stimulus when no input is given (default 10)\n"
+        "  --gap <s>          digital silence between 2.4 s synthetic phrases (default 0.6)\n"
+        "  --repeat <n>       timed passes per block size, best is reported (default 3)\n"
+        "  --output <path>    write the last render as a float32 WAV\n"
+        "  --profile <path>   write the last render's per-stage timings as JSON\n"
+        "                     (needs a build with -DVXFISSION_PROFILING=ON)\n",
+        argv0);
+}
+
+std::vector<uint32_t> parseSizeList(const char *text) {
+    std::vector<uint32_t> sizes;
+    while (*text) {
+        char *end = nullptr;
+        unsigned long v = std::strtoul(text, &end, 10);
+        if (end == text) break;
+        if (v > 0) sizes.push_back((uint32_t)v);
+        text = (*end == ',') ? end + 1 : end;
+    }
+    return sizes;
+}
+
+bool parseArguments(int argc, char **argv, BenchOptions &options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--help" || arg == "-h") { printUsage(argv[0]); std::exit(0); }
+        else if (arg == "--delay"    && hasValue) options.delayTimeMs = std::strtof(argv[++i], nullptr);
+        else if (arg == "--blocks"   && hasValue) options.blockSizes  = parseSizeList(argv[++i]);
+        else if (arg == "--control"  && hasValue) options.controlIntervals = parseSizeList(argv[++i]);
+        else if (arg == "--surround" && hasValue) options.surroundCounts   = parseSizeList(argv[++i]);
+        else if (arg == "--layouts")              options.compareLayouts = true;
+        else if (arg == "--bypass"   && hasValue) options.bypassMode  = argv[++i];
+        else if (arg == "--oversampling" && hasValue) options.oversampling = std::atoi(argv[++i]);
+        else if (arg == "--rate"     && hasValue) options.sampleRate  = std::strtod(argv[++i], nullptr);
+        else if (arg == "--channels" && hasValue) options.rawChannels = std::atoi(argv[++i]);
+        else if (arg == "--seconds"  && hasValue) options.seconds     = std::strtod(argv[++i], nullptr);
+        else if (arg == "--gap"      && hasValue) options.gapSeconds  = std::max(0.0, std::strtod(argv[++i], nullptr));
+        else if (arg == "--repeat"   && hasValue) options.repeats     = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--output"   && hasValue) options.outputPath  = argv[++i];
+        else if (arg == "--profile"  && hasValue) options.profilePath = argv[++i];
+        else if (!arg.empty() && arg[0] != '-' && options.inputPath.empty()) options.inputPath = arg;
+        else { std::fprintf(stderr, "unknown or incomplete option: %s\n", arg.c_str()); return false; }
+    }
+    return !options.blockSizes.empty();
+}
+
+// Mono vocal-like stimulus: noise through a gentle low-pass, gated into
+// ~4 Hz "syllables" and 2.4 s phrases separated by `gap` seconds of digital
+// silence, so the compressor, the reverb tail and the wet-bus sleep all work.
+VXFissionAudioData makeSyntheticInput(double sampleRate, double seconds, double gap) {
+    VXFissionAudioData data;
+    data.sampleRate = sampleRate;
+    const size_t frames = (size_t)(sampleRate * seconds);
+    data.channels.assign(1, std::vector<float>(frames));
+
+    uint32_t seed = 0x1234567u;
+    float lp = 0.0f;
+    for (size_t f = 0; f < frames; ++f) {
+        seed = seed * 1664525u + 1013904223u;
+        float noise = (float)(seed >> 8) / 8388608.0f - 1.0f;
+        lp += 0.2f * (noise - lp);
+        double t = (double)f / sampleRate;
+        float syllable = (float)std::max(0.0, std::sin(2.0 * M_PI * 4.0 * t));
+        float phrase   = (std::fmod(t, 2.4 + gap) < 2.4) ? 1.0f : 0.0f;
+        data.channels[0][f] = 0.8f * lp * syllable * phrase;
+    }
+    return data;
+}
+
+struct BenchResult {
+    double seconds = 0.0;
+};
+
+// Renders the whole input through a freshly initialised core in blocks of `blockSize`.
+// A controlInterval of 0 keeps the core's default.
+BenchResult renderOnce(const BenchOptions &options, const VXFissionAudioData &input, VXFissionAudioData &output,
+                       uint32_t blockSize, uint32_t controlInterval) {
+    const int    numIn  = input.channelCount();
+    const int    numOut = std::max(2, numIn);  // mono in renders stereo; otherwise N in, N out
+    const size_t frames = input.frameCount();
+
+    VXFissionExtensionDSPCore core;
+    core.setMaximumFramesToRender(blockSize);
+    core.setOversampling(options.oversampling);
+    core.setBypass(options.bypassMode == "on");
+    core.setBypassTrails(options.bypassMode == "trails");
+    core.initialize(numIn, numOut, input.sampleRate);
+    core.setDelayTime(options.delayTimeMs);
+    if (controlInterval > 0) core.setControlInterval((int)controlInterval);
+
+    output.sampleRate = input.sampleRate;
+    output.channels.assign(numOut, std::vector<float>(frames));
+
+    std::vector<const float *> inPtrs(numIn);
+    std::vector<float *>       outPtrs(numOut);
+
+    const bool   toggleBypass = (options.bypassMode == "toggle" || options.bypassMode == "trails");
+    const size_t togglePeriod = (size_t)(input.sampleRate * 0.250);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t pos = 0; pos < frames; pos += blockSize) {
+        uint32_t n = (uint32_t)std::min<size_t>(blockSize, frames - pos);
+        if (toggleBypass) core.setBypass((pos / togglePeriod) % 2 == 1);
+        for (int ch = 0; ch < numIn;  ++ch) inPtrs[ch]  = input.channels[ch].data() + pos;
+        for (int ch = 0; ch < numOut; ++ch) outPtrs[ch] = output.channels[ch].data() + pos;
+        core.process(std::span<const float *>(inPtrs), std::span<float *>(outPtrs), n);
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    // Each process() call above counts as one render against a deadline of
+    // blockSize / sampleRate.
+    if (!options.profilePath.empty()) {
+        if (std::FILE *f = std::fopen(options.profilePath.c_str(), "w")) {
+            std::fputs(core.profileJSON().c_str(), f);
+            std::fclose(f);
+        }
+    }
+
+    return { std::chrono::duration<double>(stop - start).count() };
+}
+
+struct RenderError {
+    float  maxDiff = 0.0f;
+    double snrDb   = 0.0f;  // reference power over error power
+};
+
+RenderError compareRenders(const VXFissionAudioData &reference, const VXFissionAudioData &test) {
+    RenderError error;
+    double signal = 0.0, noise = 0.0;
+    for (size_t ch = 0; ch < reference.channels.size(); ++ch) {
+        for (size_t f = 0; f < reference.channels[ch].size(); ++f) {
+            float ref  = reference.channels[ch][f];
+            float diff = test.channels[ch][f] - ref;
+            error.maxDiff = std::max(error.maxDiff, std::abs(diff));
+            signal += (double)ref * ref;
+            noise  += (double)diff * diff;
+        }
+    }
+    error.snrDb = (noise > 0.0) ? 10.0 * std::log10(signal / noise) : INFINITY;
+    return error;
+}
+
+// Worst deviation of the quadrature LFO from std::sin over `seconds`, stepping
+// once per control interval as the core does.
+double lfoError(double sampleRate, double seconds, uint32_t interval) {
+    QuadratureOscillator lfo;
+    const double step = 2.0 * M_PI * 0.8 * interval / sampleRate;
+    lfo.setStep(step);
+    double worst = 0.0;
+    const long steps = (long)(seconds * sampleRate / interval);
+    for (long i = 1; i <= steps; ++i) {
+        lfo.advance();
+        worst = std::max(worst, std::abs((double)lfo.sine - std::sin(step * (double)i)));
+    }
+    return worst;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    BenchOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    if (!options.profilePath.empty() && !VXFISSION_PROFILING) {
+        std::fprintf(stderr, "error: --profile needs a build with -DVXFISSION_PROFILING=ON\n");
+        return 2;
+    }
+
+    VXFissionAudioData input;
+    if (options.inputPath.empty()) {
+        input = makeSyntheticInput(options.sampleRate, options.seconds, options.gapSeconds);
+    } else {
+        std::string error;
+        if (!readAudioFile(options.inputPath, options.rawChannels, options.sampleRate, input, error)) {
+            std::fprintf(stderr, "error: %s\n", error.c_str());
+            return 1;
+        }
+    }
+    if (!options.bypassMode.empty() && options.bypassMode != "on" && options.bypassMode != "toggle" && options.bypassMode != "trails") {
+        std::fprintf(stderr, "error: --bypass takes on, toggle or trails\n");
+        return 2;
+    }
+    if (input.frameCount() == 0) {
+        std::fprintf(stderr, "error: input has no audio\n");
+        return 1;
+    }
+
+    const double audioSeconds = (double)input.frameCount() / input.sampleRate;
+    std::printf("input: %s, %d ch, %.0f Hz, %.2f s, delay %.1f ms\n",
+                options.inputPath.empty() ? "<synthetic>" : options.inputPath.c_str(),
+                input.channelCount(), input.sampleRate, audioSeconds, options.delayTimeMs);
+
+    if (!options.surroundCounts.empty()) {
+        // The first input channel on every channel; the core's default map
+        // for each count decides which ones are delayed.
+        std::printf("%8s %8s %12s %16s %14s\n", "channels", "block", "ns/frame", "ns/ch-sample", "realtime x");
+        VXFissionAudioData surround, output;
+        surround.sampleRate = input.sampleRate;
+        for (uint32_t count : options.surroundCounts) {
+            const int channels = std::clamp((int)count, 2, VXFissionChannelMap::kMaxChannels);
+            surround.channels.assign(channels, input.channels[0]);
+            for (uint32_t blockSize : options.blockSizes) {
+                double best = 1e30;
+                for (int r = 0; r < options.repeats; ++r) {
+                    best = std::min(best, renderOnce(options, surround, output, blockSize, 0).seconds);
+                }
+                const double frames = (double)input.frameCount();
+                std::printf("%8d %8u %12.2f %16.2f %14.1f\n",
+                            channels, blockSize,
+                            best * 1e9 / frames,
+                            best * 1e9 / frames / channels,
+                            audioSeconds / best);
+            }
+        }
+        return 0;
+    }
+
+    if (options.compareLayouts) {
+        // The same signal both ways, so only the layout (one Haas ring or
+        // two) differs. The two cores render block by block in turn, so
+        // clock drift lands on both alike.
+        std::printf("%8s %14s %14s %10s\n", "block", "1->2 ns/frame", "2->2 ns/frame", "saving");
+        const size_t frames = input.frameCount();
+        const float *source = input.channels[0].data();
+        for (uint32_t blockSize : options.blockSizes) {
+            double bestMono = 1e30, bestStereo = 1e30;
+            for (int r = 0; r < options.repeats; ++r) {
+                VXFissionExtensionDSPCore mono, stereo;
+                for (VXFissionExtensionDSPCore *core : { &mono, &stereo }) {
+                    core->setMaximumFramesToRender(blockSize);
+                    core->setOversampling(options.oversampling);
+                    core->initialize(core == &mono ? 1 : 2, 2, input.sampleRate);
+                    core->setDelayTime(options.delayTimeMs);
+                }
+                std::vector<float> outL(blockSize), outR(blockSize);
+                float *out[2] = { outL.data(), outR.data() };
+                double monoSeconds = 0.0, stereoSeconds = 0.0;
+                for (size_t pos = 0; pos < frames; pos += blockSize) {
+                    const uint32_t n = (uint32_t)std::min<size_t>(blockSize, frames - pos);
+                    const float *in[2] = { source + pos, source + pos };
+                    auto t0 = std::chrono::steady_clock::now();
+                    mono.process(std::span<const float *>(in, 1), std::span<float *>(out, 2), n);
+                    auto t1 = std::chrono::steady_clock::now();
+                    stereo.process(std::span<const float *>(in, 2), std::span<float *>(out, 2), n);
+                    auto t2 = std::chrono::steady_clock::now();
+                    monoSeconds   += std::chrono::duration<double>(t1 - t0).count();
+                    stereoSeconds += std::chrono::duration<double>(t2 - t1).count();
+                }
+                bestMono   = std::min(bestMono, monoSeconds);
+                bestStereo = std::min(bestStereo, stereoSeconds);
+            }
+            std::printf("%8u %14.2f %14.2f %9.1f%%\n",
+                        blockSize,
+                        bestMono * 1e9 / (double)frames,
+                        bestStereo * 1e9 / (double)frames,
+                        100.0 * (1.0 - bestMono / bestStereo));
+        }
+        return 0;
+    }
+
+    // Without --control, one row per block size at the core's default interval.
+    const bool compareControl = !options.controlIntervals.empty();
+    const std::vector<uint32_t> intervals = compareControl ? options.controlIntervals : std::vector<uint32_t> { 0 };
+    if (compareControl) {
+        std::printf("%8s %8s %12s %14s %14s %12s %10s %12s\n",
+                    "control", "block", "ns/sample", "realtime x", "Msamples/s", "max |diff|", "SNR dB", "LFO error");
+    } else {
+        std::printf("%8s %12s %14s %14s\n", "block", "ns/sample", "realtime x", "Msamples/s");
+    }
+
+    VXFissionAudioData output, reference;
+    for (uint32_t blockSize : options.blockSizes) {
+        if (compareControl) renderOnce(options, input, reference, blockSize, 1);
+        for (uint32_t interval : intervals) {
+            double best = 1e30;
+            for (int r = 0; r < options.repeats; ++r) {
+                best = std::min(best, renderOnce(options, input, output, blockSize, interval).seconds);
+            }
+            const double samples = (double)input.frameCount();
+            if (compareControl) {
+                RenderError error = compareRenders(reference, output);
+                std::printf("%8u %8u %12.2f %14.1f %14.2f %12.3g %10.1f %12.3g\n",
+                            interval, blockSize,
+                            best * 1e9 / samples,
+                            audioSeconds / best,
+                            samples / best / 1e6,
+                            error.maxDiff, error.snrDb,
+                            lfoError(input.sampleRate, audioSeconds, interval));
+            } else {
+                std::printf("%8u %12.2f %14.1f %14.2f\n",
+                            blockSize,
+                            best * 1e9 / samples,
+                            audioSeconds / best,
+                            samples / best / 1e6);
+            }
+        }
+    }
+
+    if (!options.outputPath.empty()) {
+        std::string error;
+        if (!writeWavFloatFile(options.outputPath, output, error)) {
+            std::fprintf(stderr, "error: %s\n", error.c_str());
+            return 1;
+        }
+    }
+    return 0;
+}
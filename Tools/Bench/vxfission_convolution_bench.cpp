@@ -0,0 +1,213 @@
+//
+//  vxfission_convolution_bench.cpp
+//  VXFission Tools
+//
+//  Convolution reverb benchmark (see VXFissionExtensionConvolution.hpp). For
+//  synthetic rooms of 0.5 to 5 s at 48 kHz, the reverb engine alone renders a
+//  speech-like programme in host blocks (default 256 frames), first with its
+//  tail on the worker, callbacks paced at the block period as in a live
+//  session, then with the tail inline, as offline. For each length it reports:
+//    - parts:    head / tail partitions (of 64 frames and of L)
+//    - memory:   bytes held by the engine
+//    - render:   render-thread ns per frame with the worker, and the 99th
+//                percentile callback in µs
+//    - tail:     the worker's ns per frame: the tail's partitions timed on
+//                their own
+//    - inline:   ns per frame with the tail inline, and the worst callback
+//    - late:     tail blocks the worker missed
+//    - latency:  samples from the response's first sound to the engine's
+//    - budget:   the worker's time per tail block (L frames), in ms
+//    - error:    largest difference from direct-form convolution over the
+//                first 0.2 s, in dB below the output's peak
+//  The Freeverb bank, the engine it replaces, is the first row.
+//
+//    vxfission_convolution_bench [block frames] [seconds of programme]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "VXFissionExtensionConvolution.hpp"
+#include "VXFissionExtensionReverb.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double kSampleRate   = 48000.0;
+constexpr double kLengths[]    = { 0.5, 1.0, 2.0, 3.0, 4.0, 5.0 };  // seconds of response
+constexpr double kCheckSeconds = 0.2;
+
+// Mono speech-like programme: low-passed noise in ~4 Hz syllables.
+std::vector<float> makeProgramme(size_t frames) {
+    std::vector<float> signal(frames);
+    uint32_t seed = 0x1234567u;
+    float lp = 0.0f;
+    for (size_t f = 0; f < frames; ++f) {
+        seed = seed * 1664525u + 1013904223u;
+        lp += 0.2f * ((float)(seed >> 8) / 8388608.0f - 1.0f - lp);
+        const double t = (double)f / kSampleRate;
+        signal[f] = 0.8f * lp * (float)std::max(0.0, std::sin(2.0 * M_PI * 4.0 * t));
+    }
+    return signal;
+}
+
+struct Timing {
+    double nsPerFrame = 0.0;
+    double p99us      = 0.0;
+    double worstUs    = 0.0;
+};
+
+// Every callback timed; with `paced`, each starts a block period after the
+// last, so a worker has the time between them.
+template <typename Render>
+Timing timeCallbacks(const std::vector<float> &input, int blockSize, bool paced, Render &&render) {
+    std::vector<float> left(blockSize), right(blockSize);
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(blockSize / kSampleRate));
+    const size_t blocks = input.size() / blockSize;
+    std::vector<double> seconds;
+    seconds.reserve(blocks);
+    auto next = Clock::now();
+    for (size_t b = 0; b < blocks; ++b) {
+        if (paced) {
+            std::this_thread::sleep_until(next);
+            next += period;
+        }
+        const auto start = Clock::now();
+        render(input.data() + b * blockSize, left.data(), right.data(), blockSize);
+        seconds.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+    }
+    Timing timing;
+    double total = 0.0;
+    for (double s : seconds) total += s;
+    timing.nsPerFrame = total * 1e9 / (double)(blocks * blockSize);
+    std::sort(seconds.begin(), seconds.end());
+    timing.p99us   = seconds[seconds.size() * 99 / 100] * 1e6;
+    timing.worstUs = seconds.back() * 1e6;
+    return timing;
+}
+
+// What the worker spends: the tail segment's convolver, a block of L at a time.
+double tailNsPerFrame(const VXFissionImpulseResponse &response, int tailBlock, const std::vector<float> &input) {
+    const size_t start = 2 * (size_t)tailBlock;
+    if (response.frames() <= start) return 0.0;
+    const float *segment[2] = { response.left.data() + start, response.right.data() + start };
+    UniformPartitionedConvolver tail;
+    tail.configure(segment, response.frames() - start, tailBlock);
+    std::vector<float> left(tailBlock), right(tailBlock);
+    const size_t blocks = input.size() / tailBlock;
+    const auto begin = Clock::now();
+    for (size_t b = 0; b < blocks; ++b) tail.processBlock(input.data() + b * tailBlock, left.data(), right.data());
+    return std::chrono::duration<double>(Clock::now() - begin).count() * 1e9 / (double)(blocks * tailBlock);
+}
+
+// The response as the engine uses it: scaled to FreeverbBank's energy.
+std::vector<float> scaledLeft(const VXFissionImpulseResponse &response) {
+    double energy = 0.0;
+    for (size_t t = 0; t < response.frames(); ++t) {
+        energy += (double)response.left[t] * response.left[t] + (double)response.right[t] * response.right[t];
+    }
+    const double scale = std::sqrt(ConvolutionTuning::kFreeverbEnergy / (0.5 * energy));
+    std::vector<float> h(response.frames());
+    for (size_t t = 0; t < h.size(); ++t) h[t] = (float)(response.left[t] * scale);
+    return h;
+}
+
+// Largest difference from direct-form convolution over the first
+// kCheckSeconds, in dB below the reference's peak.
+double errorDb(const VXFissionImpulseResponse &response, const std::vector<float> &input, int blockSize) {
+    const size_t frames = (size_t)(kCheckSeconds * kSampleRate);
+    ConvolutionReverb reverb;
+    reverb.configure(response, blockSize, ConvolutionTailThread::Render);
+    std::vector<float> left(frames), right(frames);
+    for (size_t f = 0; f < frames; f += blockSize) {
+        const int n = (int)std::min<size_t>(blockSize, frames - f);
+        reverb.process(input.data() + f, left.data() + f, right.data() + f, n);
+    }
+    const std::vector<float> h = scaledLeft(response);
+    double peak = 0.0, error = 0.0;
+    for (size_t t = 0; t < frames; ++t) {
+        double y = 0.0;
+        for (size_t k = 0; k <= t && k < h.size(); ++k) y += (double)h[k] * input[t - k];
+        peak  = std::max(peak, std::fabs(y));
+        error = std::max(error, std::fabs(y - left[t]));
+    }
+    return 20.0 * std::log10(std::max(error, 1e-30) / peak);
+}
+
+// Samples between the response's first sound and the engine's, for an impulse.
+long latencySamples(const VXFissionImpulseResponse &response, int blockSize) {
+    ConvolutionReverb reverb;
+    reverb.configure(response, blockSize, ConvolutionTailThread::Render);
+    const size_t frames = (size_t)(0.1 * kSampleRate);
+    std::vector<float> impulse(frames, 0.0f), left(frames), right(frames);
+    impulse[0] = 1.0f;
+    for (size_t f = 0; f < frames; f += blockSize) {
+        const int n = (int)std::min<size_t>(blockSize, frames - f);
+        reverb.process(impulse.data() + f, left.data() + f, right.data() + f, n);
+    }
+    auto firstSound = [](const float *x, size_t n) {
+        for (size_t i = 0; i < n; ++i) if (std::fabs(x[i]) > 1e-9f) return (long)i;
+        return (long)n;
+    };
+    return firstSound(left.data(), frames) - firstSound(response.left.data(), std::min(frames, response.frames()));
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const int    blockSize = (argc > 1) ? std::max(16, std::atoi(argv[1])) : 256;
+    const double seconds   = (argc > 2) ? std::max(1.0, std::atof(argv[2])) : 4.0;
+    const std::vector<float> input = makeProgramme((size_t)(seconds * kSampleRate));
+
+    std::printf("%d-frame blocks at %.0f kHz (%.2f ms), %.0f s of programme per run\n\n", blockSize,
+                kSampleRate / 1000.0, blockSize / kSampleRate * 1e3, seconds);
+    std::printf("%-9s %9s %8s %16s %8s %16s %5s %8s %7s %7s\n", "response", "parts", "memory", "render ns/f p99",
+                "tail", "inline ns/f max", "late", "latency", "budget", "error");
+
+    {
+        DelayArena arena;
+        FreeverbBank bank;
+        arena.beginLayout();
+        bank.layout(arena, kSampleRate);
+        arena.allocate();
+        bank.resetState();
+        const Timing t = timeCallbacks(input, blockSize, false, [&](const float *in, float *l, float *r, int n) {
+            bank.process(arena, in, l, r, n);
+        });
+        std::printf("%-9s %9s %7.0fk %8.1f %6.1fus %8s %8.1f %6.1fus %5d %8d %7s %7s\n", "freeverb", "-",
+                    arena.bytes() / 1024.0, t.nsPerFrame, t.p99us, "-", t.nsPerFrame, t.worstUs, 0, 0, "-", "-");
+    }
+
+    for (double length : kLengths) {
+        const VXFissionImpulseResponse response = VXFissionImpulseResponse::synthetic(length, kSampleRate);
+
+        ConvolutionReverb worker;
+        worker.configure(response, blockSize, ConvolutionTailThread::Worker);
+        const Timing live = timeCallbacks(input, blockSize, true, [&](const float *in, float *l, float *r, int n) {
+            worker.process(in, l, r, n);
+        });
+
+        ConvolutionReverb inline_;
+        inline_.configure(response, blockSize, ConvolutionTailThread::Render);
+        const Timing offline = timeCallbacks(input, blockSize, false, [&](const float *in, float *l, float *r, int n) {
+            inline_.process(in, l, r, n);
+        });
+
+        char name[16], parts[16];
+        std::snprintf(name, sizeof name, "%.1f s", length);
+        std::snprintf(parts, sizeof parts, "%d/%d", worker.headPartitions(), worker.tailPartitions());
+        std::printf("%-9s %9s %7.1fM %8.1f %6.1fus %8.1f %8.1f %6.1fus %5llu %8ld %5.1fms %5.0fdB\n", name, parts,
+                    worker.bytes() / 1048576.0, live.nsPerFrame, live.p99us,
+                    tailNsPerFrame(response, worker.tailBlock(), input), offline.nsPerFrame, offline.worstUs,
+                    (unsigned long long)worker.lateBlocks(), latencySamples(response, blockSize),
+                    worker.tailBlock() / kSampleRate * 1e3, errorDb(response, input, blockSize));
+    }
+    return 0;
+}
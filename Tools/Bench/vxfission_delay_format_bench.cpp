@@ -0,0 +1,277 @@
+//
+//  vxfission_delay_format_bench.cpp
+//  VXFission Tools
+//
+//  Delay-line storage benchmark (see VXFissionExtensionDelayFormat.hpp). For
+//  each storage format at 48 and 192 kHz, mono in / stereo out, it reports:
+//    - arena:     delay-line bytes per instance (Haas rings + reverb)
+//    - resident:  resident memory per instance, over K initialised instances
+//    - noise:     the render of a speech-like programme against the float32
+//                 core: largest sample difference, residual RMS and the
+//                 programme-to-residual ratio
+//    - hot:       ns per frame, one instance rendering on its own
+//    - K inst:    ns per frame, K instances taking turns a block at a time,
+//                 so every block starts with that instance's rings cold
+//    - misses:    L1D and last-level cache misses per block over the K-instance
+//                 run, where the kernel exposes the hardware counters
+//
+//    vxfission_delay_format_bench [instances] [block frames]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "VXFissionExtensionDSPCore.hpp"
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename DelaySample>
+using Core = VXFissionExtensionDSPCoreT<VXFISSION_HAAS_INTERPOLATOR, DelaySample>;
+
+constexpr double kProgrammeSeconds = 6.0;
+constexpr float  kDelayTimeMs      = 25.0f;
+
+// Mono speech-like programme: low-passed noise in ~4 Hz syllables, 2.4 s
+// phrases and 0.6 s pauses, so the reverb tail is heard on its own too.
+std::vector<float> makeProgramme(double sampleRate) {
+    std::vector<float> signal((size_t)(sampleRate * kProgrammeSeconds));
+    uint32_t seed = 0x1234567u;
+    float lp = 0.0f;
+    for (size_t f = 0; f < signal.size(); ++f) {
+        seed = seed * 1664525u + 1013904223u;
+        lp += 0.2f * ((float)(seed >> 8) / 8388608.0f - 1.0f - lp);
+        const double t = (double)f / sampleRate;
+        const float syllable = (float)std::max(0.0, std::sin(2.0 * M_PI * 4.0 * t));
+        const float phrase   = (std::fmod(t, 3.0) < 2.4) ? 1.0f : 0.0f;
+        signal[f] = 0.8f * lp * syllable * phrase;
+    }
+    return signal;
+}
+
+template <typename DelaySample>
+void prepare(Core<DelaySample> &core, double sampleRate, uint32_t blockSize) {
+    core.setMaximumFramesToRender(blockSize);
+    core.initialize(1, 2, sampleRate);
+    core.setDelayTime(kDelayTimeMs);
+}
+
+// One instance over the whole programme; returns interleaved L/R.
+template <typename DelaySample>
+std::vector<float> render(const std::vector<float> &input, double sampleRate, uint32_t blockSize) {
+    Core<DelaySample> core;
+    prepare(core, sampleRate, blockSize);
+    std::vector<float> out(input.size() * 2), left(blockSize), right(blockSize);
+    for (size_t pos = 0; pos < input.size(); pos += blockSize) {
+        const uint32_t n = (uint32_t)std::min<size_t>(blockSize, input.size() - pos);
+        const float *in[1]  = { input.data() + pos };
+        float       *o[2]   = { left.data(), right.data() };
+        core.process(std::span<const float *>(in, 1), std::span<float *>(o, 2), n);
+        for (uint32_t i = 0; i < n; ++i) {
+            out[(pos + i) * 2]     = left[i];
+            out[(pos + i) * 2 + 1] = right[i];
+        }
+    }
+    return out;
+}
+
+double decibels(double x) { return (x > 0.0) ? 20.0 * std::log10(x) : -999.0; }
+
+// Resident pages of this process, in bytes.
+double residentBytes() {
+#if defined(__linux__)
+    long size = 0, resident = 0;
+    if (FILE *f = std::fopen("/proc/self/statm", "r")) {
+        if (std::fscanf(f, "%ld %ld", &size, &resident) != 2) resident = 0;
+        std::fclose(f);
+    }
+    return (double)resident * (double)sysconf(_SC_PAGESIZE);
+#else
+    return 0.0;
+#endif
+}
+
+// L1D read misses and last-level-cache misses for this thread, when the
+// kernel and the machine expose them (not in most VMs).
+class CacheMissCounters {
+public:
+    CacheMissCounters() {
+#if defined(__linux__)
+        const uint64_t l1d = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        mFd[0] = open(PERF_TYPE_HW_CACHE, l1d);
+        mFd[1] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+#endif
+    }
+    ~CacheMissCounters() {
+#if defined(__linux__)
+        for (int fd : mFd) if (fd >= 0) ::close(fd);
+#endif
+    }
+    bool available(int i) const { return mFd[i] >= 0; }
+    void start() {
+#if defined(__linux__)
+        for (int fd : mFd) if (fd >= 0) { ::ioctl(fd, PERF_EVENT_IOC_RESET, 0); ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0); }
+#endif
+    }
+    void stop() {
+#if defined(__linux__)
+        for (int i = 0; i < 2; ++i) {
+            if (mFd[i] < 0) continue;
+            ::ioctl(mFd[i], PERF_EVENT_IOC_DISABLE, 0);
+            if (::read(mFd[i], &mCount[i], sizeof mCount[i]) != sizeof mCount[i]) mCount[i] = 0;
+        }
+#endif
+    }
+    uint64_t count(int i) const { return mCount[i]; }
+
+private:
+#if defined(__linux__)
+    static int open(uint32_t type, uint64_t config) {
+        perf_event_attr attr {};
+        attr.size           = sizeof attr;
+        attr.type           = type;
+        attr.config         = config;
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        return (int)::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+#endif
+    int      mFd[2]    { -1, -1 };
+    uint64_t mCount[2] {};
+};
+
+struct Result {
+    size_t arenaBytes    = 0;
+    double residentBytes = 0.0;
+    double maxDifference = 0.0;    // dBFS
+    double residualRms   = 0.0;    // dBFS
+    double snr           = 0.0;    // dB
+    double hotNs         = 0.0;
+    double coldNs        = 0.0;
+    double misses[2]     {};       // per block, or < 0 when not counted
+};
+
+template <typename DelaySample>
+Result measure(const std::vector<float> &input, const std::vector<float> &reference,
+               double sampleRate, int instances, uint32_t blockSize) {
+    Result result;
+
+    // Noise against float32.
+    const std::vector<float> output = render<DelaySample>(input, sampleRate, blockSize);
+    double worst = 0.0, residual = 0.0, signal = 0.0;
+    for (size_t i = 0; i < output.size(); ++i) {
+        const double d = (double)output[i] - reference[i];
+        worst     = std::max(worst, std::abs(d));
+        residual += d * d;
+        signal   += (double)reference[i] * reference[i];
+    }
+    result.maxDifference = decibels(worst);
+    result.residualRms   = decibels(std::sqrt(residual / output.size()));
+    result.snr           = (residual > 0.0) ? 10.0 * std::log10(signal / residual) : 999.0;
+
+    // K instances: resident memory, then a block each in turn.
+    const double before = residentBytes();
+    std::vector<std::unique_ptr<Core<DelaySample>>> cores;
+    for (int k = 0; k < instances; ++k) {
+        cores.push_back(std::make_unique<Core<DelaySample>>());
+        prepare(*cores.back(), sampleRate, blockSize);
+    }
+    result.residentBytes = (residentBytes() - before) / instances;
+    result.arenaBytes    = cores[0]->mArena.bytes();
+
+    std::vector<float> left(blockSize), right(blockSize);
+    float *out[2] = { left.data(), right.data() };
+    auto blockAt = [&](size_t block) {
+        const size_t pos = (block * blockSize) % (input.size() - blockSize);
+        return input.data() + pos;
+    };
+    // Enough blocks for every instance to reach its reverb tail.
+    const size_t rounds = std::max<size_t>(8, (size_t)(sampleRate * 0.5) / blockSize);
+    for (size_t r = 0; r < 2; ++r) {
+        for (auto &core : cores) {
+            const float *in[1] = { blockAt(r) };
+            core->process(std::span<const float *>(in, 1), std::span<float *>(out, 2), blockSize);
+        }
+    }
+    CacheMissCounters counters;
+    counters.start();
+    auto start = Clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        for (auto &core : cores) {
+            const float *in[1] = { blockAt(r) };
+            core->process(std::span<const float *>(in, 1), std::span<float *>(out, 2), blockSize);
+        }
+    }
+    const double cold = std::chrono::duration<double>(Clock::now() - start).count();
+    counters.stop();
+    const double blocks = (double)rounds * instances;
+    result.coldNs = cold * 1e9 / (blocks * blockSize);
+    for (int i = 0; i < 2; ++i) result.misses[i] = counters.available(i) ? (double)counters.count(i) / blocks : -1.0;
+    cores.clear();
+
+    // One instance on its own, with everything in cache.
+    Core<DelaySample> hot;
+    prepare(hot, sampleRate, blockSize);
+    const size_t hotBlocks = (size_t)rounds * (size_t)std::min(instances, 64);
+    start = Clock::now();
+    for (size_t b = 0; b < hotBlocks; ++b) {
+        const float *in[1] = { blockAt(b) };
+        hot.process(std::span<const float *>(in, 1), std::span<float *>(out, 2), blockSize);
+    }
+    result.hotNs = std::chrono::duration<double>(Clock::now() - start).count() * 1e9 / ((double)hotBlocks * blockSize);
+    return result;
+}
+
+void printMisses(double perBlock) {
+    if (perBlock < 0.0) std::printf(" %10s", "n/a");
+    else                std::printf(" %10.0f", perBlock);
+}
+
+template <typename DelaySample>
+void report(const std::vector<float> &input, const std::vector<float> &reference,
+            double sampleRate, int instances, uint32_t blockSize) {
+    const Result r = measure<DelaySample>(input, reference, sampleRate, instances, blockSize);
+    std::printf("%9s %9.0f %9zu %9.1f", DelayFormat<DelaySample>::kName, sampleRate / 1000.0,
+                r.arenaBytes / 1024, r.residentBytes / 1024.0);
+    if (r.snr >= 999.0) std::printf(" %9s %9s %7s", "exact", "exact", "-");
+    else                std::printf(" %9.1f %9.1f %7.1f", r.maxDifference, r.residualRms, r.snr);
+    std::printf(" %8.2f %9.2f", r.hotNs, r.coldNs);
+    printMisses(r.misses[0]);
+    printMisses(r.misses[1]);
+    std::printf("\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const int      instances = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 256;
+    const uint32_t blockSize = (argc > 2) ? (uint32_t)std::max(16, std::atoi(argv[2])) : 256;
+
+    std::printf("%d instances, %u-frame blocks, mono in / stereo out, knob %.0f ms\n", instances, blockSize, kDelayTimeMs);
+    std::printf("%9s %9s %9s %9s %9s %9s %7s %8s %9s %10s %10s\n", "format", "kHz", "arena KiB", "RSS KiB",
+                "max dBFS", "rms dBFS", "SNR dB", "hot ns", "K inst ns", "L1D/blk", "LLC/blk");
+    for (double sampleRate : { 48000.0, 192000.0 }) {
+        const std::vector<float> input     = makeProgramme(sampleRate);
+        const std::vector<float> reference = render<float>(input, sampleRate, blockSize);
+        report<float>(input, reference, sampleRate, instances, blockSize);
+        report<DelayPacked24>(input, reference, sampleRate, instances, blockSize);
+        report<DelayHalf>(input, reference, sampleRate, instances, blockSize);
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+//
+//  vxfission_denormal_bench.cpp
+//  VXFission Tools
+//
+//  Decaying-tail benchmark. Renders two cores block by block, interleaved:
+//  one is fed a single click and then silence (the sparse input that drives
+//  the Freeverb rings subnormal fastest), the other continuous noise at
+//  -12 dBFS as the reference cost. Reports the tail's per-block cost (median
+//  and worst block per half second) and its ratio to the reference along the
+//  tail until the wet bus goes to sleep. With denormals handled the ratio
+//  stays near 1; without, the tail costs up to several times the noise.
+//
+//  CMake builds it once per strategy:
+//    vxfission_denormal_bench          FTZ/DAZ render scope (the default)
+//    vxfission_denormal_bench_guard    portable in-loop guard, FPU untouched
+//    vxfission_denormal_bench_none     neither, for comparison
+//
+//    vxfission_denormal_bench [sample rate] [seconds] [block size]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <vector>
+
+#include "VXFissionExtensionDSPCore.hpp"
+
+int main(int argc, char **argv) {
+    const double   sampleRate = (argc > 1) ? std::strtod(argv[1], nullptr) : 48000.0;
+    const double   seconds    = (argc > 2) ? std::strtod(argv[2], nullptr) : 6.0;
+    const uint32_t blockSize  = (argc > 3) ? (uint32_t)std::max(1, std::atoi(argv[3])) : 256;
+    const double   window     = 0.5;  // seconds per reported row
+
+    const char *strategy = VXFISSION_FLUSH_DENORMALS ? "ftz/daz scope"
+                         : VXFISSION_DENORMAL_GUARD  ? "in-loop guard" : "unprotected";
+
+    VXFissionExtensionDSPCore tail, reference;
+    for (VXFissionExtensionDSPCore *core : { &tail, &reference }) {
+        core->setMaximumFramesToRender(blockSize);
+        core->initialize(1, 2, sampleRate);
+        core->setDelayTime(25.0f);
+    }
+
+    std::vector<float> click(blockSize), noise(blockSize), outL(blockSize), outR(blockSize);
+    float *out[2] = { outL.data(), outR.data() };
+    auto render = [&](VXFissionExtensionDSPCore &core, const std::vector<float> &input) {
+        const float *in[1] = { input.data() };
+        auto start = std::chrono::steady_clock::now();
+        core.process(std::span<const float *>(in, 1), std::span<float *>(out, 2), blockSize);
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / blockSize;
+    };
+
+    const size_t blocks          = (size_t)(seconds * sampleRate) / blockSize;
+    const size_t blocksPerWindow = std::max<size_t>(1, (size_t)(window * sampleRate) / blockSize);
+    const size_t clickBlock      = (size_t)(0.010 * sampleRate) / blockSize;
+    const double budgetNs        = 1e9 / sampleRate;
+
+    std::printf("decaying tail, %s, %.0f Hz, %u-frame blocks, click at 10 ms\n", strategy, sampleRate, blockSize);
+    std::printf("%10s %12s %12s %10s %12s %12s\n", "window s", "median ns/f", "max ns/f", "% budget", "vs noise", "tail peak");
+    std::vector<double> tailNs, referenceNs;
+    double worstRatio = 0.0;
+    float  tailPeak   = 0.0f;
+    uint32_t seed = 0x2468ace1u;
+    for (size_t b = 0; b < blocks; ++b) {
+        std::fill(click.begin(), click.end(), 0.0f);
+        if (b == clickBlock) click[0] = 1.0f;
+        for (float &x : noise) {
+            seed = seed * 1664525u + 1013904223u;
+            x = ((float)(seed >> 8) / 8388608.0f - 1.0f) * 0.25f;
+        }
+
+        referenceNs.push_back(render(reference, noise));
+        tailNs.push_back(render(tail, click));
+        for (uint32_t f = 0; f < blockSize; ++f) tailPeak = std::max({ tailPeak, std::abs(outL[f]), std::abs(outR[f]) });
+
+        if ((b + 1) % blocksPerWindow == 0) {
+            std::sort(tailNs.begin(), tailNs.end());
+            std::sort(referenceNs.begin(), referenceNs.end());
+            const double median = tailNs[tailNs.size() / 2];
+            const double ratio  = median / referenceNs[referenceNs.size() / 2];
+            if (tailPeak > 0.0f) worstRatio = std::max(worstRatio, ratio);  // while the tail is still audible
+            std::printf("%10.1f %12.2f %12.2f %9.2f%% %11.2fx %12.3g\n",
+                        (double)(b + 1) * blockSize / sampleRate, median, tailNs.back(),
+                        100.0 * median / budgetNs, ratio, tailPeak);
+            tailNs.clear();
+            referenceNs.clear();
+            tailPeak = 0.0f;
+        }
+    }
+    std::printf("worst tail window vs noise: %.2fx\n", worstRatio);
+    return 0;
+}
@@ -0,0 +1,156 @@
+//
+//  vxfission_events_bench.cpp
+//  VXFission Tools
+//
+//  Benchmark for render-event coalescing under dense automation. For each
+//  host buffer size (32, 64, 128 frames) and event density (0, 8, 64
+//  delay-time events per buffer, a mix of jumps and ramps at random offsets)
+//  it renders stereo noise two ways and reports ns/frame and the share of one
+//  core's realtime budget:
+//    - split:     one process() call per segment between events, the events
+//                 applied in between, as AUProcessHelper does without coalescing
+//    - coalesced: every event queued with its offset, one process() per buffer
+//  Both renders are compared sample for sample; they must be identical.
+//
+//    vxfission_events_bench [sample rate] [seconds]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <vector>
+
+#include "VXFissionExtensionDSPCore.hpp"
+
+namespace {
+
+constexpr int kChannels = 2;
+constexpr int kRepeats  = 5;
+
+struct Event {
+    uint32_t offset;
+    float    valueMs;
+    uint32_t rampFrames;  // 0 = jump
+};
+
+// Events for every buffer, sorted by offset within each: half jumps, half
+// ramps of up to 20 ms, across the whole knob range.
+std::vector<std::vector<Event>> makeEvents(size_t buffers, uint32_t bufferSize, int perBuffer, double sampleRate) {
+    std::vector<std::vector<Event>> events(buffers);
+    uint32_t seed = 0x5eed1234u + (uint32_t)perBuffer * 7919u + bufferSize;
+    auto next = [&seed] { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+    for (std::vector<Event> &buffer : events) {
+        for (int k = 0; k < perBuffer; ++k) {
+            Event e;
+            e.offset     = next() % bufferSize;
+            e.valueMs    = (float)(next() % 101) - 50.0f;
+            e.rampFrames = (next() & 1) ? (uint32_t)(next() % (uint32_t)(0.020 * sampleRate)) : 0;
+            buffer.push_back(e);
+        }
+        std::stable_sort(buffer.begin(), buffer.end(), [](const Event &a, const Event &b) { return a.offset < b.offset; });
+    }
+    return events;
+}
+
+struct Result {
+    double seconds = 0.0;
+    std::vector<std::vector<float>> output;
+};
+
+template <typename RenderBuffer>
+Result timeRender(const std::vector<std::vector<float>> &input, uint32_t bufferSize, double sampleRate, RenderBuffer renderBuffer) {
+    const size_t frames = input[0].size();
+    Result result;
+    result.seconds = 1e30;
+    result.output.assign(kChannels, std::vector<float>(frames, 0.0f));
+    for (int r = 0; r < kRepeats; ++r) {
+        VXFissionExtensionDSPCore core;
+        core.setMaximumFramesToRender(bufferSize);
+        core.initialize(kChannels, kChannels, sampleRate);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t pos = 0, buffer = 0; pos < frames; pos += bufferSize, ++buffer) {
+            uint32_t n = (uint32_t)std::min<size_t>(bufferSize, frames - pos);
+            renderBuffer(core, pos, buffer, n, result.output);
+        }
+        auto stop = std::chrono::steady_clock::now();
+        result.seconds = std::min(result.seconds, std::chrono::duration<double>(stop - start).count());
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const double sampleRate = (argc > 1) ? std::strtod(argv[1], nullptr) : 48000.0;
+    const double seconds    = (argc > 2) ? std::strtod(argv[2], nullptr) : 4.0;
+    const size_t frames     = (size_t)(sampleRate * seconds);
+
+    std::vector<std::vector<float>> input(kChannels, std::vector<float>(frames));
+    uint32_t seed = 0x2468ace1u;
+    for (std::vector<float> &channel : input) {
+        for (float &x : channel) {
+            seed = seed * 1664525u + 1013904223u;
+            x = ((float)(seed >> 8) / 8388608.0f - 1.0f) * 0.5f;
+        }
+    }
+
+    std::printf("event coalescing, %.0f Hz stereo, %.1f s, best of %d\n", sampleRate, seconds, kRepeats);
+    std::printf("%8s %8s %14s %10s %14s %10s %9s\n",
+                "buffer", "events", "split ns/f", "split %", "coalesced ns/f", "coal. %", "speedup");
+    bool identical = true;
+    for (uint32_t bufferSize : { 32u, 64u, 128u }) {
+        for (int perBuffer : { 0, 8, 64 }) {
+            const std::vector<std::vector<Event>> events =
+                makeEvents((frames + bufferSize - 1) / bufferSize, bufferSize, perBuffer, sampleRate);
+
+            // As AUProcessHelper without coalescing: each segment rebuilds its
+            // pointers and spans and makes its own process() call.
+            Result split = timeRender(input, bufferSize, sampleRate,
+                [&](VXFissionExtensionDSPCore &core, size_t pos, size_t buffer, uint32_t n, std::vector<std::vector<float>> &output) {
+                    const std::vector<Event> &bufferEvents = events[buffer];
+                    size_t next = 0;
+                    for (uint32_t done = 0; done < n; ) {
+                        while (next < bufferEvents.size() && bufferEvents[next].offset <= done) {
+                            core.rampDelayTime(bufferEvents[next].valueMs, bufferEvents[next].rampFrames);
+                            ++next;
+                        }
+                        uint32_t end = (next < bufferEvents.size()) ? bufferEvents[next].offset : n;
+                        const float *in[kChannels];
+                        float       *out[kChannels];
+                        for (int c = 0; c < kChannels; ++c) {
+                            in[c]  = input[c].data() + pos + done;
+                            out[c] = output[c].data() + pos + done;
+                        }
+                        core.process(std::span<const float *>(in, kChannels), std::span<float *>(out, kChannels), end - done);
+                        done = end;
+                    }
+                });
+
+            // Coalesced: queue every event, one call per buffer.
+            Result coalesced = timeRender(input, bufferSize, sampleRate,
+                [&](VXFissionExtensionDSPCore &core, size_t pos, size_t buffer, uint32_t n, std::vector<std::vector<float>> &output) {
+                    for (const Event &e : events[buffer]) core.scheduleDelayTime(e.offset, e.valueMs, e.rampFrames);
+                    const float *in[kChannels];
+                    float       *out[kChannels];
+                    for (int c = 0; c < kChannels; ++c) {
+                        in[c]  = input[c].data() + pos;
+                        out[c] = output[c].data() + pos;
+                    }
+                    core.process(std::span<const float *>(in, kChannels), std::span<float *>(out, kChannels), n);
+                });
+
+            identical &= (split.output == coalesced.output);
+            const double splitNs     = split.seconds * 1e9 / (double)frames;
+            const double coalescedNs = coalesced.seconds * 1e9 / (double)frames;
+            const double budgetNs    = 1e9 / sampleRate;  // realtime: one frame per sample period
+            std::printf("%8u %8d %14.2f %9.2f%% %14.2f %9.2f%% %8.2fx\n",
+                        bufferSize, perBuffer, splitNs, 100.0 * splitNs / budgetNs,
+                        coalescedNs, 100.0 * coalescedNs / budgetNs, splitNs / coalescedNs);
+        }
+    }
+    std::printf("outputs %s\n", identical ? "identical" : "DIFFER");
+    return identical ? 0 : 1;
+}
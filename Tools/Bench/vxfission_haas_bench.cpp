@@ -0,0 +1,142 @@
+//
+//  vxfission_haas_bench.cpp
+//  VXFission Tools
+//
+//  Benchmark for the fractional Haas read. For each interpolator (plus the
+//  old whole-sample read as a baseline) it sweeps the delay across the knob
+//  range like a moving smoother and reports:
+//    - read ns/sample: the delay-line read alone
+//    - SNR dB: a sine read at the swept delay against the exact delayed sine,
+//      i.e. how far below the signal the zipper/interpolation error sits
+//    - chain ns/sample: the whole signal path built with that interpolator
+//
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "VXFissionExtensionDSPCore.hpp"
+
+namespace {
+
+// The Haas read before fractional delay: truncate to a whole sample.
+struct TruncatingRead {
+    static constexpr const char *kName = "integer";
+    static constexpr int kTapsOlder = 0;
+    struct State {};
+
+    template <typename Sample>
+    static float read(const Sample *ring, int mask, int now, float delay, State &) {
+        return delaySample(ring[ringTap(now, (int)delay, mask)]);
+    }
+    static void follow(State &, float) {}
+};
+
+struct ReadResult {
+    double nsPerSample = 0.0;
+    double snrDb       = 0.0;
+};
+
+// Delay in samples for frame t: a triangle between 1 ms and 40 ms, two
+// seconds each way — a steady knob sweep.
+float sweptDelay(size_t t, double sampleRate) {
+    const double period = 4.0 * sampleRate;
+    double phase = std::fmod((double)t, period) / period;
+    double tri   = (phase < 0.5) ? phase * 2.0 : 2.0 - phase * 2.0;
+    return (float)((1.0 + 39.0 * tri) * sampleRate / 1000.0);
+}
+
+template <typename Interpolator>
+ReadResult benchRead(const std::vector<float> &signal, double sampleRate, double toneHz, int repeats) {
+    const int ringSize = (int)nextPowerOfTwo((size_t)(sampleRate * 0.050) + 1 + Interpolator::kTapsOlder + 1);
+    const int ringMask = ringSize - 1;
+    std::vector<float> ring(ringSize, 0.0f);
+    std::vector<float> out(signal.size());
+    std::vector<float> delays(signal.size());
+    for (size_t t = 0; t < signal.size(); ++t) delays[t] = sweptDelay(t, sampleRate);
+
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r) {
+        std::fill(ring.begin(), ring.end(), 0.0f);
+        typename Interpolator::State state {};
+        int head = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t t = 0; t < signal.size(); ++t) {
+            ring[head] = signal[t];
+            out[t] = Interpolator::read(ring.data(), ringMask, head, delays[t], state);
+            head = (head + 1) & ringMask;
+        }
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(stop - start).count());
+    }
+
+    // Skip the first 50 ms while the ring fills.
+    double signalPower = 0.0, errorPower = 0.0;
+    const double w = 2.0 * M_PI * toneHz / sampleRate;
+    for (size_t t = (size_t)(sampleRate * 0.050); t < signal.size(); ++t) {
+        double exact = 0.5 * std::sin(w * ((double)t - (double)delays[t]));
+        double error = (double)out[t] - exact;
+        signalPower += exact * exact;
+        errorPower  += error * error;
+    }
+    return { best * 1e9 / (double)signal.size(), 10.0 * std::log10(signalPower / errorPower) };
+}
+
+// Whole signal path with the given Haas interpolator, knob at `delayMs`.
+template <typename Interpolator>
+double benchChain(const std::vector<float> &input, double sampleRate, float delayMs, int repeats) {
+    const uint32_t block = 256;
+    std::vector<float> outL(input.size()), outR(input.size());
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r) {
+        VXFissionExtensionDSPCoreT<Interpolator> core;
+        core.setMaximumFramesToRender(block);
+        core.initialize(1, 2, sampleRate);
+        core.setDelayTime(delayMs);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t pos = 0; pos < input.size(); pos += block) {
+            uint32_t n = (uint32_t)std::min<size_t>(block, input.size() - pos);
+            const float *in[1]  = { input.data() + pos };
+            float       *out[2] = { outL.data() + pos, outR.data() + pos };
+            core.process(std::span<const float *>(in, 1), std::span<float *>(out, 2), n);
+        }
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(stop - start).count());
+    }
+    return best * 1e9 / (double)input.size();
+}
+
+template <typename Interpolator>
+void report(const std::vector<float> &tone, const std::vector<float> &noise, double sampleRate, double toneHz, int repeats) {
+    ReadResult read = benchRead<Interpolator>(tone, sampleRate, toneHz, repeats);
+    double chain    = benchChain<Interpolator>(noise, sampleRate, 25.0f, repeats);
+    std::printf("%10s %14.2f %10.1f %16.2f\n", Interpolator::kName, read.nsPerSample, read.snrDb, chain);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const double sampleRate = (argc > 1) ? std::strtod(argv[1], nullptr) : 48000.0;
+    const double toneHz     = (argc > 2) ? std::strtod(argv[2], nullptr) : 5000.0;
+    const double seconds    = 8.0;
+    const int    repeats    = 5;
+    const size_t frames     = (size_t)(sampleRate * seconds);
+
+    std::vector<float> tone(frames), noise(frames);
+    uint32_t seed = 0x1357924u;
+    for (size_t t = 0; t < frames; ++t) {
+        tone[t] = (float)(0.5 * std::sin(2.0 * M_PI * toneHz * (double)t / sampleRate));
+        seed = seed * 1664525u + 1013904223u;
+        noise[t] = ((float)(seed >> 8) / 8388608.0f - 1.0f) * 0.5f;
+    }
+
+    std::printf("Haas read, %.0f Hz, %.0f Hz tone, delay swept 1–40 ms\n", sampleRate, toneHz);
+    std::printf("%10s %14s %10s %16s\n", "mode", "read ns/s", "SNR dB", "chain ns/s");
+    report<TruncatingRead>(tone, noise, sampleRate, toneHz, repeats);
+    report<LinearInterpolator>(tone, noise, sampleRate, toneHz, repeats);
+    report<HermiteInterpolator>(tone, noise, sampleRate, toneHz, repeats);
+    report<ThiranInterpolator>(tone, noise, sampleRate, toneHz, repeats);
+    return 0;
+}
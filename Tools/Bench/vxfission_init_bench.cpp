@@ -0,0 +1,91 @@
+//
+//  vxfission_init_bench.cpp
+//  VXFission Tools
+//
+//  Project-load benchmark. Opening a session creates every instance and the
+//  host then renegotiates formats, calling initialize() several times per
+//  instance before any audio runs. This replays that for K instances (default
+//  500) and reports the wall time of each step across all of them:
+//    - create:       construct and first initialize() at 44.1 kHz
+//    - rate change:  initialize() at 48 kHz
+//    - same rate ×3: initialize() at 48 kHz again, three times
+//    - after audio:  one block rendered, then initialize() at 48 kHz
+//    - realloc:      deInitialize() then initialize() at 48 kHz, as the Audio
+//                    Unit does when the host renegotiates its formats
+//    - odd rate:     initialize() at 50 kHz, outside the precomputed tables
+//    - every rate:   initialize() at each standard rate in turn
+//
+//    vxfission_init_bench [instances] [max frames]
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "VXFissionExtensionDSPCore.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double timeStep(const std::function<void()> &step) {
+    auto start = Clock::now();
+    step();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const int      instances = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 500;
+    const uint32_t maxFrames = (argc > 2) ? (uint32_t)std::max(1, std::atoi(argv[2])) : 512;
+
+    std::vector<std::unique_ptr<VXFissionExtensionDSPCore>> cores;
+    cores.reserve(instances);
+    auto initializeAll = [&](double sampleRate, int times) {
+        for (int t = 0; t < times; ++t) {
+            for (auto &core : cores) core->initialize(1, 2, sampleRate);
+        }
+    };
+
+    std::vector<float> input(maxFrames, 0.25f), outL(maxFrames), outR(maxFrames);
+    auto renderAll = [&] {
+        const float *in[1]  = { input.data() };
+        float       *out[2] = { outL.data(), outR.data() };
+        for (auto &core : cores) core->process(std::span<const float *>(in, 1), std::span<float *>(out, 2), maxFrames);
+    };
+
+    struct Step { const char *name; double seconds; };
+    std::vector<Step> steps;
+    steps.push_back({ "create", timeStep([&] {
+        for (int k = 0; k < instances; ++k) {
+            cores.push_back(std::make_unique<VXFissionExtensionDSPCore>());
+            cores.back()->setMaximumFramesToRender(maxFrames);
+            cores.back()->initialize(1, 2, 44100.0);
+        }
+    }) });
+    steps.push_back({ "rate change", timeStep([&] { initializeAll(48000.0, 1); }) });
+    steps.push_back({ "same rate x3", timeStep([&] { initializeAll(48000.0, 3); }) });
+    renderAll();
+    steps.push_back({ "after audio", timeStep([&] { initializeAll(48000.0, 1); }) });
+    renderAll();
+    steps.push_back({ "realloc", timeStep([&] {
+        for (auto &core : cores) core->deInitialize();
+        initializeAll(48000.0, 1);
+    }) });
+    steps.push_back({ "odd rate", timeStep([&] { initializeAll(50000.0, 1); }) });
+    steps.push_back({ "every rate", timeStep([&] {
+        for (double rate : { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 }) initializeAll(rate, 1);
+    }) });
+
+    std::printf("%d instances, %u-frame max, mono in / stereo out\n", instances, maxFrames);
+    std::printf("%14s %12s %16s\n", "step", "total ms", "us/instance");
+    for (const Step &step : steps) {
+        std::printf("%14s %12.2f %16.2f\n", step.name, step.seconds * 1e3, step.seconds * 1e6 / instances);
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+//
+//  vxfission_oversampling_bench.cpp
+//  VXFission Tools
+//
+//  Benchmark for the oversampled output compressor. For each factor (1x, 2x,
+//  4x) it reports:
+//    - latency: the delay the factor adds, in samples
+//    - comp ns/sample: the compressor stage alone, resampling included
+//    - chain ns/sample: the whole signal path with that factor
+//    - alias dB: a 0 dBFS sine through the compressor at full depth, with
+//      every harmonic of the sine removed; what is left is energy folded back
+//      from above Nyquist, relative to the fundamental
+//
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "VXFissionExtensionDSPCore.hpp"
+
+namespace {
+
+constexpr int kBlock = 256;
+
+struct CompressorResult {
+    double nsPerSample = 0.0;
+    double aliasDb     = 0.0;
+};
+
+// Energy left in y[0, n) after projecting out every harmonic of f0 below
+// Nyquist, relative to the fundamental's energy. f0 and n are chosen so each
+// harmonic completes a whole number of cycles, which makes the projections
+// exact.
+double inharmonicDb(const std::vector<float> &y, size_t start, size_t n, double f0, double sampleRate) {
+    double total = 0.0;
+    for (size_t t = 0; t < n; ++t) total += (double)y[start + t] * y[start + t];
+    double harmonics = 0.0, fundamental = 0.0;
+    for (int k = 1; k * f0 < sampleRate / 2.0; ++k) {
+        const double w = 2.0 * M_PI * k * f0 / sampleRate;
+        double c = 0.0, s = 0.0;
+        for (size_t t = 0; t < n; ++t) {
+            c += y[start + t] * std::cos(w * (double)t);
+            s += y[start + t] * std::sin(w * (double)t);
+        }
+        double energy = 2.0 * (c * c + s * s) / (double)n;
+        harmonics += energy;
+        if (k == 1) fundamental = energy;
+    }
+    return 10.0 * std::log10(std::max(total - harmonics, 1e-30) / fundamental);
+}
+
+CompressorResult benchCompressor(int factor, double sampleRate, int repeats) {
+    // 7001 Hz: its harmonics and their aliases never land on each other.
+    const double f0     = 7001.0;
+    const size_t warmup = (size_t)(sampleRate / 2.0);
+    const size_t frames = warmup + (size_t)sampleRate;  // analyse exactly one second
+    std::vector<float> in(frames), outL(frames), outR(frames);
+    for (size_t t = 0; t < frames; ++t) in[t] = (float)std::sin(2.0 * M_PI * f0 * (double)t / sampleRate);
+    std::vector<float> bus(kBlock, 1.0f);
+
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r) {
+        OutputCompressor comp;
+        comp.initialize(sampleRate, kBlock, 2);
+        comp.setOversampling(factor);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t pos = 0; pos < frames; pos += kBlock) {
+            int n = (int)std::min<size_t>(kBlock, frames - pos);
+            const float *mix[2] = { in.data() + pos, in.data() + pos };
+            float       *out[2] = { outL.data() + pos, outR.data() + pos };
+            comp.process(mix, out, 2, bus.data(), n);
+        }
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(stop - start).count());
+    }
+    return { best * 1e9 / (double)frames, inharmonicDb(outL, warmup, frames - warmup, f0, sampleRate) };
+}
+
+double benchChain(int factor, const std::vector<float> &input, double sampleRate, int repeats) {
+    std::vector<float> outL(input.size()), outR(input.size());
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r) {
+        VXFissionExtensionDSPCore core;
+        core.setMaximumFramesToRender(kBlock);
+        core.setOversampling(factor);
+        core.initialize(1, 2, sampleRate);
+        core.setDelayTime(25.0f);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t pos = 0; pos < input.size(); pos += kBlock) {
+            uint32_t n = (uint32_t)std::min<size_t>(kBlock, input.size() - pos);
+            const float *in[1]  = { input.data() + pos };
+            float       *out[2] = { outL.data() + pos, outR.data() + pos };
+            core.process(std::span<const float *>(in, 1), std::span<float *>(out, 2), n);
+        }
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(stop - start).count());
+    }
+    return best * 1e9 / (double)input.size();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const double sampleRate = (argc > 1) ? std::strtod(argv[1], nullptr) : 44100.0;
+    const int    repeats    = 5;
+
+    std::vector<float> noise((size_t)(sampleRate * 8.0));
+    uint32_t seed = 0x13572468u;
+    for (float &x : noise) {
+        seed = seed * 1664525u + 1013904223u;
+        x = ((float)(seed >> 8) / 8388608.0f - 1.0f) * 0.9f;
+    }
+
+    std::printf("Compressor oversampling, %.0f Hz, %d-frame blocks, SIMD: %s\n", sampleRate, kBlock, simdInstructionSetName());
+    std::printf("%8s %10s %16s %16s %10s\n", "factor", "latency", "comp ns/s", "chain ns/s", "alias dB");
+    for (int factor : { 1, 2, 4 }) {
+        CompressorResult comp = benchCompressor(factor, sampleRate, repeats);
+        double chain = benchChain(factor, noise, sampleRate, repeats);
+        std::printf("%7dx %10d %16.2f %16.2f %10.1f\n", factor, Oversampler::latencyFor(factor), comp.nsPerSample, chain, comp.aliasDb);
+    }
+    return 0;
+}
@@ -0,0 +1,220 @@
+//
+//  vxfission_quality_bench.cpp
+//  VXFission Tools
+//
+//  Quality-governor stress benchmark (see VXFissionExtensionQuality.hpp).
+//  Simulates a realtime session: every callback renders K instances (default
+//  8) of a speech-like programme, each instance claiming 1/K of the buffer
+//  period, on a machine that slows down part-way through: after a calm
+//  stretch, a slowdown factor ramps up to `peak`, holds, and ramps back. A
+//  render at factor s takes its real time plus s − 1 times the typical
+//  render at the tier it ran at (measured first), all inside the governor's
+//  timing; scaling the typical time rather than the render's own keeps a
+//  preemption of the test machine from being multiplied along with the work.
+//  A callback that takes longer than the buffer period is a dropout. The same schedule runs at each fixed tier and
+//  with the governor choosing, and for each reports:
+//    - dropouts:   callbacks over the deadline
+//    - at eco:     of those, callbacks where every instance already rendered
+//                  at eco, which no choice of tier could have avoided
+//    - worst:      the slowest callback, as a share of the period
+//    - switches:   tier changes per instance
+//    - eco/std/hi: share of the audio rendered at each tier
+//
+//  Each tier's callback time is measured first, the three interleaved so
+//  they see the same machine. The peak defaults to midway (geometrically)
+//  between the slowdowns that take eco and standard to the deadline: the
+//  slowed machine cannot keep up at the standard tier, but can at eco.
+//
+//    vxfission_quality_bench [instances] [block frames] [peak slowdown]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "VXFissionExtensionDSPCore.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double kSampleRate  = 48000.0;
+constexpr float  kDelayTimeMs = 25.0f;
+
+// Slowdown schedule, in seconds of audio: calm, ramp up, hold, ramp down, calm.
+constexpr double kCalm = 2.5, kRampUp = 1.0, kHold = 4.0, kRampDown = 1.0, kCalmAfter = 3.0;
+constexpr double kSeconds = kCalm + kRampUp + kHold + kRampDown + kCalmAfter;
+
+double slowdownAt(double t, double peak) {
+    if (t < kCalm) return 1.0;
+    t -= kCalm;
+    if (t < kRampUp) return 1.0 + (peak - 1.0) * t / kRampUp;
+    t -= kRampUp;
+    if (t < kHold) return peak;
+    t -= kHold;
+    if (t < kRampDown) return peak - (peak - 1.0) * t / kRampDown;
+    return 1.0;
+}
+
+// Mono speech-like programme: low-passed noise in ~4 Hz syllables.
+std::vector<float> makeProgramme(size_t frames) {
+    std::vector<float> signal(frames);
+    uint32_t seed = 0x1234567u;
+    float lp = 0.0f;
+    for (size_t f = 0; f < frames; ++f) {
+        seed = seed * 1664525u + 1013904223u;
+        lp += 0.2f * ((float)(seed >> 8) / 8388608.0f - 1.0f - lp);
+        const double t = (double)f / kSampleRate;
+        signal[f] = 0.8f * lp * (float)std::max(0.0, std::sin(2.0 * M_PI * 4.0 * t));
+    }
+    return signal;
+}
+
+struct Session {
+    std::vector<std::unique_ptr<VXFissionExtensionDSPCore>> cores;
+    std::vector<float> left, right;
+    uint32_t blockSize;
+
+    Session(int instances, uint32_t block, VXFissionQualityMode mode) : left(block), right(block), blockSize(block) {
+        VXFissionGovernorSettings settings;
+        settings.budgetShare = 1.0 / instances;
+        for (int k = 0; k < instances; ++k) {
+            auto core = std::make_unique<VXFissionExtensionDSPCore>();
+            core->setGovernorSettings(settings);
+            core->setQualityMode(mode);
+            core->setMaximumFramesToRender(block);
+            core->initialize(1, 2, kSampleRate);
+            core->setDelayTime(kDelayTimeMs);
+            cores.push_back(std::move(core));
+        }
+    }
+
+    std::chrono::duration<double> typical[kQualityTiers] {};  // one instance's render at each tier
+
+    // One callback: every instance in turn, each render slowed down inside
+    // the governor's timing. Returns the callback's wall time in seconds.
+    double callback(const float *input, double slowdown) {
+        const float *in[1]  = { input };
+        float       *out[2] = { left.data(), right.data() };
+        const auto start = Clock::now();
+        for (auto &core : cores) {
+            core->beginRenderTiming();
+            core->process(std::span<const float *>(in, 1), std::span<float *>(out, 2), blockSize);
+            const auto slowed = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                typical[(int)core->qualityTier()] * (slowdown - 1.0));
+            while (Clock::now() < slowed) {}
+            core->endRenderTiming(blockSize);
+        }
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+};
+
+struct Result {
+    int    dropouts = 0;
+    int    dropoutsAtEco = 0;             // with every instance at eco
+    double worst    = 0.0;                // of the period
+    double switches = 0.0;                // per instance
+    double tierShare[kQualityTiers] = {};
+};
+
+Result run(const std::vector<float> &input, int instances, uint32_t blockSize, VXFissionQualityMode mode,
+           double peak, const double *callbackSeconds) {
+    Session session(instances, blockSize, mode);
+    for (int t = 0; t < kQualityTiers; ++t) session.typical[t] = std::chrono::duration<double>(callbackSeconds[t] / instances);
+    const double period = blockSize / kSampleRate;
+    const size_t blocks = (size_t)(kSeconds * kSampleRate) / blockSize;
+    std::vector<VXFissionQualityTier> last(instances);
+    for (int k = 0; k < instances; ++k) last[k] = session.cores[k]->qualityTier();
+
+    Result result;
+    for (size_t b = 0; b < blocks; ++b) {
+        const double seconds = session.callback(input.data() + b * blockSize, slowdownAt(b * period, peak));
+        result.worst = std::max(result.worst, seconds / period);
+        bool allEco = true;
+        for (int k = 0; k < instances; ++k) {
+            const VXFissionQualityTier tier = session.cores[k]->qualityTier();
+            allEco &= (tier == VXFissionQualityTier::Eco);
+            if (tier != last[k]) result.switches += 1.0;
+            last[k] = tier;
+            result.tierShare[(int)tier] += 1.0;
+        }
+        if (seconds > period) {
+            ++result.dropouts;
+            if (allEco) ++result.dropoutsAtEco;
+        }
+    }
+    result.switches /= instances;
+    for (double &share : result.tierShare) share /= (double)blocks * instances;
+    return result;
+}
+
+// Median seconds per callback at each fixed tier, with no slowdown.
+void callbackSeconds(const std::vector<float> &input, int instances, uint32_t blockSize, double *seconds) {
+    std::vector<std::unique_ptr<Session>> sessions;
+    for (int t = 0; t < kQualityTiers; ++t) {
+        sessions.push_back(std::make_unique<Session>(instances, blockSize, (VXFissionQualityMode)(t + 1)));
+    }
+    const size_t blocks = input.size() / blockSize;
+    std::vector<double> times[kQualityTiers];
+    for (size_t b = 0; b < blocks; ++b) {
+        for (int t = 0; t < kQualityTiers; ++t) {
+            const double s = sessions[t]->callback(input.data() + b * blockSize, 1.0);
+            if (b >= 50) times[t].push_back(s);
+        }
+    }
+    for (int t = 0; t < kQualityTiers; ++t) {
+        std::nth_element(times[t].begin(), times[t].begin() + times[t].size() / 2, times[t].end());
+        seconds[t] = times[t][times[t].size() / 2];
+    }
+}
+
+const char *modeName(VXFissionQualityMode mode) {
+    switch (mode) {
+        case VXFissionQualityMode::Auto:     return "auto";
+        case VXFissionQualityMode::Eco:      return "eco";
+        case VXFissionQualityMode::Standard: return "standard";
+        case VXFissionQualityMode::High:     return "high";
+    }
+    return "?";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const int      instances = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 8;
+    const uint32_t blockSize = (argc > 2) ? (uint32_t)std::max(16, std::atoi(argv[2])) : 256;
+    const double   period    = blockSize / kSampleRate;
+
+    const std::vector<float> input = makeProgramme((size_t)(kSeconds * kSampleRate) + blockSize);
+    constexpr VXFissionQualityMode kModes[] = { VXFissionQualityMode::Eco, VXFissionQualityMode::Standard,
+                                                VXFissionQualityMode::High, VXFissionQualityMode::Auto };
+
+    std::printf("%d instances, %u-frame blocks at %.0f kHz: %.2f ms period\n", instances, blockSize, kSampleRate / 1000.0, period * 1e3);
+    double seconds[kQualityTiers];
+    callbackSeconds(input, instances, blockSize, seconds);
+    for (int t = 0; t < kQualityTiers; ++t) {
+        std::printf("  %-8s %8.1f us per callback (%5.2f %% of the period)\n", qualityTierName((VXFissionQualityTier)t),
+                    seconds[t] * 1e6, 100.0 * seconds[t] / period);
+    }
+    const double eco      = seconds[(int)VXFissionQualityTier::Eco];
+    const double standard = seconds[(int)VXFissionQualityTier::Standard];
+    const double peak     = (argc > 3) ? std::max(1.0, std::atof(argv[3])) : period / std::sqrt(eco * standard);
+    std::printf("slowdown: 1× for %.1f s, up to %.1f× over %.1f s, held %.1f s, back over %.1f s, 1× for %.1f s\n",
+                kCalm, peak, kRampUp, kHold, kRampDown, kCalmAfter);
+    std::printf("at the peak: eco %.0f %%, standard %.0f %% of the period\n\n", 100.0 * eco * peak / period,
+                100.0 * standard * peak / period);
+
+    std::printf("%-9s %9s %7s %8s %9s %7s %7s %7s\n", "quality", "dropouts", "at eco", "worst", "switches", "eco", "std", "high");
+    for (VXFissionQualityMode mode : kModes) {
+        const Result r = run(input, instances, blockSize, mode, peak, seconds);
+        std::printf("%-9s %9d %7d %7.0f%% %9.1f %6.0f%% %6.0f%% %6.0f%%\n", modeName(mode), r.dropouts, r.dropoutsAtEco, 100.0 * r.worst,
+                    r.switches, 100.0 * r.tierShare[0], 100.0 * r.tierShare[1], 100.0 * r.tierShare[2]);
+    }
+    return 0;
+}
@@ -0,0 +1,182 @@
+//
+//  vxfission_segmented_bench.cpp
+//  VXFission Tools
+//
+//  Wall-clock scaling of one long render split across threads
+//  (VXFissionSegmentedRenderer). Renders the input serially once — saving a
+//  checkpoint every --checkpoint seconds — then, for each thread count,
+//  renders it warmed (pre-roll and crossfaded seams) and checkpointed, and
+//  reports the wall time and speedup of each against the serial render, the
+//  share of extra audio the pre-rolls cost, the warmed render's worst
+//  difference from the serial one, and whether the checkpointed render is
+//  bit-identical to it.
+//
+//    vxfission_segmented_bench [options] [input.wav | input.raw]
+//
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "VXFissionSegmentedRenderer.hpp"
+
+namespace {
+
+struct SegmentedOptions {
+    std::string inputPath;
+    std::vector<uint32_t> threadCounts { 1, 2, 4, 8, 16, 32 };
+    VXFissionSegmentSettings settings;
+    double minutes           = 10.0;
+    double checkpointSeconds = 10.0;
+    double sampleRate        = 48000.0;
+    int    rawChannels       = 1;
+};
+
+void printUsage(const char *argv0) {
+    std::printf(
+        "usage: %s [options] [input.wav | input.raw]\n"
+        "  --threads <list>    comma-separated thread counts (default 1,2,4,8,16,32)\n"
+        "  --minutes <m>       length of the synthetic input when no file is given (default 10)\n"
+        "  --checkpoint <s>    seconds between the serial render's checkpoints (default 10)\n"
+        "  --tolerance <x>     warmed renders: state left at the seams (default 1e-4)\n"
+        "  --delay <ms>        knob position, -50..50 (default 25)\n"
+        "  --oversampling <n>  compressor oversampling, 1, 2 or 4 (default 1)\n"
+        "  --block <n>         frames per process() call (default 512)\n"
+        "  --rate <hz>         sample rate for raw or synthetic input (default 48000)\n"
+        "  --channels <n>      channel count of raw float32 input (default 1)\n",
+        argv0);
+}
+
+std::vector<uint32_t> parseList(const char *text) {
+    std::vector<uint32_t> values;
+    while (*text) {
+        char *end = nullptr;
+        unsigned long v = std::strtoul(text, &end, 10);
+        if (end == text) break;
+        if (v > 0) values.push_back((uint32_t)v);
+        text = (*end == ',') ? end + 1 : end;
+    }
+    return values;
+}
+
+bool parseArguments(int argc, char **argv, SegmentedOptions &options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--help" || arg == "-h") { printUsage(argv[0]); std::exit(0); }
+        else if (arg == "--threads"      && hasValue) options.threadCounts      = parseList(argv[++i]);
+        else if (arg == "--minutes"      && hasValue) options.minutes           = std::strtod(argv[++i], nullptr);
+        else if (arg == "--checkpoint"   && hasValue) options.checkpointSeconds = std::strtod(argv[++i], nullptr);
+        else if (arg == "--tolerance"    && hasValue) options.settings.tolerance    = std::strtod(argv[++i], nullptr);
+        else if (arg == "--delay"        && hasValue) options.settings.delayTimeMs  = std::strtof(argv[++i], nullptr);
+        else if (arg == "--oversampling" && hasValue) options.settings.oversampling = std::atoi(argv[++i]);
+        else if (arg == "--block"        && hasValue) options.settings.blockSize    = (uint32_t)std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--rate"         && hasValue) options.sampleRate        = std::strtod(argv[++i], nullptr);
+        else if (arg == "--channels"     && hasValue) options.rawChannels       = std::atoi(argv[++i]);
+        else if (!arg.empty() && arg[0] != '-' && options.inputPath.empty()) options.inputPath = arg;
+        else { std::fprintf(stderr, "unknown or incomplete option: %s\n", arg.c_str()); return false; }
+    }
+    return !options.threadCounts.empty() && options.settings.tolerance > 0.0 && options.settings.tolerance < 1.0;
+}
+
+// Mono speech-like programme: low-passed noise in ~4 Hz syllables, 2.4 s
+// phrases and 0.6 s pauses, so the reverb tail and compressor are carrying
+// state across most seams.
+VXFissionAudioData makeProgramme(double sampleRate, double seconds) {
+    VXFissionAudioData data;
+    data.sampleRate = sampleRate;
+    data.channels.assign(1, std::vector<float>((size_t)(sampleRate * seconds)));
+    uint32_t seed = 0x1234567u;
+    float lp = 0.0f;
+    for (size_t f = 0; f < data.channels[0].size(); ++f) {
+        seed = seed * 1664525u + 1013904223u;
+        lp += 0.2f * ((float)(seed >> 8) / 8388608.0f - 1.0f - lp);
+        const double t = (double)f / sampleRate;
+        const float syllable = (float)std::max(0.0, std::sin(2.0 * M_PI * 4.0 * t));
+        const float phrase   = (std::fmod(t, 3.0) < 2.4) ? 1.0f : 0.0f;
+        data.channels[0][f] = 0.8f * lp * syllable * phrase;
+    }
+    return data;
+}
+
+// Largest absolute difference, and whether there is none at all.
+float maxDifference(const VXFissionAudioData &a, const VXFissionAudioData &b, bool &identical) {
+    float worst = 0.0f;
+    identical = true;
+    for (size_t c = 0; c < a.channels.size(); ++c) {
+        for (size_t f = 0; f < a.channels[c].size(); ++f) {
+            const float d = std::abs(a.channels[c][f] - b.channels[c][f]);
+            identical &= (a.channels[c][f] == b.channels[c][f]);
+            worst = std::max(worst, d);
+        }
+    }
+    return worst;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    SegmentedOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    VXFissionAudioData input;
+    if (options.inputPath.empty()) {
+        input = makeProgramme(options.sampleRate, options.minutes * 60.0);
+    } else {
+        std::string error;
+        if (!readAudioFile(options.inputPath, options.rawChannels, options.sampleRate, input, error)) {
+            std::fprintf(stderr, "error: %s\n", error.c_str());
+            return 1;
+        }
+    }
+    if (input.frameCount() == 0 || input.channelCount() > VXFissionChannelMap::kMaxChannels) {
+        std::fprintf(stderr, "error: no audio, or more than %d channels\n", VXFissionChannelMap::kMaxChannels);
+        return 1;
+    }
+
+    const double audioSeconds = (double)input.frameCount() / input.sampleRate;
+    std::printf("input: %s, %d ch, %.0f Hz, %.1f min; %u-frame blocks, pre-roll %.2f s, %u hardware threads\n",
+                options.inputPath.empty() ? "<synthetic>" : options.inputPath.c_str(),
+                input.channelCount(), input.sampleRate, audioSeconds / 60.0, options.settings.blockSize,
+                VXFissionSegmentedRenderer::preRollSeconds(options.settings.tolerance),
+                std::thread::hardware_concurrency());
+
+    VXFissionAudioData serial, output;
+    std::vector<VXFissionCheckpoint> checkpoints;
+    VXFissionSegmentStats reference = VXFissionSegmentedRenderer(1, options.settings)
+        .renderSerial(input, serial, options.checkpointSeconds, &checkpoints);
+    std::printf("serial: %.3f s wall, %.1fx realtime, %zu checkpoints\n",
+                reference.wallSeconds, reference.realtimeFactor(), checkpoints.size());
+
+    std::printf("%8s | %9s %10s %9s %10s %12s | %9s %10s %10s\n",
+                "threads", "segments", "warmed s", "speedup", "pre-roll", "max diff dB",
+                "exact s", "speedup", "identical");
+    int status = 0;
+    for (uint32_t threads : options.threadCounts) {
+        VXFissionSegmentedRenderer renderer((int)threads, options.settings);
+
+        VXFissionSegmentStats warmed = renderer.render(input, output);
+        bool identical = false;
+        const float diff = maxDifference(serial, output, identical);
+
+        VXFissionSegmentStats exact = renderer.render(input, output, checkpoints);
+        bool exactIdentical = false;
+        maxDifference(serial, output, exactIdentical);
+        if (!exact.ok || !exactIdentical) status = 1;
+
+        std::printf("%8u | %9zu %10.3f %8.2fx %9.1f%% %12.1f | %9.3f %9.2fx %10s\n",
+                    threads, warmed.segments, warmed.wallSeconds,
+                    reference.wallSeconds / warmed.wallSeconds,
+                    100.0 * warmed.preRollSeconds / audioSeconds,
+                    (diff > 0.0f) ? 20.0 * std::log10(diff) : -INFINITY,
+                    exact.wallSeconds, reference.wallSeconds / exact.wallSeconds,
+                    !exact.ok ? "no restore" : exactIdentical ? "yes" : "no");
+    }
+    return status;
+}
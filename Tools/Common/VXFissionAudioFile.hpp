@@ -0,0 +1,193 @@
+//
+//  VXFissionAudioFile.hpp
+//  VXFission Tools
+//
+//  Minimal WAV / raw float reader and writer for the offline tools. Audio is
+//  held planar (one vector per channel) so it can be handed straight to
+//  VXFissionExtensionDSPCore::process.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+struct VXFissionAudioData {
+    double sampleRate = 48000.0;
+    std::vector<std::vector<float>> channels;
+
+    int channelCount() const { return (int)channels.size(); }
+    size_t frameCount() const { return channels.empty() ? 0 : channels[0].size(); }
+};
+
+namespace vxfission_audio_file {
+
+inline uint16_t readLE16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+inline uint32_t readLE32(const uint8_t *p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+inline void writeLE16(std::FILE *f, uint16_t v) { uint8_t b[2] = { (uint8_t)v, (uint8_t)(v >> 8) }; std::fwrite(b, 1, 2, f); }
+inline void writeLE32(std::FILE *f, uint32_t v) { uint8_t b[4] = { (uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24) }; std::fwrite(b, 1, 4, f); }
+
+inline bool endsWith(const std::string &s, const char *suffix) {
+    size_t n = std::strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+inline bool readWholeFile(const std::string &path, std::vector<uint8_t> &bytes, std::string &error) {
+    std::FILE *f = std::fopen(path.c_str(), "rb");
+    if (!f) { error = "cannot open " + path; return false; }
+    std::fseek(f, 0, SEEK_END);
+    long size = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+    bytes.resize(size > 0 ? (size_t)size : 0);
+    size_t got = bytes.empty() ? 0 : std::fread(bytes.data(), 1, bytes.size(), f);
+    std::fclose(f);
+    if (got != bytes.size()) { error = "short read on " + path; return false; }
+    return true;
+}
+
+// Decodes one interleaved sample of the given PCM/float encoding to float.
+inline float decodeSample(const uint8_t *p, int bitsPerSample, bool isFloat) {
+    if (isFloat) {
+        float v; std::memcpy(&v, p, sizeof(float)); return v;
+    }
+    switch (bitsPerSample) {
+        case 16: return (float)(int16_t)readLE16(p) / 32768.0f;
+        case 24: {
+            int32_t v = (int32_t)((uint32_t)p[0] << 8 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 24) >> 8;
+            return (float)v / 8388608.0f;
+        }
+        case 32: return (float)((double)(int32_t)readLE32(p) / 2147483648.0);
+        default: return 0.0f;
+    }
+}
+
+} // namespace vxfission_audio_file
+
+/*
+ Reads a RIFF/WAVE file (PCM 16/24/32-bit or IEEE float32, plain or
+ WAVE_FORMAT_EXTENSIBLE) into planar float.
+ */
+inline bool readWavFile(const std::string &path, VXFissionAudioData &out, std::string &error) {
+    using namespace vxfission_audio_file;
+
+    std::vector<uint8_t> bytes;
+    if (!readWholeFile(path, bytes, error)) return false;
+    if (bytes.size() < 12 || std::memcmp(bytes.data(), "RIFF", 4) != 0 || std::memcmp(bytes.data() + 8, "WAVE", 4) != 0) {
+        error = path + " is not a RIFF/WAVE file";
+        return false;
+    }
+
+    int channels = 0, bitsPerSample = 0;
+    bool isFloat = false, haveFormat = false;
+    const uint8_t *data = nullptr;
+    size_t dataSize = 0;
+
+    size_t pos = 12;
+    while (pos + 8 <= bytes.size()) {
+        const uint8_t *chunk = bytes.data() + pos;
+        uint32_t chunkSize = readLE32(chunk + 4);
+        size_t available = std::min<size_t>(chunkSize, bytes.size() - pos - 8);
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && available >= 16) {
+            uint16_t formatTag = readLE16(chunk + 8);
+            channels      = readLE16(chunk + 10);
+            out.sampleRate = (double)readLE32(chunk + 12);
+            bitsPerSample = readLE16(chunk + 22);
+            if (formatTag == 0xFFFE && available >= 26) {
+                formatTag = readLE16(chunk + 32);  // first two bytes of the subformat GUID
+            }
+            isFloat    = (formatTag == 3);
+            haveFormat = (formatTag == 1 || formatTag == 3);
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            data     = chunk + 8;
+            dataSize = available;
+        }
+        pos += 8 + chunkSize + (chunkSize & 1);
+    }
+
+    if (!haveFormat || channels <= 0 || data == nullptr) {
+        error = path + ": unsupported or missing fmt/data chunk";
+        return false;
+    }
+    if (isFloat ? bitsPerSample != 32 : (bitsPerSample != 16 && bitsPerSample != 24 && bitsPerSample != 32)) {
+        error = path + ": unsupported bit depth " + std::to_string(bitsPerSample);
+        return false;
+    }
+
+    const int bytesPerSample = bitsPerSample / 8;
+    const size_t frames = dataSize / ((size_t)bytesPerSample * channels);
+    out.channels.assign(channels, std::vector<float>(frames));
+    for (size_t f = 0; f < frames; ++f) {
+        const uint8_t *frame = data + f * bytesPerSample * channels;
+        for (int ch = 0; ch < channels; ++ch) {
+            out.channels[ch][f] = decodeSample(frame + ch * bytesPerSample, bitsPerSample, isFloat);
+        }
+    }
+    return true;
+}
+
+// Reads headerless interleaved little-endian float32.
+inline bool readRawFloatFile(const std::string &path, int channels, double sampleRate, VXFissionAudioData &out, std::string &error) {
+    using namespace vxfission_audio_file;
+
+    if (channels <= 0) { error = "raw input needs a positive channel count"; return false; }
+    std::vector<uint8_t> bytes;
+    if (!readWholeFile(path, bytes, error)) return false;
+
+    const size_t frames = bytes.size() / (sizeof(float) * channels);
+    out.sampleRate = sampleRate;
+    out.channels.assign(channels, std::vector<float>(frames));
+    for (size_t f = 0; f < frames; ++f) {
+        for (int ch = 0; ch < channels; ++ch) {
+            std::memcpy(&out.channels[ch][f], bytes.data() + (f * channels + ch) * sizeof(float), sizeof(float));
+        }
+    }
+    return true;
+}
+
+// Picks the reader from the extension: .wav / .wave, anything else is raw float32.
+inline bool readAudioFile(const std::string &path, int rawChannels, double rawSampleRate, VXFissionAudioData &out, std::string &error) {
+    using namespace vxfission_audio_file;
+    if (endsWith(path, ".wav") || endsWith(path, ".WAV") || endsWith(path, ".wave")) {
+        return readWavFile(path, out, error);
+    }
+    return readRawFloatFile(path, rawChannels, rawSampleRate, out, error);
+}
+
+// Writes planar float as an IEEE float32 WAV.
+inline bool writeWavFloatFile(const std::string &path, const VXFissionAudioData &in, std::string &error) {
+    using namespace vxfission_audio_file;
+
+    std::FILE *f = std::fopen(path.c_str(), "wb");
+    if (!f) { error = "cannot create " + path; return false; }
+
+    const uint16_t channels = (uint16_t)in.channelCount();
+    const uint32_t frames   = (uint32_t)in.frameCount();
+    const uint32_t dataSize = frames * channels * (uint32_t)sizeof(float);
+
+    std::fwrite("RIFF", 1, 4, f); writeLE32(f, 36 + dataSize);
+    std::fwrite("WAVE", 1, 4, f);
+    std::fwrite("fmt ", 1, 4, f); writeLE32(f, 16);
+    writeLE16(f, 3);                                        // IEEE float
+    writeLE16(f, channels);
+    writeLE32(f, (uint32_t)in.sampleRate);
+    writeLE32(f, (uint32_t)in.sampleRate * channels * (uint32_t)sizeof(float));
+    writeLE16(f, (uint16_t)(channels * sizeof(float)));
+    writeLE16(f, 32);
+    std::fwrite("data", 1, 4, f); writeLE32(f, dataSize);
+
+    std::vector<float> interleaved((size_t)frames * channels);
+    for (uint32_t fr = 0; fr < frames; ++fr) {
+        for (uint16_t ch = 0; ch < channels; ++ch) {
+            interleaved[(size_t)fr * channels + ch] = in.channels[ch][fr];
+        }
+    }
+    bool ok = std::fwrite(interleaved.data(), sizeof(float), interleaved.size(), f) == interleaved.size();
+    std::fclose(f);
+    if (!ok) error = "short write on " + path;
+    return ok;
+}
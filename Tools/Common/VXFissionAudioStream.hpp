@@ -0,0 +1,501 @@
+//
+//  VXFissionAudioStream.hpp
+//  VXFission Tools
+//
+//  Block-at-a-time WAV / raw float I/O for files too big to hold, used by the
+//  streaming renderer. Unlike VXFissionAudioFile.hpp nothing here reads or
+//  writes a whole file; resident memory is a few fixed buffers whatever the
+//  length. POSIX only (mmap, read, write).
+//
+//  - VXFissionByteSource: a regular file is memory-mapped and read front to
+//    back, with the pages ahead of the read position requested in advance
+//    and the ones behind it dropped. Anything that cannot be mapped (a pipe,
+//    stdin) is read in large read() calls into a fixed buffer instead.
+//  - readStreamHeader(): finds the fmt and data chunks (RIFF or RF64) without
+//    reading past the start of the audio; anything that is not a WAV is taken
+//    as raw interleaved float32.
+//  - decodeFrames() / encodeFrames(): PCM 16/24/32 or float32 interleaved
+//    bytes to and from planar float, one tight loop per encoding.
+//  - VXFissionWavStreamWriter: writes through an aligned buffer in fixed
+//    1 MiB writes. The header is padded with a JUNK chunk to 4 KiB so every
+//    write lands on a page boundary of the file, and is rewritten with the
+//    final sizes at the end (as RF64 past 4 GiB) when the output can seek.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "VXFissionAudioFile.hpp"
+
+enum class VXFissionSampleEncoding { pcm16, pcm24, pcm32, float32 };
+
+struct VXFissionStreamFormat {
+    static constexpr uint64_t kUnknownFrames = UINT64_MAX;  // read to the end of the stream
+
+    double   sampleRate = 48000.0;
+    int      channels   = 1;
+    VXFissionSampleEncoding encoding = VXFissionSampleEncoding::float32;
+    uint64_t frames     = kUnknownFrames;
+    bool     isWav      = false;
+
+    static int bytesPerSample(VXFissionSampleEncoding encoding) {
+        switch (encoding) {
+            case VXFissionSampleEncoding::pcm16: return 2;
+            case VXFissionSampleEncoding::pcm24: return 3;
+            default:                             return 4;
+        }
+    }
+    int frameBytes() const { return bytesPerSample(encoding) * channels; }
+};
+
+inline const char *encodingName(VXFissionSampleEncoding encoding) {
+    switch (encoding) {
+        case VXFissionSampleEncoding::pcm16: return "pcm16";
+        case VXFissionSampleEncoding::pcm24: return "pcm24";
+        case VXFissionSampleEncoding::pcm32: return "pcm32";
+        default:                             return "float32";
+    }
+}
+
+// MARK: - Input
+
+class VXFissionByteSource {
+public:
+    static constexpr size_t kStreamBufferBytes = 2u << 20;  // pipes: one read() buffer
+    static constexpr size_t kWindowBytes       = 1u << 20;  // mapped: prefetched ahead, dropped behind
+
+    VXFissionByteSource() = default;
+    VXFissionByteSource(const VXFissionByteSource &) = delete;
+    VXFissionByteSource &operator=(const VXFissionByteSource &) = delete;
+    ~VXFissionByteSource() { close(); }
+
+    // "-" reads stdin.
+    bool open(const std::string &path, std::string &error) {
+        close();
+        mFd = (path == "-") ? STDIN_FILENO : ::open(path.c_str(), O_RDONLY);
+        if (mFd < 0) { error = "cannot open " + path; return false; }
+        mOwnsFd = (path != "-");
+
+        struct stat info {};
+        if (::fstat(mFd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            void *map = ::mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, mFd, 0);
+            if (map != MAP_FAILED) {
+                mMap  = static_cast<const uint8_t *>(map);
+                mSize = (uint64_t)info.st_size;
+                ::madvise(map, mSize, MADV_SEQUENTIAL);
+                prefetch();
+                return true;
+            }
+        }
+        mBuffer.resize(kStreamBufferBytes);
+        return true;
+    }
+
+    void close() {
+        if (mMap) ::munmap(const_cast<uint8_t *>(mMap), mSize);
+        if (mOwnsFd && mFd >= 0) ::close(mFd);
+        mMap = nullptr; mSize = 0; mFd = -1; mOwnsFd = false;
+        mPosition = mReleased = mPrefetched = 0;
+        mBegin = mEnd = 0; mEof = false; mFailed = false;
+        mBuffer.clear();
+    }
+
+    bool isMapped() const { return mMap != nullptr; }
+    bool failed() const { return mFailed; }                  // a read() error, as opposed to the end
+    uint64_t position() const { return mPosition; }
+    uint64_t remaining() const { return isMapped() ? mSize - mPosition : UINT64_MAX; }
+
+    // The next `count` bytes, contiguous, without consuming them; fewer only
+    // at the end of the input. Streamed, a count past kStreamBufferBytes
+    // grows the buffer to fit.
+    std::span<const uint8_t> peek(size_t count) {
+        if (isMapped()) {
+            return { mMap + mPosition, (size_t)std::min<uint64_t>(count, mSize - mPosition) };
+        }
+        if (mEnd - mBegin < count && !mEof) fill(count);
+        return { mBuffer.data() + mBegin, std::min(count, mEnd - mBegin) };
+    }
+
+    // Moves the read position on; count is at most what peek() returned.
+    void consume(size_t count) {
+        mPosition += count;
+        if (isMapped()) {
+            if (mPosition >= mReleased + kWindowBytes) release();
+            if (mPosition + kWindowBytes / 2 >= mPrefetched) prefetch();
+        } else {
+            mBegin += count;
+        }
+    }
+
+    // Consumes up to `count` bytes however large; false if the input ended first.
+    bool skip(uint64_t count) {
+        while (count > 0) {
+            std::span<const uint8_t> bytes = peek((size_t)std::min<uint64_t>(count, kStreamBufferBytes));
+            if (bytes.empty()) return false;
+            consume(bytes.size());
+            count -= bytes.size();
+        }
+        return true;
+    }
+
+private:
+    // Slides what is left to the front of the buffer and reads until there
+    // are `count` bytes or the input ends.
+    void fill(size_t count) {
+        if (count > mBuffer.size()) mBuffer.resize(count);
+        std::memmove(mBuffer.data(), mBuffer.data() + mBegin, mEnd - mBegin);
+        mEnd -= mBegin;
+        mBegin = 0;
+        while (mEnd < count) {
+            ssize_t got = ::read(mFd, mBuffer.data() + mEnd, mBuffer.size() - mEnd);
+            if (got < 0 && errno == EINTR) continue;
+            if (got <= 0) { mEof = true; mFailed = (got < 0); break; }
+            mEnd += (size_t)got;
+        }
+    }
+
+    // The next window ahead of the read position, paged in while the caller
+    // decodes this one.
+    void prefetch() {
+        const uint64_t from = pageFloor(mPosition);
+        const uint64_t to   = std::min(mSize, from + 2 * kWindowBytes);
+        if (to > from) ::madvise(const_cast<uint8_t *>(mMap) + from, to - from, MADV_WILLNEED);
+        mPrefetched = to;
+    }
+
+    // Pages wholly behind the read position leave the process's resident set;
+    // they stay in the page cache, so nothing is lost if they were wanted.
+    void release() {
+        const uint64_t to = pageFloor(mPosition);
+        if (to > mReleased) ::madvise(const_cast<uint8_t *>(mMap) + mReleased, to - mReleased, MADV_DONTNEED);
+        mReleased = to;
+    }
+
+    static uint64_t pageFloor(uint64_t offset) {
+        const uint64_t page = (uint64_t)::sysconf(_SC_PAGESIZE);
+        return offset / page * page;
+    }
+
+    int  mFd     = -1;
+    bool mOwnsFd = false;
+    uint64_t mPosition = 0;
+
+    // Mapped
+    const uint8_t *mMap = nullptr;
+    uint64_t mSize       = 0;
+    uint64_t mReleased   = 0;  // [0, mReleased) dropped
+    uint64_t mPrefetched = 0;  // [.., mPrefetched) asked for
+
+    // Streamed
+    std::vector<uint8_t> mBuffer;
+    size_t mBegin  = 0;        // unread bytes are [mBegin, mEnd)
+    size_t mEnd    = 0;
+    bool   mEof    = false;
+    bool   mFailed = false;
+};
+
+/*
+ Reads up to the first audio byte. A WAV (RIFF or RF64; PCM 16/24/32-bit or
+ IEEE float32, plain or WAVE_FORMAT_EXTENSIBLE) gives its own format and
+ length; a data size of 0 or 0xFFFFFFFF, as streaming writers leave it, means
+ "to the end". Anything else is raw float32 with the given channels and rate.
+ */
+inline bool readStreamHeader(VXFissionByteSource &source, int rawChannels, double rawSampleRate,
+                             VXFissionStreamFormat &format, std::string &error) {
+    using namespace vxfission_audio_file;
+
+    std::span<const uint8_t> head = source.peek(12);
+    const bool riff = head.size() == 12 && (std::memcmp(head.data(), "RIFF", 4) == 0 || std::memcmp(head.data(), "RF64", 4) == 0)
+                      && std::memcmp(head.data() + 8, "WAVE", 4) == 0;
+    if (!riff) {
+        if (rawChannels <= 0) { error = "raw input needs a positive channel count"; return false; }
+        format = {};
+        format.sampleRate = rawSampleRate;
+        format.channels   = rawChannels;
+        format.encoding   = VXFissionSampleEncoding::float32;
+        if (source.isMapped()) format.frames = source.remaining() / (uint64_t)format.frameBytes();
+        return true;
+    }
+    source.consume(12);
+
+    format = {};
+    format.isWav = true;
+    uint64_t ds64DataSize = 0;
+    uint64_t dataBytes    = 0;
+    bool haveFormat = false;
+    int  bitsPerSample = 0;
+    uint16_t formatTag = 0;
+    for (;;) {
+        std::span<const uint8_t> chunk = source.peek(8);
+        if (chunk.size() < 8) { error = "no data chunk"; return false; }
+        const uint32_t chunkSize = readLE32(chunk.data() + 4);
+
+        if (std::memcmp(chunk.data(), "data", 4) == 0) {
+            source.consume(8);
+            dataBytes = (chunkSize == 0xFFFFFFFFu && ds64DataSize > 0) ? ds64DataSize : chunkSize;
+            if (chunkSize == 0 || (chunkSize == 0xFFFFFFFFu && ds64DataSize == 0)) dataBytes = UINT64_MAX;
+            dataBytes = std::min(dataBytes, source.remaining());  // mapped: never past the end of the file
+            break;
+        }
+        if (std::memcmp(chunk.data(), "fmt ", 4) == 0 || std::memcmp(chunk.data(), "ds64", 4) == 0) {
+            std::span<const uint8_t> body = source.peek(8 + std::min<size_t>(chunkSize, 64));
+            if (body.size() >= 8 + 16 && std::memcmp(body.data(), "fmt ", 4) == 0) {
+                formatTag         = readLE16(body.data() + 8);
+                format.channels   = readLE16(body.data() + 10);
+                format.sampleRate = (double)readLE32(body.data() + 12);
+                bitsPerSample     = readLE16(body.data() + 22);
+                if (formatTag == 0xFFFE && body.size() >= 8 + 26) formatTag = readLE16(body.data() + 32);
+                haveFormat = true;
+            } else if (body.size() >= 8 + 16 && std::memcmp(body.data(), "ds64", 4) == 0) {
+                ds64DataSize = (uint64_t)readLE32(body.data() + 16) | ((uint64_t)readLE32(body.data() + 20) << 32);
+            }
+        }
+        if (!source.skip(8 + (uint64_t)chunkSize + (chunkSize & 1))) { error = "no data chunk"; return false; }
+    }
+
+    if (!haveFormat || format.channels <= 0 || (formatTag != 1 && formatTag != 3)) {
+        error = "unsupported or missing fmt chunk";
+        return false;
+    }
+    if (formatTag == 3 && bitsPerSample == 32)  format.encoding = VXFissionSampleEncoding::float32;
+    else if (formatTag == 1 && bitsPerSample == 16) format.encoding = VXFissionSampleEncoding::pcm16;
+    else if (formatTag == 1 && bitsPerSample == 24) format.encoding = VXFissionSampleEncoding::pcm24;
+    else if (formatTag == 1 && bitsPerSample == 32) format.encoding = VXFissionSampleEncoding::pcm32;
+    else { error = "unsupported bit depth " + std::to_string(bitsPerSample); return false; }
+
+    if (dataBytes != UINT64_MAX) format.frames = dataBytes / (uint64_t)format.frameBytes();
+    return true;
+}
+
+namespace vxfission_audio_stream {
+
+template <typename Decode>
+inline void deinterleave(const uint8_t *src, int channels, int bytes, size_t frames, float *const *planar, Decode decode) {
+    for (size_t f = 0; f < frames; ++f) {
+        const uint8_t *frame = src + f * (size_t)(bytes * channels);
+        for (int ch = 0; ch < channels; ++ch) planar[ch][f] = decode(frame + ch * bytes);
+    }
+}
+
+template <typename Encode>
+inline void interleave(const float *const *planar, int channels, int bytes, size_t frames, uint8_t *dst, Encode encode) {
+    for (size_t f = 0; f < frames; ++f) {
+        uint8_t *frame = dst + f * (size_t)(bytes * channels);
+        for (int ch = 0; ch < channels; ++ch) encode(planar[ch][f], frame + ch * bytes);
+    }
+}
+
+// Rounded and clipped to the integer range, full scale at ±1.
+inline int32_t quantize(float x, double scale) {
+    const double v = std::nearbyint((double)x * scale);
+    return (int32_t)std::clamp(v, -scale, scale - 1.0);
+}
+
+} // namespace vxfission_audio_stream
+
+// Interleaved bytes of the given encoding to planar float; same scaling as
+// vxfission_audio_file::decodeSample().
+inline void decodeFrames(const uint8_t *src, VXFissionSampleEncoding encoding, int channels, size_t frames, float *const *planar) {
+    using namespace vxfission_audio_stream;
+    using vxfission_audio_file::readLE16;
+    using vxfission_audio_file::readLE32;
+    switch (encoding) {
+        case VXFissionSampleEncoding::pcm16:
+            deinterleave(src, channels, 2, frames, planar, [](const uint8_t *p) { return (float)(int16_t)readLE16(p) / 32768.0f; });
+            break;
+        case VXFissionSampleEncoding::pcm24:
+            deinterleave(src, channels, 3, frames, planar, [](const uint8_t *p) {
+                return (float)((int32_t)((uint32_t)p[0] << 8 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 24) >> 8) / 8388608.0f;
+            });
+            break;
+        case VXFissionSampleEncoding::pcm32:
+            deinterleave(src, channels, 4, frames, planar, [](const uint8_t *p) { return (float)((double)(int32_t)readLE32(p) / 2147483648.0); });
+            break;
+        case VXFissionSampleEncoding::float32:
+            deinterleave(src, channels, 4, frames, planar, [](const uint8_t *p) { float v; std::memcpy(&v, p, sizeof(float)); return v; });
+            break;
+    }
+}
+
+// Planar float to interleaved bytes; integer encodings are rounded and clipped.
+inline void encodeFrames(const float *const *planar, VXFissionSampleEncoding encoding, int channels, size_t frames, uint8_t *dst) {
+    using namespace vxfission_audio_stream;
+    switch (encoding) {
+        case VXFissionSampleEncoding::pcm16:
+            interleave(planar, channels, 2, frames, dst, [](float x, uint8_t *p) {
+                const int32_t v = quantize(x, 32768.0);
+                p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8);
+            });
+            break;
+        case VXFissionSampleEncoding::pcm24:
+            interleave(planar, channels, 3, frames, dst, [](float x, uint8_t *p) {
+                const int32_t v = quantize(x, 8388608.0);
+                p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16);
+            });
+            break;
+        case VXFissionSampleEncoding::pcm32:
+            interleave(planar, channels, 4, frames, dst, [](float x, uint8_t *p) {
+                const int32_t v = quantize(x, 2147483648.0);
+                p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+            });
+            break;
+        case VXFissionSampleEncoding::float32:
+            interleave(planar, channels, 4, frames, dst, [](float x, uint8_t *p) { std::memcpy(p, &x, sizeof(float)); });
+            break;
+    }
+}
+
+// MARK: - Output
+
+class VXFissionWavStreamWriter {
+public:
+    static constexpr size_t kWriteBytes  = 1u << 20;  // every write but the last
+    static constexpr size_t kAlignment   = 4096;
+    static constexpr size_t kHeaderBytes = 4096;      // audio starts on the second page
+
+    VXFissionWavStreamWriter() = default;
+    VXFissionWavStreamWriter(const VXFissionWavStreamWriter &) = delete;
+    VXFissionWavStreamWriter &operator=(const VXFissionWavStreamWriter &) = delete;
+    ~VXFissionWavStreamWriter() {
+        if (mOwnsFd && mFd >= 0) ::close(mFd);
+        std::free(mBuffer);
+    }
+
+    // "-" writes stdout. expectedFrames goes in the header up front, which
+    // is all an output that cannot seek will get; kUnknownFrames writes the
+    // streaming sizes (0xFFFFFFFF).
+    bool open(const std::string &path, const VXFissionStreamFormat &format, std::string &error) {
+        mFormat = format;
+        mFd = (path == "-") ? STDOUT_FILENO : ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (mFd < 0) { error = "cannot create " + path; return false; }
+        mOwnsFd = (path != "-");
+
+        struct stat info {};
+        mSeekable = ::fstat(mFd, &info) == 0 && S_ISREG(info.st_mode);
+        if (::posix_memalign(reinterpret_cast<void **>(&mBuffer), kAlignment, kWriteBytes) != 0) {
+            mBuffer = nullptr;
+            error = "out of memory";
+            return false;
+        }
+        writeHeader(mBuffer, format.frames);
+        mFill = kHeaderBytes;
+        return true;
+    }
+
+    // Planar float, `frames` per channel. `scratch` holds the interleaved
+    // bytes on the way (frames × frameBytes()).
+    void append(const float *const *planar, size_t frames, std::vector<uint8_t> &scratch) {
+        const size_t bytes = frames * (size_t)mFormat.frameBytes();
+        if (scratch.size() < bytes) scratch.resize(bytes);
+        encodeFrames(planar, mFormat.encoding, mFormat.channels, frames, scratch.data());
+        for (size_t done = 0; done < bytes; ) {
+            const size_t n = std::min(bytes - done, kWriteBytes - mFill);
+            std::memcpy(mBuffer + mFill, scratch.data() + done, n);
+            mFill += n;
+            done  += n;
+            if (mFill == kWriteBytes) flush();
+        }
+        mFrames += frames;
+    }
+
+    // Writes what is buffered and, where the output can seek, the real sizes.
+    bool finish(std::string &error) {
+        flush();
+        if (mOk && mSeekable) {
+            writeHeader(mBuffer, mFrames);
+            mOk = ::pwrite(mFd, mBuffer, kHeaderBytes, 0) == (ssize_t)kHeaderBytes;
+        }
+        if (mOwnsFd && mFd >= 0 && ::close(mFd) != 0) mOk = false;
+        mFd = -1;
+        if (!mOk) error = "write failed";
+        return mOk;
+    }
+
+    uint64_t bytesWritten() const { return mWritten; }
+    uint64_t framesWritten() const { return mFrames; }
+
+private:
+    void flush() {
+        for (size_t done = 0; mOk && done < mFill; ) {
+            ssize_t n = ::write(mFd, mBuffer + done, mFill - done);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) { mOk = false; break; }
+            done += (size_t)n;
+        }
+        mWritten += mFill;
+        mFill = 0;
+    }
+
+    /*
+     RIFF/RF64 header padded to kHeaderBytes:
+       0     RIFF or RF64, size, WAVE
+       12    ds64 (RF64) or JUNK holding its place, 28 bytes
+       48    fmt, 16 bytes
+       72    JUNK to the end of the page
+       4088  data, size
+     */
+    void writeHeader(uint8_t *h, uint64_t frames) const {
+        auto le16 = [&](size_t at, uint32_t v) { h[at] = (uint8_t)v; h[at + 1] = (uint8_t)(v >> 8); };
+        auto le32 = [&](size_t at, uint32_t v) { le16(at, v & 0xFFFF); le16(at + 2, v >> 16); };
+        auto le64 = [&](size_t at, uint64_t v) { le32(at, (uint32_t)v); le32(at + 4, (uint32_t)(v >> 32)); };
+
+        const uint32_t frameBytes = (uint32_t)mFormat.frameBytes();
+        const bool     unknown    = (frames == VXFissionStreamFormat::kUnknownFrames);
+        const uint64_t dataBytes  = unknown ? 0 : frames * frameBytes;
+        const uint64_t riffBytes  = kHeaderBytes - 8 + dataBytes;
+        const bool     rf64       = !unknown && riffBytes > 0xFFFFFFFFull;
+
+        std::memset(h, 0, kHeaderBytes);
+        std::memcpy(h, rf64 ? "RF64" : "RIFF", 4);
+        le32(4, (rf64 || unknown) ? 0xFFFFFFFFu : (uint32_t)riffBytes);
+        std::memcpy(h + 8, "WAVE", 4);
+
+        std::memcpy(h + 12, rf64 ? "ds64" : "JUNK", 4);
+        le32(16, 28);
+        if (rf64) {
+            le64(20, riffBytes);
+            le64(28, dataBytes);
+            le64(36, frames);
+        }
+
+        const bool isFloat = (mFormat.encoding == VXFissionSampleEncoding::float32);
+        std::memcpy(h + 48, "fmt ", 4);
+        le32(52, 16);
+        le16(56, isFloat ? 3 : 1);
+        le16(58, (uint32_t)mFormat.channels);
+        le32(60, (uint32_t)mFormat.sampleRate);
+        le32(64, (uint32_t)mFormat.sampleRate * frameBytes);
+        le16(68, frameBytes);
+        le16(70, (uint32_t)VXFissionStreamFormat::bytesPerSample(mFormat.encoding) * 8);
+
+        std::memcpy(h + 72, "JUNK", 4);
+        le32(76, (uint32_t)(kHeaderBytes - 8 - 80));
+
+        std::memcpy(h + kHeaderBytes - 8, "data", 4);
+        le32(kHeaderBytes - 4, (rf64 || unknown) ? 0xFFFFFFFFu : (uint32_t)dataBytes);
+    }
+
+    VXFissionStreamFormat mFormat;
+    int      mFd       = -1;
+    bool     mOwnsFd   = false;
+    bool     mSeekable = false;
+    bool     mOk       = true;
+    uint8_t *mBuffer   = nullptr;  // kWriteBytes, kAlignment-aligned
+    size_t   mFill     = 0;
+    uint64_t mWritten  = 0;
+    uint64_t mFrames   = 0;
+};
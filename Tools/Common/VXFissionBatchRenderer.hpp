@@ -0,0 +1,109 @@
+//
+//  VXFissionBatchRenderer.hpp
+//  VXFission Tools
+//
+//  Renders many independent stems through the effect in one process. Each
+//  stem is a voice with its own core (its own knob, oversampling and delay
+//  lines); the voices are jobs on a work-stealing VXFissionThreadPool, so a
+//  batch scales with cores instead of with host processes. A voice renders
+//  start to finish on one worker, which keeps its state in that core's caches.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include "VXFissionExtensionDSPCore.hpp"
+#include "VXFissionAudioFile.hpp"
+#include "VXFissionThreadPool.hpp"
+
+// One stem: where it comes from, where it goes, and how the effect is set.
+struct VXFissionBatchVoice {
+    const VXFissionAudioData *input  = nullptr;
+    VXFissionAudioData       *output = nullptr;  // resized by render()
+    float delayTimeMs  = 25.0f;
+    int   oversampling = 1;
+};
+
+struct VXFissionBatchStats {
+    double wallSeconds  = 0.0;
+    double audioSeconds = 0.0;  // summed over every voice
+    size_t steals       = 0;
+
+    // Seconds of audio rendered per second of wall time, all voices together.
+    double realtimeFactor() const { return wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0; }
+};
+
+class VXFissionBatchRenderer {
+public:
+    VXFissionBatchRenderer(int threads, uint32_t blockSize)
+    : mPool(threads), mBlockSize(std::max<uint32_t>(1, blockSize)) {}
+
+    int threadCount() const { return mPool.threadCount(); }
+
+    // Renders every voice, blocking until all are done. Cores persist between
+    // calls, so a second batch of the same shape allocates nothing.
+    VXFissionBatchStats render(std::span<VXFissionBatchVoice> voices) {
+        while (mCores.size() < voices.size()) mCores.push_back(std::make_unique<VXFissionExtensionDSPCore>());
+
+        // Longest first: each worker's deque starts with its biggest stems, so
+        // what is left to steal near the end is short.
+        std::vector<size_t> order(voices.size());
+        std::iota(order.begin(), order.end(), size_t { 0 });
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return voices[a].input->frameCount() > voices[b].input->frameCount();
+        });
+
+        VXFissionBatchStats stats;
+        for (const VXFissionBatchVoice &voice : voices) {
+            stats.audioSeconds += (double)voice.input->frameCount() / voice.input->sampleRate;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        mPool.run(order.size(), [&](size_t job) {
+            const size_t v = order[job];
+            renderVoice(*mCores[v], voices[v]);
+        });
+        auto stop = std::chrono::steady_clock::now();
+
+        stats.wallSeconds = std::chrono::duration<double>(stop - start).count();
+        stats.steals      = mPool.steals();
+        return stats;
+    }
+
+private:
+    void renderVoice(VXFissionExtensionDSPCore &core, VXFissionBatchVoice &voice) {
+        const VXFissionAudioData &input = *voice.input;
+        const int    numIn  = std::min(input.channelCount(), VXFissionChannelMap::kMaxChannels);
+        const int    numOut = std::max(2, numIn);
+        const size_t frames = input.frameCount();
+
+        core.setMaximumFramesToRender(mBlockSize);
+        core.setOversampling(voice.oversampling);
+        core.initialize(numIn, numOut, input.sampleRate);
+        core.setDelayTime(voice.delayTimeMs);
+
+        VXFissionAudioData &output = *voice.output;
+        output.sampleRate = input.sampleRate;
+        output.channels.resize(numOut);
+        for (std::vector<float> &channel : output.channels) channel.resize(frames);
+
+        const float *in[VXFissionChannelMap::kMaxChannels];
+        float       *out[VXFissionChannelMap::kMaxChannels];
+        for (size_t pos = 0; pos < frames; pos += mBlockSize) {
+            uint32_t n = (uint32_t)std::min<size_t>(mBlockSize, frames - pos);
+            for (int ch = 0; ch < numIn;  ++ch) in[ch]  = input.channels[ch].data() + pos;
+            for (int ch = 0; ch < numOut; ++ch) out[ch] = output.channels[ch].data() + pos;
+            core.process(std::span<const float *>(in, numIn), std::span<float *>(out, numOut), n);
+        }
+    }
+
+    VXFissionThreadPool mPool;
+    uint32_t            mBlockSize;
+    std::vector<std::unique_ptr<VXFissionExtensionDSPCore>> mCores;  // one per voice, each its own allocation
+};
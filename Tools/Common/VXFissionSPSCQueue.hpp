@@ -0,0 +1,58 @@
+//
+//  VXFissionSPSCQueue.hpp
+//  VXFission Tools
+//
+//  Bounded single-producer, single-consumer queue for the streaming tools'
+//  pipeline stages. Each side owns one index and only reads the other's, so
+//  a push or pop is a load, a copy and a release store: no locks and no
+//  read-modify-write. A side that finds the queue full (or empty) sleeps on
+//  the other side's index with C++20 atomic wait, which is a futex / ulock
+//  where the platform has one, and is woken by the next pop (or push).
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+template <typename T>
+class VXFissionSPSCQueue {
+public:
+    // Holds up to `capacity` items.
+    explicit VXFissionSPSCQueue(size_t capacity) : mItems(capacity + 1) {}
+
+    VXFissionSPSCQueue(const VXFissionSPSCQueue &) = delete;
+    VXFissionSPSCQueue &operator=(const VXFissionSPSCQueue &) = delete;
+
+    // Producer. Blocks while full.
+    void push(const T &item) {
+        const size_t tail = mTail.load(std::memory_order_relaxed);
+        const size_t next = advance(tail);
+        for (size_t head = mHead.load(std::memory_order_acquire); head == next; head = mHead.load(std::memory_order_acquire)) {
+            mHead.wait(head, std::memory_order_acquire);
+        }
+        mItems[tail] = item;
+        mTail.store(next, std::memory_order_release);
+        mTail.notify_one();
+    }
+
+    // Consumer. Blocks while empty.
+    T pop() {
+        const size_t head = mHead.load(std::memory_order_relaxed);
+        for (size_t tail = mTail.load(std::memory_order_acquire); tail == head; tail = mTail.load(std::memory_order_acquire)) {
+            mTail.wait(tail, std::memory_order_acquire);
+        }
+        T item = mItems[head];
+        mHead.store(advance(head), std::memory_order_release);
+        mHead.notify_one();
+        return item;
+    }
+
+private:
+    size_t advance(size_t index) const { return (index + 1 == mItems.size()) ? 0 : index + 1; }
+
+    std::vector<T> mItems;  // one slot always empty, so full and empty differ
+    alignas(64) std::atomic<size_t> mHead { 0 };  // next to pop; written by the consumer
+    alignas(64) std::atomic<size_t> mTail { 0 };  // next to fill; written by the producer
+};
@@ -0,0 +1,258 @@
+//
+//  VXFissionSegmentedRenderer.hpp
+//  VXFission Tools
+//
+//  Renders one long file on every core. The effect is serial — rings, reverb,
+//  compressor envelope and LFO all carry from frame to frame — so the file is
+//  cut into segments and each segment's core is brought to the state a serial
+//  render would have at its first frame. Two ways:
+//
+//  - Warmed: the core seeks its LFO to the segment's start and renders a
+//    pre-roll of the preceding audio, long enough for every carried state to
+//    converge (preRollSeconds()). Each segment also renders a few ms past its
+//    end, crossfaded into the next one's start, so what difference remains
+//    at a seam is spread out rather than stepped. Matches a serial render to
+//    within the tolerance the pre-roll was sized for.
+//  - Checkpointed: renderSerial() can save the core's state every so often;
+//    given those checkpoints each segment restores one and renders exactly
+//    what the serial render did, with no pre-roll.
+//
+//  Segments are jobs on a work-stealing VXFissionThreadPool.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <span>
+#include <vector>
+
+#include "VXFissionExtensionDSPCore.hpp"
+#include "VXFissionAudioFile.hpp"
+#include "VXFissionThreadPool.hpp"
+
+struct VXFissionSegmentSettings {
+    float    delayTimeMs  = 25.0f;
+    int      oversampling = 1;
+    uint32_t blockSize    = 512;
+    double   tolerance    = 1e-4;  // warmed renders: carried state left at the seams, relative (−80 dB)
+};
+
+// A core's saved state (VXFissionExtensionDSPCore::saveState()) at a frame of a render.
+struct VXFissionCheckpoint {
+    size_t frame = 0;
+    std::vector<uint8_t> state;
+};
+
+struct VXFissionSegmentStats {
+    double wallSeconds    = 0.0;
+    double audioSeconds   = 0.0;
+    double preRollSeconds = 0.0;  // summed over every segment: the price of warming
+    size_t segments       = 0;
+    bool   ok             = true; // false if a checkpoint did not restore
+
+    double realtimeFactor() const { return wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0; }
+};
+
+class VXFissionSegmentedRenderer {
+public:
+    static constexpr double kMaxSegmentSeconds = 60.0;   // more segments than threads past this
+    static constexpr double kCrossfadeSeconds  = 0.010;  // seam crossfade, warmed renders
+
+    VXFissionSegmentedRenderer(int threads, const VXFissionSegmentSettings &settings)
+    : mPool(threads), mSettings(settings) {
+        mSettings.blockSize = std::max<uint32_t>(1, mSettings.blockSize);
+    }
+
+    int threadCount() const { return mPool.threadCount(); }
+
+    /*
+     Pre-roll after which state carried over from before a segment has
+     decayed to `tolerance` of its level at the output:
+     - Haas ring: holds 50 ms, then forgets.
+     - Compressor: an envelope difference decays at the 120 ms release.
+     - Reverb: a comb loses kFeedback per trip round its loop, and the tail
+       reaches the wet bus 3 % down, so the longest comb has to turn over
+       until kFeedback^trips × 0.03 ≤ tolerance. This is the long one
+       (≈ 3.4 s at 1e-4).
+     The chorus LFO does not decay, so seek() sets it instead.
+     */
+    static double preRollSeconds(double tolerance) {
+        const double haas        = 0.050;
+        const double compressor  = OutputCompressor::kReleaseSeconds * std::log(1.0 / tolerance);
+        const double longestComb = (FreeverbTuning::kCombMs[FreeverbTuning::kCombsPerSide - 1]
+                                    + FreeverbTuning::kStereoSpreadMs) / 1000.0;
+        const double trips       = std::log(tolerance / 0.03) / std::log((double)FreeverbTuning::kFeedback);
+        return std::max({ haas, compressor, longestComb * std::max(0.0, trips) });
+    }
+
+    // One core start to finish, on the calling thread. With checkpointSeconds
+    // > 0, the state is saved every that many seconds (rounded to blocks).
+    VXFissionSegmentStats renderSerial(const VXFissionAudioData &input, VXFissionAudioData &output,
+                                       double checkpointSeconds = 0.0,
+                                       std::vector<VXFissionCheckpoint> *checkpoints = nullptr) {
+        prepareOutput(input, output);
+        const size_t frames = input.frameCount();
+        const size_t every  = (checkpointSeconds > 0.0 && checkpoints) ? roundToBlocks(checkpointSeconds * input.sampleRate) : 0;
+        if (checkpoints) checkpoints->clear();
+
+        auto start = std::chrono::steady_clock::now();
+        VXFissionExtensionDSPCore core;
+        prepareCore(core, input);
+        for (size_t pos = 0; pos < frames; ) {
+            const size_t next = (every > 0) ? std::min(frames, pos + every) : frames;
+            renderRange(core, input, output, pos, next);
+            pos = next;
+            if (every > 0 && pos < frames) checkpoints->push_back({ pos, core.saveState() });
+        }
+        auto stop = std::chrono::steady_clock::now();
+
+        VXFissionSegmentStats stats;
+        stats.wallSeconds  = std::chrono::duration<double>(stop - start).count();
+        stats.audioSeconds = (double)frames / input.sampleRate;
+        stats.segments     = 1;
+        return stats;
+    }
+
+    // Warmed: pre-rolled segments, crossfaded at the seams.
+    VXFissionSegmentStats render(const VXFissionAudioData &input, VXFissionAudioData &output) {
+        prepareOutput(input, output);
+        const size_t frames      = input.frameCount();
+        const size_t preRoll     = roundToBlocks(preRollSeconds(mSettings.tolerance) * input.sampleRate);
+        const size_t fade        = (size_t)std::max(1.0, kCrossfadeSeconds * input.sampleRate);
+        const size_t length      = segmentLength(frames, input.sampleRate, preRoll);
+        const size_t segments    = (frames + length - 1) / length;
+        const int    numOut      = (int)output.channels.size();
+
+        // Each segment's run past its end, fade frames per channel.
+        std::vector<std::vector<float>> overrun(segments, std::vector<float>(fade * numOut));
+
+        VXFissionSegmentStats stats;
+        auto start = std::chrono::steady_clock::now();
+        mPool.run(segments, [&](size_t k) {
+            const size_t first = k * length;
+            const size_t last  = std::min(frames, first + length);
+            const size_t warm  = first - std::min(first, preRoll);
+
+            VXFissionExtensionDSPCore core;
+            prepareCore(core, input);
+            core.seek(warm);
+            VXFissionAudioData discard;
+            discard.channels.assign(numOut, std::vector<float>(first - warm));
+            renderRange(core, input, discard, warm, first, warm);
+            renderRange(core, input, output, first, last);
+            if (last < frames) {
+                VXFissionAudioData tail;
+                tail.channels.assign(numOut, std::vector<float>(fade));
+                renderRange(core, input, tail, last, std::min(frames, last + fade), last);
+                for (int c = 0; c < numOut; ++c) std::copy(tail.channels[c].begin(), tail.channels[c].end(), overrun[k].begin() + c * fade);
+            }
+        });
+        // Seams: from the segment that ran on (warm since its own start) to the
+        // one that starts there (warm since its pre-roll), linearly, as the two
+        // differ only by the tolerance.
+        for (size_t k = 0; k + 1 < segments; ++k) {
+            const size_t seam = (k + 1) * length;
+            const size_t n    = std::min(fade, frames - seam);
+            for (int c = 0; c < numOut; ++c) {
+                float *out = output.channels[c].data() + seam;
+                const float *ran = overrun[k].data() + c * fade;
+                for (size_t f = 0; f < n; ++f) {
+                    const float w = ((float)f + 0.5f) / (float)n;
+                    out[f] = ran[f] + w * (out[f] - ran[f]);
+                }
+            }
+        }
+        auto stop = std::chrono::steady_clock::now();
+
+        stats.wallSeconds    = std::chrono::duration<double>(stop - start).count();
+        stats.audioSeconds   = (double)frames / input.sampleRate;
+        stats.segments       = segments;
+        for (size_t k = 1; k < segments; ++k) stats.preRollSeconds += (double)std::min(k * length, preRoll) / input.sampleRate;
+        return stats;
+    }
+
+    // Checkpointed: one segment per checkpoint interval, each resumed from its
+    // checkpoint (in frame order, as renderSerial() left them, for the same
+    // input and settings). Bit-identical to renderSerial().
+    VXFissionSegmentStats render(const VXFissionAudioData &input, VXFissionAudioData &output,
+                                 std::span<const VXFissionCheckpoint> checkpoints) {
+        prepareOutput(input, output);
+        const size_t frames   = input.frameCount();
+        const size_t segments = checkpoints.size() + 1;
+        std::vector<char> restored(segments, 1);
+
+        VXFissionSegmentStats stats;
+        auto start = std::chrono::steady_clock::now();
+        mPool.run(segments, [&](size_t k) {
+            const size_t first = (k == 0) ? 0 : checkpoints[k - 1].frame;
+            const size_t last  = (k < checkpoints.size()) ? checkpoints[k].frame : frames;
+            VXFissionExtensionDSPCore core;
+            prepareCore(core, input);
+            if (k > 0 && !core.restoreState(checkpoints[k - 1].state)) {
+                restored[k] = 0;
+                return;
+            }
+            renderRange(core, input, output, first, last);
+        });
+        auto stop = std::chrono::steady_clock::now();
+
+        stats.wallSeconds  = std::chrono::duration<double>(stop - start).count();
+        stats.audioSeconds = (double)frames / input.sampleRate;
+        stats.segments     = segments;
+        stats.ok           = std::all_of(restored.begin(), restored.end(), [](char ok) { return ok != 0; });
+        return stats;
+    }
+
+private:
+    size_t roundToBlocks(double frames) const {
+        const size_t block = mSettings.blockSize;
+        return std::max<size_t>(1, ((size_t)std::ceil(frames) + block - 1) / block) * block;
+    }
+
+    // Whole blocks, as many segments as threads (a multiple of them for long
+    // files, so every worker gets the same share), none shorter than the
+    // pre-roll it costs. One thread renders the file as one segment.
+    size_t segmentLength(size_t frames, double sampleRate, size_t preRoll) const {
+        const size_t threads  = (size_t)threadCount();
+        if (threads == 1) return roundToBlocks((double)frames);
+        size_t segments = (size_t)std::ceil((double)frames / (kMaxSegmentSeconds * sampleRate));
+        segments = std::max<size_t>(1, (segments + threads - 1) / threads) * threads;
+        segments = std::clamp<size_t>(frames / preRoll, 1, segments);
+        return roundToBlocks((double)((frames + segments - 1) / segments));
+    }
+
+    void prepareOutput(const VXFissionAudioData &input, VXFissionAudioData &output) const {
+        const int numOut = std::max(2, std::min(input.channelCount(), VXFissionChannelMap::kMaxChannels));
+        output.sampleRate = input.sampleRate;
+        output.channels.resize(numOut);
+        for (std::vector<float> &channel : output.channels) channel.assign(input.frameCount(), 0.0f);
+    }
+
+    void prepareCore(VXFissionExtensionDSPCore &core, const VXFissionAudioData &input) const {
+        const int numIn = std::min(input.channelCount(), VXFissionChannelMap::kMaxChannels);
+        core.setMaximumFramesToRender(mSettings.blockSize);
+        core.setOversampling(mSettings.oversampling);
+        core.initialize(numIn, std::max(2, numIn), input.sampleRate);
+        core.setDelayTime(mSettings.delayTimeMs);
+    }
+
+    // Input frames [first, last) in blocks, into output from frame first - outputOrigin.
+    void renderRange(VXFissionExtensionDSPCore &core, const VXFissionAudioData &input, VXFissionAudioData &output,
+                     size_t first, size_t last, size_t outputOrigin = 0) const {
+        const int numIn  = std::min(input.channelCount(), VXFissionChannelMap::kMaxChannels);
+        const int numOut = (int)output.channels.size();
+        const float *in[VXFissionChannelMap::kMaxChannels];
+        float       *out[VXFissionChannelMap::kMaxChannels];
+        for (size_t pos = first; pos < last; pos += mSettings.blockSize) {
+            const uint32_t n = (uint32_t)std::min<size_t>(mSettings.blockSize, last - pos);
+            for (int ch = 0; ch < numIn;  ++ch) in[ch]  = input.channels[ch].data() + pos;
+            for (int ch = 0; ch < numOut; ++ch) out[ch] = output.channels[ch].data() + (pos - outputOrigin);
+            core.process(std::span<const float *>(in, numIn), std::span<float *>(out, numOut), n);
+        }
+    }
+
+    VXFissionThreadPool      mPool;
+    VXFissionSegmentSettings mSettings;
+};
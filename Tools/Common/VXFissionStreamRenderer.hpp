@@ -0,0 +1,202 @@
+//
+//  VXFissionStreamRenderer.hpp
+//  VXFission Tools
+//
+//  Renders a file of any length through one core in constant memory, as a
+//  three-stage pipeline on three threads:
+//
+//    read + decode  →  process  →  encode + write
+//
+//  A fixed set of slots, each one chunk of planar input and output, goes
+//  round the stages on bounded VXFissionSPSCQueues (the writer hands the slot
+//  back to the reader). While the core processes one chunk the reader is
+//  paging in and decoding the next and the writer is writing the previous
+//  one, so the disk and the DSP are busy at the same time, and nothing is
+//  allocated once the render has started. Each chunk is processed in
+//  blockSize calls, so the output is bit-identical to a render of the whole
+//  file held in memory with that block size.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "VXFissionExtensionDSPCore.hpp"
+#include "VXFissionAudioStream.hpp"
+#include "VXFissionSPSCQueue.hpp"
+
+struct VXFissionStreamSettings {
+    float    delayTimeMs  = 25.0f;
+    int      oversampling = 1;
+    uint32_t blockSize    = 512;    // frames per process() call
+    uint32_t chunkFrames  = 8192;   // frames per pipeline slot, rounded up to whole blocks
+    uint32_t slots        = 8;      // chunks in flight across the three stages
+};
+
+struct VXFissionStreamStats {
+    double   wallSeconds  = 0.0;
+    double   audioSeconds = 0.0;
+    uint64_t bytesRead    = 0;
+    uint64_t bytesWritten = 0;
+    double   busySeconds[3] {};    // read, process, write: time not spent waiting on a queue
+    bool     ok           = true;
+    std::string error;
+
+    double realtimeFactor() const { return wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0; }
+    double readMBps() const  { return wallSeconds > 0.0 ? (double)bytesRead / 1e6 / wallSeconds : 0.0; }
+    double writeMBps() const { return wallSeconds > 0.0 ? (double)bytesWritten / 1e6 / wallSeconds : 0.0; }
+    double busyShare(int stage) const { return wallSeconds > 0.0 ? busySeconds[stage] / wallSeconds : 0.0; }
+};
+
+class VXFissionStreamRenderer {
+public:
+    enum Stage { kRead, kProcess, kWrite };
+
+    explicit VXFissionStreamRenderer(const VXFissionStreamSettings &settings) : mSettings(settings) {
+        mSettings.blockSize   = std::max<uint32_t>(1, mSettings.blockSize);
+        mSettings.chunkFrames = std::max(mSettings.chunkFrames, mSettings.blockSize);
+        mSettings.chunkFrames = (mSettings.chunkFrames + mSettings.blockSize - 1) / mSettings.blockSize * mSettings.blockSize;
+        mSettings.slots       = std::max<uint32_t>(2, mSettings.slots);
+    }
+
+    // Output channels for an input: at least stereo, as in the other tools.
+    static int outputChannels(int inputChannels) { return std::max(2, inputChannels); }
+
+    /*
+     Reads `format` audio from `source` (positioned at the first audio byte,
+     as readStreamHeader() leaves it) to the end, and appends the render to
+     `writer` (opened with outputChannels() channels). Calls `progress` with
+     the frames written so far after each chunk, on the writing thread.
+     */
+    template <typename Progress>
+    VXFissionStreamStats render(VXFissionByteSource &source, const VXFissionStreamFormat &format,
+                                VXFissionWavStreamWriter &writer, Progress progress) {
+        const int numIn  = format.channels;
+        const int numOut = outputChannels(numIn);
+        const size_t chunk = mSettings.chunkFrames;
+
+        std::vector<Slot> slots(mSettings.slots);
+        for (Slot &slot : slots) {
+            slot.input.assign((size_t)numIn * chunk, 0.0f);
+            slot.output.assign((size_t)numOut * chunk, 0.0f);
+        }
+        VXFissionSPSCQueue<Slot *> toProcess(slots.size()), toWrite(slots.size()), toRead(slots.size());
+        for (Slot &slot : slots) toRead.push(&slot);
+
+        VXFissionExtensionDSPCore core;
+        core.setMaximumFramesToRender(mSettings.blockSize);
+        core.setOversampling(mSettings.oversampling);
+        core.initialize(numIn, numOut, format.sampleRate);
+        core.setDelayTime(mSettings.delayTimeMs);
+
+        VXFissionStreamStats stats;
+        const uint64_t startPosition = source.position();
+        auto start = std::chrono::steady_clock::now();
+
+        // Read: decode the next chunk into a free slot. A slot of no frames
+        // ends the stream for every stage after it.
+        std::thread reader([&] {
+            const size_t frameBytes = (size_t)format.frameBytes();
+            uint64_t left = format.frames;
+            float *planar[VXFissionChannelMap::kMaxChannels];
+            for (;;) {
+                Slot *slot = toRead.pop();
+                Timer busy(stats.busySeconds[kRead]);
+                const size_t want = (size_t)std::min<uint64_t>(chunk, left);
+                std::span<const uint8_t> bytes = source.peek(want * frameBytes);
+                slot->frames = bytes.size() / frameBytes;
+                for (int ch = 0; ch < numIn; ++ch) planar[ch] = slot->input.data() + (size_t)ch * chunk;
+                decodeFrames(bytes.data(), format.encoding, numIn, slot->frames, planar);
+                source.consume(slot->frames * frameBytes);
+                if (left != VXFissionStreamFormat::kUnknownFrames) left -= slot->frames;
+                busy.stop();
+                toProcess.push(slot);
+                if (slot->frames == 0) break;
+            }
+        });
+
+        // Process: the chunk in blockSize calls.
+        std::thread processor([&] {
+            const float *in[VXFissionChannelMap::kMaxChannels];
+            float       *out[VXFissionChannelMap::kMaxChannels];
+            for (;;) {
+                Slot *slot = toProcess.pop();
+                Timer busy(stats.busySeconds[kProcess]);
+                for (size_t pos = 0; pos < slot->frames; pos += mSettings.blockSize) {
+                    const uint32_t n = (uint32_t)std::min<size_t>(mSettings.blockSize, slot->frames - pos);
+                    for (int ch = 0; ch < numIn;  ++ch) in[ch]  = slot->input.data()  + (size_t)ch * chunk + pos;
+                    for (int ch = 0; ch < numOut; ++ch) out[ch] = slot->output.data() + (size_t)ch * chunk + pos;
+                    core.process(std::span<const float *>(in, numIn), std::span<float *>(out, numOut), n);
+                }
+                busy.stop();
+                toWrite.push(slot);
+                if (slot->frames == 0) break;
+            }
+        });
+
+        // Write, on this thread: encode into the writer's buffer and hand the
+        // slot back to the reader.
+        std::vector<uint8_t> scratch((size_t)numOut * chunk * 4);
+        const float *planar[VXFissionChannelMap::kMaxChannels];
+        uint64_t written = 0;
+        for (;;) {
+            Slot *slot = toWrite.pop();
+            if (slot->frames == 0) break;
+            Timer busy(stats.busySeconds[kWrite]);
+            for (int ch = 0; ch < numOut; ++ch) planar[ch] = slot->output.data() + (size_t)ch * chunk;
+            writer.append(planar, slot->frames, scratch);
+            written += slot->frames;
+            busy.stop();
+            toRead.push(slot);
+            progress(written);
+        }
+        reader.join();
+        processor.join();
+
+        {
+            Timer busy(stats.busySeconds[kWrite]);
+            stats.ok = writer.finish(stats.error);
+        }
+        auto stop = std::chrono::steady_clock::now();
+
+        if (source.failed()) {
+            stats.ok    = false;
+            stats.error = "read failed";
+        }
+        stats.wallSeconds  = std::chrono::duration<double>(stop - start).count();
+        stats.audioSeconds = (double)written / format.sampleRate;
+        stats.bytesRead    = source.position() - startPosition;
+        stats.bytesWritten = writer.bytesWritten();
+        return stats;
+    }
+
+private:
+    struct Slot {
+        std::vector<float> input;   // numIn × chunkFrames, channel-major
+        std::vector<float> output;  // numOut × chunkFrames
+        size_t frames = 0;
+    };
+
+    // Adds the time until stop() to a stage's busy total.
+    class Timer {
+    public:
+        explicit Timer(double &total) : mTotal(total), mStart(std::chrono::steady_clock::now()) {}
+        ~Timer() { stop(); }
+        void stop() {
+            if (mStopped) return;
+            mTotal += std::chrono::duration<double>(std::chrono::steady_clock::now() - mStart).count();
+            mStopped = true;
+        }
+    private:
+        double &mTotal;
+        std::chrono::steady_clock::time_point mStart;
+        bool mStopped = false;
+    };
+
+    VXFissionStreamSettings mSettings;
+};
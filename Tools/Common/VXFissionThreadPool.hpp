@@ -0,0 +1,142 @@
+//
+//  VXFissionThreadPool.hpp
+//  VXFission Tools
+//
+//  Work-stealing thread pool for the offline tools. run() deals the job
+//  indices round-robin onto one deque per worker; each worker takes from the
+//  front of its own deque and, once that is empty, steals from the back of
+//  the others'. Long and short jobs therefore balance themselves without a
+//  single shared queue that every worker contends on. Not for the render
+//  thread: it allocates and blocks.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class VXFissionThreadPool {
+public:
+    // 0 threads = one per hardware thread.
+    explicit VXFissionThreadPool(int threads = 0) {
+        if (threads <= 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+        mQueues.reserve(threads);
+        for (int i = 0; i < threads; ++i) mQueues.push_back(std::make_unique<Queue>());
+        for (int i = 0; i < threads; ++i) mWorkers.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    ~VXFissionThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mWake.notify_all();
+        for (std::thread &worker : mWorkers) worker.join();
+    }
+
+    VXFissionThreadPool(const VXFissionThreadPool &) = delete;
+    VXFissionThreadPool &operator=(const VXFissionThreadPool &) = delete;
+
+    int threadCount() const { return (int)mWorkers.size(); }
+
+    // Jobs taken from another worker's deque during the last run().
+    size_t steals() const { return mSteals.load(std::memory_order_relaxed); }
+
+    // Calls job(i) for every i in [0, count) across the workers and returns
+    // once all have finished. Jobs must not call run() on the same pool.
+    void run(size_t count, const std::function<void(size_t)> &job) {
+        if (count == 0) return;
+        mSteals.store(0, std::memory_order_relaxed);
+        // The job is published before any index is queued: a worker still
+        // draining the deques from the previous run() may pick one up.
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mJob       = &job;
+            mRemaining = count;
+            ++mGeneration;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            Queue &queue = *mQueues[i % mQueues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_back(i);
+        }
+        mWake.notify_all();
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDone.wait(lock, [this] { return mRemaining == 0; });
+        mJob = nullptr;
+    }
+
+private:
+    // One deque per worker, each on its own cache lines.
+    struct alignas(64) Queue {
+        std::mutex         mutex;
+        std::deque<size_t> jobs;
+    };
+
+    bool popOwn(int self, size_t &index) {
+        Queue &queue = *mQueues[self];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) return false;
+        index = queue.jobs.front();
+        queue.jobs.pop_front();
+        return true;
+    }
+
+    bool steal(int self, size_t &index) {
+        const int n = (int)mQueues.size();
+        for (int k = 1; k < n; ++k) {
+            Queue &queue = *mQueues[(self + k) % n];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.jobs.empty()) continue;
+            index = queue.jobs.back();
+            queue.jobs.pop_back();
+            mSteals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(int self) {
+        size_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mWake.wait(lock, [&] { return mStopping || mGeneration != seen; });
+                if (mStopping) return;
+                seen = mGeneration;
+            }
+            size_t index = 0;
+            while (popOwn(self, index) || steal(self, index)) {
+                const std::function<void(size_t)> *job;
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    job = mJob;
+                }
+                (*job)(index);
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (--mRemaining == 0) mDone.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> mQueues;
+    std::vector<std::thread>            mWorkers;
+
+    std::mutex              mMutex;       // guards everything below
+    std::condition_variable mWake;        // a run() started, or shutdown
+    std::condition_variable mDone;        // the last job of a run() finished
+    const std::function<void(size_t)> *mJob = nullptr;
+    size_t                  mRemaining  = 0;
+    size_t                  mGeneration = 0;
+    bool                    mStopping   = false;
+    std::atomic<size_t>     mSteals { 0 };
+};
@@ -23,10 +23,11 @@ public class VXFissionExtensionAudioUnit: AUAudioUnit, @unchecked Sendable
 		let stereoFormat = AVAudioFormat(standardFormatWithSampleRate: 44_100, channels: 2)!
 		try super.init(componentDescription: componentDescription, options: options)
 		outputBus = try AUAudioUnitBus(format: stereoFormat)
-        outputBus?.maximumChannelCount = 2
+        // Up to VXFissionChannelMap::kMaxChannels (9.1.6).
+        outputBus?.maximumChannelCount = Self.maximumChannelCount
 
         // Input defaults to mono so Logic registers this as a Mono→Stereo plugin.
-        inputBus.initialize(monoFormat, 2);
+        inputBus.initialize(monoFormat, Self.maximumChannelCount);
 
         // Create the input and output bus arrays.
         _inputBusses = AUAudioUnitBusArray(audioUnit: self, busType: AUAudioUnitBusType.input, busses: [inputBus.bus!])
@@ -45,10 +46,14 @@ public class VXFissionExtensionAudioUnit: AUAudioUnit, @unchecked Sendable
         return _outputBusses
     }
     
+    // Mono or stereo in to stereo out, plus any count in to the same count out
+    // (surround and immersive layouts, rendered with the default channel map).
     public override var channelCapabilities: [NSNumber]? {
-        return [1, 1, 1, 2, 2, 2] as [NSNumber]
+        return [1, 1, 1, 2, 2, 2, -1, -1] as [NSNumber]
     }
 
+    private static let maximumChannelCount: AUAudioChannelCount = 16
+
     public override var  maximumFramesToRender: AUAudioFrameCount {
         get {
             return kernel.maximumFramesToRender()
@@ -69,7 +74,98 @@ public class VXFissionExtensionAudioUnit: AUAudioUnit, @unchecked Sendable
         }
     }
 	
-    public override var canProcessInPlace: Bool { return false }
+    // Bypass crossfades over 10 ms. With trails on, the delay, chorus and
+    // reverb tails ring out over the dry signal after bypass engages.
+    public var bypassTrails: Bool {
+        get {
+            return kernel.bypassTrails()
+        }
+
+        set {
+            kernel.setBypassTrails(newValue)
+        }
+    }
+
+    // Convolution with a room impulse response in place of the Freeverb
+    // reverb; the synthetic room until one is loaded. Applies when render
+    // resources are next allocated.
+    public var convolutionReverb: Bool {
+        get {
+            return kernel.convolutionReverb()
+        }
+
+        set {
+            kernel.setConvolutionReverb(newValue)
+        }
+    }
+
+    // A stereo (or, without `right`, mono) response at any sample rate; it is
+    // resampled, cut to 10 s and levelled to match the Freeverb reverb.
+    // Applies when render resources are next allocated.
+    public func loadImpulseResponse(left: [Float], right: [Float]? = nil, sampleRate: Double) {
+        let frames = min(left.count, right?.count ?? left.count)
+        left.withUnsafeBufferPointer { l in
+            if let right {
+                right.withUnsafeBufferPointer { r in
+                    kernel.setImpulseResponse(l.baseAddress, r.baseAddress, Int32(frames), sampleRate)
+                }
+            } else {
+                kernel.setImpulseResponse(l.baseAddress, nil, Int32(frames), sampleRate)
+            }
+        }
+    }
+
+    // Hosts switch this on for a bounce, sometimes with render resources
+    // already allocated. The kernel then waits for its convolution tail worker
+    // rather than skipping late tail blocks, and Auto quality renders at
+    // standard without timing, so a bounce at any speed comes out the same
+    // every time.
+    public override var isRenderingOffline: Bool {
+        didSet {
+            kernel.setRenderingOffline(isRenderingOffline)
+        }
+    }
+
+    // The kernel reads each input frame before writing that frame's output, and
+    // the render block pulls input straight into the output buffers.
+    public override var canProcessInPlace: Bool { return true }
+
+    // Oversampling the compressor delays the output; hosts compensate for it.
+    public override var latency: TimeInterval {
+        guard let sampleRate = outputBus?.format.sampleRate, sampleRate > 0 else { return 0 }
+        return TimeInterval(kernel.latencySamples()) / sampleRate
+    }
+
+    // MARK: - Event Coalescing
+    // On by default: delay-time automation is applied at its frame inside one
+    // kernel pass rather than by splitting the render at every event. Turning
+    // it off restores per-event splitting; the output is the same.
+    public var coalescesRenderEvents: Bool {
+        get {
+            return kernel.coalescesEvents()
+        }
+
+        set {
+            kernel.setCoalescesEvents(newValue)
+        }
+    }
+
+    // MARK: - Metering
+    // Output levels since the previous call; safe to poll from the UI at display rate.
+    public func readMeters() -> VXFissionMeterSnapshot {
+        return kernel.readMeters()
+    }
+
+    // MARK: - Profiling
+    // Per-stage render timings (p50/p99/max) and deadline misses as JSON. Only
+    // populated when the extension is built with VXFISSION_PROFILING=1.
+    public func profileJSON() -> String {
+        return String(kernel.profileJSON())
+    }
+
+    public func resetProfile() {
+        kernel.resetProfile()
+    }
 
     // MARK: - Rendering
     public override var internalRenderBlock: AUInternalRenderBlock {
@@ -82,8 +178,11 @@ public class VXFissionExtensionAudioUnit: AUAudioUnit, @unchecked Sendable
         let inputChannelCount = self.inputBusses[0].format.channelCount
         let outputChannelCount = self.outputBusses[0].format.channelCount
 		
-        guard inputChannelCount >= 1, inputChannelCount <= 2,
-              outputChannelCount >= 1, outputChannelCount <= 2 else {
+        // A mono input is upmixed to every output; beyond stereo the counts match.
+        guard outputChannelCount >= 1, outputChannelCount <= Self.maximumChannelCount,
+              inputChannelCount >= 1,
+              inputChannelCount == 1 || inputChannelCount == outputChannelCount
+                  || (inputChannelCount <= 2 && outputChannelCount <= 2) else {
             setRenderResourcesAllocated(false)
             throw NSError(domain: NSOSStatusErrorDomain, code: Int(kAudioUnitErr_FailedInitialization), userInfo: nil)
         }
@@ -91,6 +190,10 @@ public class VXFissionExtensionAudioUnit: AUAudioUnit, @unchecked Sendable
         inputBus.allocateRenderResources(self.maximumFramesToRender);
 
 		kernel.setMusicalContextBlock(self.musicalContextBlock)
+        // The convolution tail runs on a worker, which an offline render
+        // waits for (see isRenderingOffline).
+        kernel.setConvolutionTailOnWorker(true)
+        kernel.setRenderingOffline(self.isRenderingOffline)
         kernel.initialize(Int32(inputChannelCount), Int32(outputChannelCount), outputBus!.format.sampleRate)
 
         processHelper?.setChannelCount(inputChannelCount, outputChannelCount, self.maximumFramesToRender)
@@ -122,7 +225,12 @@ public class VXFissionExtensionAudioUnit: AUAudioUnit, @unchecked Sendable
 	private func setupParameterCallbacks() {
 		// implementorValueObserver is called when a parameter changes value.
 		parameterTree?.implementorValueObserver = { [weak self] param, value -> Void in
-            self?.kernel.setParameter(param.address, value)
+            guard let self else { return }
+            // The oversampling factor sets the latency, which hosts observe via KVO.
+            let changesLatency = param.address == VXFissionExtensionParameterAddress.oversampling.rawValue
+            if changesLatency { self.willChangeValue(forKey: "latency") }
+            self.kernel.setParameter(param.address, value)
+            if changesLatency { self.didChangeValue(forKey: "latency") }
 		}
 
 		// implementorValueProvider is called when the value needs to be refreshed.
@@ -135,6 +243,9 @@ public class VXFissionExtensionAudioUnit: AUAudioUnit, @unchecked Sendable
 			guard let value = valuePtr?.pointee else {
 				return "-"
 			}
+			if let strings = param.valueStrings, strings.indices.contains(Int(value)) {
+				return strings[Int(value)]
+			}
 			return NSString.localizedStringWithFormat("%.f", value) as String
 		}
 	}
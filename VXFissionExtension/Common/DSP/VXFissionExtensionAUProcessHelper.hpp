@@ -29,9 +29,9 @@ public:
         mInputBuffers.resize(inputChannelCount);
         mOutputBuffers.resize(outputChannelCount);
         // Pre-allocate per-channel scratch buffers used when the host passes null
-        // output pointers. Each channel needs its own distinct block of memory so
-        // that the kernel never sees two output channels aliasing the same buffer
-        // (which would corrupt the dry/wet split in the delay path).
+        // output pointers; the input is then pulled into them and rendered in
+        // place. Each channel needs its own distinct block of memory so that the
+        // kernel never sees two output channels aliasing the same buffer.
         mScratchOutput.resize(outputChannelCount);
         for (auto& ch : mScratchOutput) {
             ch.assign(maxFrames, 0.0f);
@@ -41,14 +41,21 @@ public:
     /**
      This function handles the event list processing and rendering loop for you.
      Call it inside your internalRenderBlock.
+     Returns true if every rendered segment was pure silence.
+
+     With event coalescing on, every event the kernel can apply at its own
+     frame offset is handed to it up front, and the buffer is split only at
+     the first one it cannot; at 32–64 frame buffers under dense automation
+     that turns dozens of process() calls into one.
      */
-    void processWithEvents(AudioBufferList* inBufferList, AudioBufferList* outBufferList, AudioTimeStamp const *timestamp, AUAudioFrameCount frameCount, AURenderEvent const *events) {
+    bool processWithEvents(AudioBufferList* inBufferList, AudioBufferList* outBufferList, AudioTimeStamp const *timestamp, AUAudioFrameCount frameCount, AURenderEvent const *events) {
 
         AUEventSampleTime now = AUEventSampleTime(timestamp->mSampleTime);
         AUAudioFrameCount framesRemaining = frameCount;
         AURenderEvent const *nextEvent = events; // events is a linked list, at the beginning, the nextEvent is the first event
+        bool outputIsSilent = true;
 
-        auto callProcess = [this] (AudioBufferList* inBufferListPtr, AudioBufferList* outBufferListPtr, AUEventSampleTime now, AUAudioFrameCount frameCount, AUAudioFrameCount const frameOffset) {
+        auto callProcess = [this, &outputIsSilent] (AudioBufferList* inBufferListPtr, AudioBufferList* outBufferListPtr, AUEventSampleTime now, AUAudioFrameCount frameCount, AUAudioFrameCount const frameOffset) {
             for (int channel = 0; channel < (int)inBufferListPtr->mNumberBuffers; ++channel) {
                 mInputBuffers[channel] = (const float*)inBufferListPtr->mBuffers[channel].mData + frameOffset;
             }
@@ -60,14 +67,21 @@ public:
                 std::span<const float*>(mInputBuffers.data(), inBufferListPtr->mNumberBuffers),
                 std::span<float*>(mOutputBuffers.data(), outBufferListPtr->mNumberBuffers),
                 now, frameCount);
+            outputIsSilent &= mKernel.outputIsSilent();
         };
         
+        bool const coalesce = mKernel.coalescesEvents();
+
         while (framesRemaining > 0) {
+            if (coalesce) {
+                nextEvent = scheduleCoalescedEvents(now, nextEvent);
+            }
+
             // If there are no more events, we can process the entire remaining segment and exit.
             if (nextEvent == nullptr) {
                 AUAudioFrameCount const frameOffset = frameCount - framesRemaining;
                 callProcess(inBufferList, outBufferList, now, framesRemaining, frameOffset);
-                return;
+                return outputIsSilent;
             }
 
             // **** start late events late.
@@ -90,6 +104,20 @@ public:
 
             nextEvent = performAllSimultaneousEvents(now, nextEvent);
         }
+        return outputIsSilent;
+    }
+
+    // Queues events in the kernel, offset from `now`, up to the first one it
+    // cannot take; returns that one (or null). Late events land at offset 0.
+    AURenderEvent const * scheduleCoalescedEvents(AUEventSampleTime now, AURenderEvent const *event) {
+        while (event) {
+            auto offset = AUAudioFrameCount(std::max(AUEventSampleTime(0), event->head.eventSampleTime - now));
+            if (!mKernel.scheduleEvent(offset, event)) {
+                break;
+            }
+            event = event->head.next;
+        }
+        return event;
     }
 
     AURenderEvent const * performAllSimultaneousEvents(AUEventSampleTime now, AURenderEvent const *event) {
@@ -119,12 +147,11 @@ public:
 			if (frameCount > mKernel.maximumFramesToRender()) {
 				return kAudioUnitErr_TooManyFramesToProcess;
 			}
-		
-			AUAudioUnitStatus err = mBufferedInputBus.pullInput(&pullFlags, timestamp, frameCount, 0, pullInputBlock);
-		
-			if (err != 0) { return err; }
-		
-			AudioBufferList *inAudioBufferList = mBufferedInputBus.mutableAudioBufferList;
+
+			// Times the whole render, pull included, when profiling is compiled in,
+			// and for the quality governor against this buffer's deadline.
+			mKernel.beginRenderProfile();
+			mKernel.beginRenderTiming();
 		
 			/*
 			 Important:
@@ -135,24 +162,50 @@ public:
 			 The Audio Unit is responsible for preserving the validity of this memory until the next call to render,
 			 or deallocateRenderResources is called.
 		 
-			 If your algorithm cannot process in-place, you will need to preallocate an output buffer
-			 and use it here.
-		 
 			 See the description of the canProcessInPlace property.
 			 */
-		
-			// If passed null output buffer pointers, use our pre-allocated per-channel
-			// scratch buffers. Do NOT alias the input buffers: with a delay effect the
-			// kernel writes output before reading all input, so aliasing causes both
-			// channels to receive the delayed signal instead of one dry / one delayed.
 			AudioBufferList *outAudioBufferList = outputData;
 			if (outAudioBufferList->mBuffers[0].mData == nullptr) {
 				for (UInt32 i = 0; i < outAudioBufferList->mNumberBuffers; ++i) {
 					outAudioBufferList->mBuffers[i].mData = mScratchOutput[i].data();
 				}
 			}
+
+			// The kernel reads every input frame of a sub-block (into its delay
+			// rings and wet scratch) before it writes any output frame, so it
+			// renders in place. Pull the input straight into the output buffers
+			// instead of the input bus's own buffer: one buffer per channel fewer
+			// to touch each cycle. When there are more input channels than output
+			// (stereo in, mono out) they do not fit, and the bus buffer is used.
+			// The upstream unit may still hand back pointers to its own memory;
+			// the kernel then simply renders out of place.
+			AudioBufferList const *pullDestination = nullptr;
+			if (mBufferedInputBus.originalAudioBufferList->mNumberBuffers <= outAudioBufferList->mNumberBuffers) {
+				pullDestination = outAudioBufferList;
+			}
+			AUAudioUnitStatus err = mBufferedInputBus.pullInput(&pullFlags, timestamp, frameCount, 0, pullInputBlock, pullDestination);
+		
+			if (err != 0) {
+				// Close both brackets: the failed pull still spent this buffer's time.
+				mKernel.endRenderTiming(frameCount);
+				mKernel.endRenderProfile(frameCount);
+				return err;
+			}
 		
-			processWithEvents(inAudioBufferList, outAudioBufferList, timestamp, frameCount, realtimeEventListHead);
+			AudioBufferList *inAudioBufferList = mBufferedInputBus.mutableAudioBufferList;
+		
+			bool outputIsSilent = processWithEvents(inAudioBufferList, outAudioBufferList, timestamp, frameCount, realtimeEventListHead);
+			mKernel.publishMeters();
+			mKernel.endRenderTiming(frameCount);
+			mKernel.endRenderProfile(frameCount);
+
+			// The kernel sleeps its wet bus on silent input and reports when it
+			// rendered only zeros; pass that on so downstream can skip work too.
+			if (outputIsSilent) {
+				*actionFlags |= kAudioUnitRenderAction_OutputIsSilence;
+			} else {
+				*actionFlags &= ~kAudioUnitRenderAction_OutputIsSilence;
+			}
 			return noErr;
 		};
 	}
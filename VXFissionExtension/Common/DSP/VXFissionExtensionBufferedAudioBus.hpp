@@ -93,7 +93,8 @@ struct BufferedInputBus : BufferedAudioBus {
                                 AudioTimeStamp const* timestamp,
                                 AUAudioFrameCount frameCount,
                                 NSInteger inputBusNumber,
-                                AURenderPullInputBlock __unsafe_unretained pullInputBlock) {
+                                AURenderPullInputBlock __unsafe_unretained pullInputBlock,
+                                AudioBufferList const* destination = nullptr) {
         if (pullInputBlock == nullptr) {
             return kAudioUnitErr_NoConnection;
         }
@@ -110,25 +111,28 @@ struct BufferedInputBus : BufferedAudioBus {
          See prepareInputBufferList()
          */
 
-        prepareInputBufferList(frameCount);
+        prepareInputBufferList(frameCount, destination);
 
         return pullInputBlock(actionFlags, timestamp, frameCount, inputBusNumber, mutableAudioBufferList);
     }
     
     /*
      prepareInputBufferList populates the mutableAudioBufferList with the data
-     pointers from the originalAudioBufferList.
+     pointers from the originalAudioBufferList, or from destination when given
+     (which must hold at least as many buffers, each of frameCount frames), so
+     the input can be pulled straight into someone else's memory.
      
      The upstream audio unit may overwrite these with its own pointers, so each
      render cycle this function needs to be called to reset them.
      */
-    void prepareInputBufferList(UInt32 frameCount) {
+    void prepareInputBufferList(UInt32 frameCount, AudioBufferList const* destination = nullptr) {
         UInt32 byteSize = std::min(frameCount, maxFrames) * sizeof(float);
         mutableAudioBufferList->mNumberBuffers = originalAudioBufferList->mNumberBuffers;
 
+        AudioBufferList const* source = destination ? destination : originalAudioBufferList;
         for (UInt32 i = 0; i < originalAudioBufferList->mNumberBuffers; ++i) {
             mutableAudioBufferList->mBuffers[i].mNumberChannels = originalAudioBufferList->mBuffers[i].mNumberChannels;
-            mutableAudioBufferList->mBuffers[i].mData = originalAudioBufferList->mBuffers[i].mData;
+            mutableAudioBufferList->mBuffers[i].mData = source->mBuffers[i].mData;
             mutableAudioBufferList->mBuffers[i].mDataByteSize = byteSize;
         }
     }
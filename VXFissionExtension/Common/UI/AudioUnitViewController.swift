@@ -114,7 +114,11 @@ public class AudioUnitViewController: AUViewController, AUAudioUnitFactory {
         guard let observableParameterTree = audioUnit.observableParameterTree else {
             return
         }
-        let content = VXFissionExtensionMainView(parameterTree: observableParameterTree)
+        let extensionUnit = audioUnit as? VXFissionExtensionAudioUnit
+        let content = VXFissionExtensionMainView(
+            parameterTree: observableParameterTree,
+            readMeters: { [weak extensionUnit] in extensionUnit?.readMeters() }
+        )
         let host = HostingController(rootView: content)
         self.addChild(host)
         host.view.frame = self.view.bounds
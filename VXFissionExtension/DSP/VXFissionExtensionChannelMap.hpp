@@ -0,0 +1,58 @@
+//
+//  VXFissionExtensionChannelMap.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <algorithm>
+
+/*
+ VXFissionChannelMap
+ How each output channel takes part in the effect. The Haas weight scales and
+ signs the knob for that channel: the channel is delayed by
+ max(0, delayTime × weight) ms, so −1 is delayed when the knob turns left, +1
+ when it turns right, 0 never (and fractional weights get a shorter offset).
+ The sign also picks which side of the reverb the channel receives: negative
+ the left return, positive the right, 0 both. LFE channels skip the wet bus
+ entirely and only pass through the compressor.
+ */
+struct VXFissionChannelMap {
+    static constexpr int kMaxChannels = 16;  // 9.1.6
+
+    int   count = 2;
+    float haasWeight[kMaxChannels] = { -1.0f, 1.0f };
+    bool  lfe[kMaxChannels]        = {};
+
+    // Defaults by channel count, in Core Audio's usual orders:
+    //   1-2  (L R)             the stereo effect
+    //   3    (L R C)
+    //   4    (L R Ls Rs)       quad
+    //   5    (L R C Ls Rs)
+    //   6+   (L R C LFE …)     5.1, 7.1, 7.1.4, 9.1.6
+    // Channels after the fronts alternate left/right at half weight, so
+    // surrounds and heights follow the fronts' side with a shorter offset.
+    static VXFissionChannelMap defaultFor(int channels) {
+        VXFissionChannelMap map;
+        map.count = std::clamp(channels, 1, kMaxChannels);
+        std::fill(std::begin(map.haasWeight), std::end(map.haasWeight), 0.0f);
+        std::fill(std::begin(map.lfe), std::end(map.lfe), false);
+        map.haasWeight[0] = -1.0f;
+        if (map.count >= 2) map.haasWeight[1] = 1.0f;
+
+        int pairsFrom = 2;
+        if (map.count == 3 || map.count == 5) {
+            pairsFrom = 3;                                   // C
+        } else if (map.count >= 6) {
+            map.lfe[3] = true;                               // C, LFE
+            pairsFrom  = 4;
+        }
+        for (int c = pairsFrom; c + 1 < map.count; c += 2) {
+            map.haasWeight[c]     = -0.5f;
+            map.haasWeight[c + 1] =  0.5f;
+        }
+        return map;
+    }
+};
@@ -0,0 +1,197 @@
+//
+//  VXFissionExtensionCompressor.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "VXFissionExtensionChannelMap.hpp"
+#include "VXFissionExtensionConstexprMath.hpp"
+#include "VXFissionExtensionDenormals.hpp"
+#include "VXFissionExtensionOversampling.hpp"
+
+/*
+ OutputCompressor
+ Feed-forward peak compressor on the mixed output: 2:1 above -6 dBFS, 10 ms
+ attack, 120 ms release, linked across all channels, with its depth scaled
+ per frame by the bus amount. Detection, the serial envelope and the gain
+ are separate passes, so the per-channel work runs along the block.
+
+ The per-sample gain multiplies the signal, so a fast attack spreads energy
+ past Nyquist that folds back as aliasing. With oversampling set to 2x or 4x
+ the mix is upsampled, detected and gain-reduced at the higher rate, then
+ filtered back down. Detecting on the oversampled signal also makes the
+ envelope follow true (inter-sample) peaks rather than sample peaks. The
+ cost is Oversampler::latency() samples of delay.
+ */
+class OutputCompressor {
+public:
+    static constexpr float  kThreshold      = 0.5f;   // -6 dBFS
+    static constexpr double kAttackSeconds  = 0.010;
+    static constexpr double kReleaseSeconds = 0.120;
+
+    // Attack and release coefficients at each working rate (1x, 2x, 4x).
+    struct Envelope {
+        float attack[3]  = {};
+        float release[3] = {};
+    };
+
+    static constexpr int factorIndex(int factor) { return (factor >= 4) ? 2 : (factor >= 2) ? 1 : 0; }
+
+    static constexpr Envelope envelopeFor(double sampleRate) {
+        Envelope envelope;
+        for (int factor : { 1, 2, 4 }) {
+            envelope.attack[factorIndex(factor)]  = vxfission_constexpr::onePoleCoefficient(sampleRate * factor, kAttackSeconds);
+            envelope.release[factorIndex(factor)] = vxfission_constexpr::onePoleCoefficient(sampleRate * factor, kReleaseSeconds);
+        }
+        return envelope;
+    }
+
+    void initialize(double sampleRate, int maxFrames, int channels) {
+        initialize(envelopeFor(sampleRate), maxFrames, channels);
+    }
+
+    // With the envelope precomputed for the rate (see VXFissionRateTuning).
+    void initialize(const Envelope &envelope, int maxFrames, int channels) {
+        mEnvelope   = envelope;
+        mChannels   = channels;
+        mOversamplers.resize(channels);
+        for (Oversampler &oversampler : mOversamplers) oversampler.initialize(maxFrames);
+        const size_t workFrames = (size_t)maxFrames * Oversampler::kMaxFactor;
+        mUpStride = roundUpToCacheLine(workFrames);
+        mUp.assign(mUpStride * channels, 0.0f);
+        mPeak.assign(workFrames, 0.0f);
+        mGain.assign(workFrames, 0.0f);
+        mEnv = 0.0f;
+        setOversampling(mFactor);
+    }
+
+    // 1, 2 or 4. Restarts the resampling filters; the envelope carries over.
+    void setOversampling(int factor) {
+        mFactor = (factor >= 4) ? 4 : (factor >= 2) ? 2 : 1;
+        for (Oversampler &oversampler : mOversamplers) oversampler.setFactor(mFactor);
+        mAttackCoeff  = mEnvelope.attack[factorIndex(mFactor)];
+        mReleaseCoeff = mEnvelope.release[factorIndex(mFactor)];
+    }
+
+    int oversampling() const { return mFactor; }
+    int latency() const      { return Oversampler::latencyFor(mFactor); }
+
+    // Clears the resampling filters, e.g. after the input has been skipped.
+    void resetFilters() {
+        for (Oversampler &oversampler : mOversamplers) oversampler.reset();
+    }
+
+    // Back to rest: filters cleared and no gain reduction.
+    void reset() {
+        resetFilters();
+        mEnv = 0.0f;
+    }
+
+    // The envelope and each channel's resampling filters; the factor is the
+    // owner's to match.
+    void saveState(VXFissionStateWriter &writer) const {
+        writer.value(mEnv);
+        for (const Oversampler &oversampler : mOversamplers) oversampler.saveState(writer);
+    }
+
+    void loadState(VXFissionStateReader &reader) {
+        reader.value(mEnv);
+        for (Oversampler &oversampler : mOversamplers) oversampler.loadState(reader);
+    }
+
+    // Advances the envelope over n base-rate frames of silence in closed form.
+    void decay(int n) {
+        mEnv = flushDenormal(mEnv * std::pow(1.0f - mReleaseCoeff, (float)(n * mFactor)));
+    }
+
+    /*
+     Compresses n frames of the initialised channel count of mix into the
+     first outChannels of out. The detector is linked across every mix
+     channel, whether or not it is written (a mono output still detects the
+     stereo mix). mix[c] and out[c] may alias. Returns the smallest gain
+     applied.
+     */
+    float process(const float *const *mix, float *const *out, int outChannels, const float *busAmount, int n) {
+        if (mFactor == 1) {
+            detect(mix, n);
+            float minGain = computeGain(busAmount, n, 0);
+            for (int c = 0; c < outChannels; ++c) applyGain(mix[c], out[c], n);
+            return minGain;
+        }
+
+        const float *up[VXFissionChannelMap::kMaxChannels];
+        for (int c = 0; c < mChannels; ++c) {
+            mOversamplers[c].upsample(mix[c], n, upsampled(c));
+            up[c] = upsampled(c);
+        }
+        const int m = n * mFactor;
+        detect(up, m);
+        float minGain = computeGain(busAmount, m, mFactor == 4 ? 2 : 1);
+        for (int c = 0; c < outChannels; ++c) {
+            applyGain(upsampled(c), upsampled(c), m);
+            mOversamplers[c].downsample(upsampled(c), n, out[c]);
+        }
+        return minGain;
+    }
+
+private:
+    float *upsampled(int channel) { return mUp.data() + (size_t)channel * mUpStride; }
+
+    // mPeak[f] = max over channels of |x[c][f]|.
+    void detect(const float *const *x, int n) {
+        float *peak = mPeak.data();
+        for (int f = 0; f < n; ++f) peak[f] = std::abs(x[0][f]);
+        for (int c = 1; c < mChannels; ++c) {
+            const float *xc = x[c];
+            for (int f = 0; f < n; ++f) peak[f] = std::max(peak[f], std::abs(xc[f]));
+        }
+    }
+
+    // The serial part: envelope and gain per sample at the working rate.
+    // busAmount is per base-rate frame, so sample j uses busAmount[j >> busShift].
+    float computeGain(const float *busAmount, int n, int busShift) {
+        float minGain = 1.0f;
+        for (int f = 0; f < n; ++f) {
+            float peakIn = mPeak[f];
+            float coeff  = (peakIn > mEnv) ? mAttackCoeff : mReleaseCoeff;
+            mEnv        += coeff * (peakIn - mEnv);
+
+            float targetGain = 1.0f;
+            if (mEnv > kThreshold) {
+                float reduced = kThreshold + (mEnv - kThreshold) * 0.5f; // 2:1
+                targetGain    = reduced / mEnv;
+            }
+            // Blend depth: no effect at centre knob, full at max deflection.
+            float gr = 1.0f - busAmount[f >> busShift] * (1.0f - targetGain);
+            minGain  = std::min(minGain, gr);
+            mGain[f] = gr;
+        }
+        mEnv = flushDenormal(mEnv);
+        return minGain;
+    }
+
+    void applyGain(const float *in, float *out, int n) {
+        const float *gain = mGain.data();
+        for (int f = 0; f < n; ++f) out[f] = in[f] * gain[f];
+    }
+
+    int    mChannels     = 0;
+    int    mFactor       = 1;
+    float  mEnv          = 0.0f;   // envelope at the working rate
+    float  mAttackCoeff  = 0.0f;   // mEnvelope's, at mFactor
+    float  mReleaseCoeff = 0.0f;
+    Envelope mEnvelope;
+
+    std::vector<Oversampler> mOversamplers;  // one per channel
+    std::vector<float> mUp;    // oversampled mix per channel (mUpStride apart), gain-reduced in place
+    size_t mUpStride = 0;
+    std::vector<float> mPeak;  // linked detector input per working-rate sample
+    std::vector<float> mGain;  // gain per working-rate sample
+};
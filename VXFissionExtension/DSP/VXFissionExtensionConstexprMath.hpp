@@ -0,0 +1,82 @@
+//
+//  VXFissionExtensionConstexprMath.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <cmath>
+
+// ─── Compile-time math ───────────────────────────────────────────────────────
+// <cmath> is not constexpr before C++26, so the coefficient tables are built
+// with these. Double precision, accurate to an ulp or two over the ranges the
+// tables use; every result is rounded to float before it reaches the signal
+// path, where they agree with std::exp / std::sin. They are ordinary functions
+// too: a sample rate outside the tables computes its coefficients with the
+// same code at runtime, so no rate gets a slightly different filter.
+
+namespace vxfission_constexpr {
+
+// e^x: halve x until |x| ≤ 1/2, sum the Taylor series, then square back.
+constexpr double exp(double x) {
+    int halvings = 0;
+    while (x > 0.5 || x < -0.5) {
+        x *= 0.5;
+        ++halvings;
+    }
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 24; ++k) {
+        term *= x / k;
+        sum  += term;
+    }
+    while (halvings-- > 0) sum *= sum;
+    return sum;
+}
+
+// sin x for |x| ≤ 2π: reflected onto [-π/2, π/2], then its Taylor series.
+constexpr double sin(double x) {
+    if (x > M_PI)  x -= 2.0 * M_PI;
+    if (x < -M_PI) x += 2.0 * M_PI;
+    if (x > 0.5 * M_PI)  x = M_PI - x;
+    if (x < -0.5 * M_PI) x = -M_PI - x;
+    const double x2 = x * x;
+    double sum = x, term = x;
+    for (int k = 1; k < 14; ++k) {
+        term *= -x2 / ((2.0 * k) * (2.0 * k + 1.0));
+        sum  += term;
+    }
+    return sum;
+}
+
+// √x for x ≥ 0: Newton's iteration from above until it stops decreasing.
+constexpr double sqrt(double x) {
+    if (x <= 0.0) return 0.0;
+    double y = (x > 1.0) ? x : 1.0;
+    for (;;) {
+        const double next = 0.5 * (y + x / y);
+        if (next >= y) return y;
+        y = next;
+    }
+}
+
+// Modified Bessel function of the first kind, order 0 (Kaiser windows).
+constexpr double besselI0(double x) {
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 32; ++k) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum  += term;
+    }
+    return sum;
+}
+
+// 1 - e^(-1 / (sampleRate · seconds)): the per-sample coefficient of a
+// one-pole smoother with that time constant, rounded as the float expression
+// 1.0f - std::exp(-1.0f / (float)(sampleRate * seconds)) would be.
+constexpr float onePoleCoefficient(double sampleRate, double seconds) {
+    const float exponent = -1.0f / (float)(sampleRate * seconds);
+    return 1.0f - (float)exp((double)exponent);
+}
+
+} // namespace vxfission_constexpr
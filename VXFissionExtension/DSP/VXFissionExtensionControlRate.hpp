@@ -0,0 +1,70 @@
+//
+//  VXFissionExtensionControlRate.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <cmath>
+
+// ─── Control-rate building blocks ────────────────────────────────────────────
+// Values that only move at LFO or knob speed are recomputed once per control
+// interval and linearly interpolated across the frames in between.
+
+/*
+ ControlRamp
+ One control-rate value. retarget() is called at each control point with the
+ value due one interval later; at(j) is the interpolated value j frames into
+ the interval, reaching the target exactly at j == interval.
+ */
+struct ControlRamp {
+    float start  = 0.0f;
+    float step   = 0.0f;
+    float target = 0.0f;
+
+    void reset(float value) {
+        start = target = value;
+        step  = 0.0f;
+    }
+    void retarget(float next, float inverseInterval) {
+        start  = target;
+        target = next;
+        step   = (next - start) * inverseInterval;
+    }
+    float at(int j) const { return start + step * (float)j; }
+};
+
+/*
+ QuadratureOscillator
+ Sine LFO as a rotating (cos, sin) pair: each advance() is one complex
+ multiply by the per-step rotation instead of a std::sin call. A first-order
+ renormalisation every step keeps the amplitude from drifting.
+ */
+struct QuadratureOscillator {
+    float cosine = 1.0f;   // cos(phase)
+    float sine   = 0.0f;   // sin(phase)
+    float rotCos = 1.0f;   // cos(step)
+    float rotSin = 0.0f;   // sin(step)
+
+    void reset() {
+        cosine = 1.0f;
+        sine   = 0.0f;
+    }
+    void setPhase(double radians) {
+        cosine = (float)std::cos(radians);
+        sine   = (float)std::sin(radians);
+    }
+    void setStep(double radiansPerStep) {
+        rotCos = (float)std::cos(radiansPerStep);
+        rotSin = (float)std::sin(radiansPerStep);
+    }
+    void advance() {
+        float c = cosine * rotCos - sine * rotSin;
+        float s = sine * rotCos + cosine * rotSin;
+        float g = 1.5f - 0.5f * (c * c + s * s);  // ≈ 1 / |(c, s)|
+        cosine = c * g;
+        sine   = s * g;
+    }
+};
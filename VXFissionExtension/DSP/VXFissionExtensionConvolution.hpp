@@ -0,0 +1,727 @@
+//
+//  VXFissionExtensionConvolution.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "VXFissionExtensionDelayArena.hpp"
+#include "VXFissionExtensionDenormals.hpp"
+#include "VXFissionExtensionFFT.hpp"
+#include "VXFissionExtensionSIMD.hpp"
+#include "VXFissionExtensionState.hpp"
+
+// ─── Convolution reverb ──────────────────────────────────────────────────────
+
+// The wet bus's reverb stage.
+enum class VXFissionReverbEngine : int {
+    Freeverb    = 0,   // FreeverbBank (VXFissionExtensionReverb.hpp)
+    Convolution = 1,   // ConvolutionReverb, with a room impulse response
+};
+
+// Where ConvolutionReverb computes its tail partitions.
+enum class ConvolutionTailThread : int {
+    Render = 0,   // inline, on the render thread: deterministic, for offline renders
+    Worker = 1,   // on a background thread of the engine's own
+};
+
+struct ConvolutionTuning {
+    static constexpr int    kHeadTaps       = 64;     // direct-form taps, and the head's partition size
+    static constexpr int    kMinTailBlock   = 1024;   // the tail's partition size, at least the host's block
+    static constexpr double kMaxSeconds     = 10.0;   // of response used; the rest is dropped
+    static constexpr double kDefaultSeconds = 2.0;    // the synthetic room used when none is loaded
+    // Σh² of FreeverbBank's impulse response, per side (the same at every
+    // rate). Responses are scaled to it, so either engine sits at the same
+    // level in the wet bus's 3 % blend.
+    static constexpr double kFreeverbEnergy = 13.4;
+};
+
+/*
+ VXFissionImpulseResponse
+ A stereo room response at its own sample rate, as loaded. The engine takes
+ it resampled to the session rate, cut to kMaxSeconds and scaled to
+ kFreeverbEnergy.
+ */
+struct VXFissionImpulseResponse {
+    std::vector<float> left;
+    std::vector<float> right;
+    double sampleRate = 48000.0;
+
+    size_t frames() const { return std::min(left.size(), right.size()); }
+    bool   empty() const  { return frames() == 0; }
+
+    // FNV-1a over the rate and samples: a state snapshot restores only into
+    // a core holding the same response.
+    uint64_t fingerprint() const {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        auto mix = [&hash](const void *data, size_t bytes) {
+            const uint8_t *p = static_cast<const uint8_t *>(data);
+            for (size_t i = 0; i < bytes; ++i) hash = (hash ^ p[i]) * 0x100000001b3ull;
+        };
+        mix(&sampleRate, sizeof sampleRate);
+        mix(left.data(), frames() * sizeof(float));
+        mix(right.data(), frames() * sizeof(float));
+        return hash;
+    }
+
+    /*
+     A synthetic room, `seconds` long: a handful of early reflections, then
+     diffuse noise fading in over 10 ms and decaying 60 dB over the whole
+     length, darkening as it goes. Seeded, so the same on every run; the two
+     sides are decorrelated.
+     */
+    static VXFissionImpulseResponse synthetic(double seconds, double sampleRate) {
+        VXFissionImpulseResponse response;
+        response.sampleRate = sampleRate;
+        const size_t frames = std::max<size_t>(1, (size_t)(seconds * sampleRate));
+        const double decay  = std::log(0.001) / (double)frames;
+        for (int side = 0; side < 2; ++side) {
+            std::vector<float> &h = side ? response.right : response.left;
+            h.assign(frames, 0.0f);
+            uint32_t seed = 0x2545f491u + 0x9e3779b9u * (uint32_t)side;
+            auto random = [&seed] {
+                seed = seed * 1664525u + 1013904223u;
+                return (float)(seed >> 8) / 8388608.0f - 1.0f;
+            };
+            for (int i = 0; i < 12; ++i) {
+                const size_t at = (size_t)((0.005 + 0.035 * (0.5 + 0.5 * random())) * sampleRate);
+                if (at < frames) h[at] += (random() < 0.0f ? -1.0f : 1.0f) * (0.5f - 0.025f * (float)i);
+            }
+            const double onset = 0.010 * sampleRate;
+            float lowpass = 0.0f;
+            for (size_t t = 0; t < frames; ++t) {
+                const float darkening = 0.1f + 0.6f * (float)t / (float)frames;
+                lowpass += (1.0f - darkening) * (random() - lowpass);
+                const double fadeIn = std::min(1.0, (double)t / onset);
+                h[t] += 0.3f * lowpass * (float)(fadeIn * std::exp(decay * (double)t));
+            }
+        }
+        return response;
+    }
+
+    // Windowed-sinc resampling (Blackman, 16 zero crossings a side, the
+    // cutoff lowered to the new Nyquist when going down). Allocates.
+    VXFissionImpulseResponse resampled(double rate) const {
+        if (rate == sampleRate || empty()) return *this;
+        constexpr int kZeroCrossings = 16;
+        const double ratio  = rate / sampleRate;
+        const double cutoff = std::min(1.0, ratio);
+        const double reach  = kZeroCrossings / cutoff;  // input samples either side
+        VXFissionImpulseResponse out;
+        out.sampleRate = rate;
+        const size_t frames = (size_t)std::ceil((double)this->frames() * ratio);
+        for (int side = 0; side < 2; ++side) {
+            const std::vector<float> &x = side ? right : left;
+            std::vector<float>       &y = side ? out.right : out.left;
+            y.assign(frames, 0.0f);
+            for (size_t m = 0; m < frames; ++m) {
+                const double t     = (double)m / ratio;
+                const long   first = std::max(0L, (long)std::ceil(t - reach));
+                const long   last  = std::min((long)this->frames() - 1, (long)std::floor(t + reach));
+                double sum = 0.0;
+                for (long n = first; n <= last; ++n) {
+                    const double d      = t - (double)n;
+                    const double sinc   = (d == 0.0) ? 1.0 : std::sin(M_PI * cutoff * d) / (M_PI * cutoff * d);
+                    const double phase  = M_PI * (d / reach + 1.0);
+                    const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+                    sum += x[n] * cutoff * sinc * window;
+                }
+                y[m] = (float)sum;
+            }
+        }
+        return out;
+    }
+};
+
+/*
+ UniformPartitionedConvolver
+ Uniformly partitioned overlap-save convolution of a mono input with one
+ stereo segment of a response, a block of B frames at a time: the segment is
+ cut into P partitions of B, each held as the spectrum of a 2B transform.
+ Every block the last 2B input samples are transformed once, into a
+ frequency-domain delay line of the last P input spectra; each side's output
+ is then the inverse transform of Σ_p X[now − p]·H[p], whose second half is
+ the block. That block is the segment's response up to the end of the input
+ block, so it is ready one block late: the owner places the segment at least
+ B frames into the response.
+
+ configure() allocates; everything else runs in place.
+ */
+class UniformPartitionedConvolver {
+public:
+    // `length` samples of each side, from segment[0] and segment[1].
+    void configure(const float *const segment[2], size_t length, int block) {
+        mBlock      = block;
+        mBins       = block;
+        mPartitions = (int)((length + block - 1) / block);
+        mFFT.initialize(2 * block);
+        const size_t spectrum = 2 * (size_t)mBins;
+        mResponse.assign(spectrum * 2 * mPartitions);
+        mHistory.assign(spectrum * std::max(mPartitions, 1));
+        mWindow.assign(2 * (size_t)block);
+        mAccumulator.assign(spectrum);
+        mTime.assign(2 * (size_t)block);
+
+        // Partition spectra, with the inverse transform's 1/2B folded in.
+        std::vector<float> padded(2 * (size_t)block);
+        const float scale = 1.0f / (float)(2 * block);
+        for (int side = 0; side < 2; ++side) {
+            for (int p = 0; p < mPartitions; ++p) {
+                std::fill(padded.begin(), padded.end(), 0.0f);
+                const size_t start = (size_t)p * block;
+                const size_t count = std::min<size_t>(block, length - start);
+                for (size_t i = 0; i < count; ++i) padded[i] = segment[side][start + i] * scale;
+                float *re = response(side, p);
+                mFFT.forward(padded.data(), re, re + mBins);
+            }
+        }
+        mNewest = 0;
+    }
+
+    void release() {
+        mResponse.release();
+        mHistory.release();
+        mPartitions = 0;
+    }
+
+    // Back to silence.
+    void reset() {
+        mHistory.clear();
+        mWindow.clear();
+        mNewest = 0;
+    }
+
+    // One block of input in, one block of each side out.
+    void processBlock(const float *in, float *outL, float *outR) {
+        if (mPartitions == 0) {
+            std::fill_n(outL, mBlock, 0.0f);
+            std::fill_n(outR, mBlock, 0.0f);
+            return;
+        }
+        float *window = mWindow.data();
+        std::memcpy(window, window + mBlock, (size_t)mBlock * sizeof(float));
+        std::memcpy(window + mBlock, in, (size_t)mBlock * sizeof(float));
+        mNewest = (mNewest + 1 == mPartitions) ? 0 : mNewest + 1;
+        float *newest = history(mNewest);
+        mFFT.forward(window, newest, newest + mBins);
+
+        float *accRe = mAccumulator.data();
+        float *accIm = accRe + mBins;
+        for (int side = 0; side < 2; ++side) {
+            mAccumulator.clear();
+            int slot = mNewest;
+            for (int p = 0; p < mPartitions; ++p) {
+                const float *x = history(slot);
+                const float *h = response(side, p);
+                spectrumMultiplyAdd(x, x + mBins, h, h + mBins, accRe, accIm, mBins);
+                slot = (slot == 0) ? mPartitions - 1 : slot - 1;
+            }
+            mFFT.inverse(accRe, accIm, mTime.data());
+            std::memcpy(side ? outR : outL, mTime.data() + mBlock, (size_t)mBlock * sizeof(float));
+        }
+    }
+
+    int block() const      { return mBlock; }
+    int partitions() const { return mPartitions; }
+
+    // Bytes held: response spectra, input history and scratch.
+    size_t bytes() const {
+        return (mResponse.size() + mHistory.size() + mWindow.size() + mAccumulator.size() + mTime.size()) * sizeof(float);
+    }
+
+    // The input history; the response is configuration.
+    void saveState(VXFissionStateWriter &writer) const {
+        writer.value(mNewest);
+        writer.floats(mHistory.data(), mHistory.size());
+        writer.floats(mWindow.data(), mWindow.size());
+    }
+
+    void loadState(VXFissionStateReader &reader) {
+        reader.value(mNewest);
+        reader.floats(mHistory.data(), mHistory.size());
+        reader.floats(mWindow.data(), mWindow.size());
+    }
+
+private:
+    float *response(int side, int partition) { return mResponse.data() + ((size_t)side * mPartitions + partition) * 2 * mBins; }
+    float *history(int slot)                 { return mHistory.data() + (size_t)slot * 2 * mBins; }
+
+    RealFFT mFFT;
+    int mBlock      = 0;
+    int mBins       = 0;   // per packed spectrum: B
+    int mPartitions = 0;
+    int mNewest     = 0;   // history slot of the latest input spectrum
+    AlignedFloatBuffer mResponse;     // [side][partition]: re, then im
+    AlignedFloatBuffer mHistory;      // [slot]: input spectra, re then im
+    AlignedFloatBuffer mWindow;       // the last 2B input samples
+    AlignedFloatBuffer mAccumulator;  // re, then im
+    AlignedFloatBuffer mTime;         // 2B samples of inverse transform
+};
+
+/*
+ ConvolutionReverb
+ The wet bus's reverb as convolution with a room impulse response: the same
+ feed as FreeverbBank (mono in, left and right out) and, like it, no
+ latency. The response is cut in three, each part starting as late as the
+ work on it allows:
+
+   [0, B)      direct form, B taps a side           render thread
+   [B, 2L)     partitions of B (the head)           render thread
+   [2L, end)   partitions of L (the tail)           worker thread
+
+ B is ConvolutionTuning::kHeadTaps; L is a power of two, at least
+ kMinTailBlock and the largest host block. The head's output for a block of
+ B is computed when its input is complete and plays through the next one.
+ A block of L of tail input goes to the worker as a job when it is complete
+ and its output is due two blocks later, so the worker has a whole block of
+ L frames to compute it in.
+
+ Jobs pass through kTailSlots slots and three counters, without locks: the
+ render thread fills a slot's input, publishes the job number with a release
+ store and wakes the worker with an atomic notify (a futex / ulock wake that
+ never blocks); the worker writes the slot's output and publishes the job's
+ completion the same way. A job not complete when due is skipped, its block
+ of tail silent, and counted in lateBlocks(). A worker so far behind that the
+ slot to fill is still in use stops being fed (overruns()); once it has
+ caught up, the tail starts again from the current block with its history
+ cleared, as after reset().
+
+ With ConvolutionTailThread::Render the render thread runs each tail job as
+ it is submitted: nothing is ever late and a render is the same every time,
+ for offline use, but every L frames one block carries the whole tail's work.
+ A render faster than realtime with the tail on the worker would outrun it;
+ setWaitsForTail() has process() wait for every job it hands over before
+ the next block of L, which renders what the inline tail would.
+
+ configure() and release() allocate and start or stop the worker; not for
+ the render thread. process() and reset() never allocate or lock, and wait
+ only when told to.
+ Copies are deep; a copy runs its own worker.
+ */
+class ConvolutionReverb {
+public:
+    static constexpr int kTailSlots = 4;
+
+    ConvolutionReverb() = default;
+    ConvolutionReverb(const ConvolutionReverb &other) { *this = other; }
+    ~ConvolutionReverb() { stopWorker(); }
+
+    ConvolutionReverb &operator=(const ConvolutionReverb &other) {
+        if (this == &other) return *this;
+        stopWorker();
+        mThread      = other.mThread;
+        mLength      = other.mLength;
+        mTailBlock   = other.mTailBlock;
+        mTaps        = other.mTaps;
+        mDirect      = other.mDirect;
+        mHead        = other.mHead;
+        mHeadInput   = other.mHeadInput;
+        mHeadOutput  = other.mHeadOutput;
+        mHeadPos     = other.mHeadPos;
+        mTailPos     = other.mTailPos;
+        mTailIndex   = other.mTailIndex;
+        mSubmitted   = other.mSubmitted;
+        mRunStart    = other.mRunStart;
+        mFeeding     = other.mFeeding;
+        mTailReady   = other.mTailReady;
+        mWaitForTail = other.mWaitForTail;
+        mLateBlocks  = other.mLateBlocks;
+        mOverruns    = other.mOverruns;
+        mTail.reset();
+        if (other.mTail) {
+            other.waitForTail();
+            mTail = std::make_unique<Tail>();
+            mTail->convolver = other.mTail->convolver;
+            mTail->slots     = other.mTail->slots;
+            mTail->next      = other.mTail->next;
+            mTail->run       = other.mTail->run;
+            mTail->submitted.store(other.mTail->submitted.load());
+            mTail->completed.store(other.mTail->completed.load());
+            mTail->runStart.store(other.mTail->runStart.load());
+            startWorker();
+        }
+        return *this;
+    }
+
+    /*
+     Prepares `response` (at the engine's rate already: see
+     VXFissionImpulseResponse::resampled()) for host blocks of up to
+     maxBlock frames, silent, with the tail on `thread`.
+     */
+    void configure(const VXFissionImpulseResponse &response, int maxBlock, ConvolutionTailThread thread) {
+        constexpr int B = ConvolutionTuning::kHeadTaps;
+        stopWorker();
+        mThread    = thread;
+        mLength    = std::min(response.frames(), (size_t)(ConvolutionTuning::kMaxSeconds * response.sampleRate));
+        mTailBlock = (int)nextPowerOfTwo((size_t)std::max(ConvolutionTuning::kMinTailBlock, maxBlock));
+
+        // Scaled to FreeverbBank's energy.
+        double energy = 0.0;
+        for (size_t t = 0; t < mLength; ++t) {
+            energy += (double)response.left[t] * response.left[t] + (double)response.right[t] * response.right[t];
+        }
+        const float scale = (energy > 0.0) ? (float)std::sqrt(ConvolutionTuning::kFreeverbEnergy / (0.5 * energy)) : 0.0f;
+        std::vector<float> scaled[2];
+        for (int side = 0; side < 2; ++side) {
+            const std::vector<float> &h = side ? response.right : response.left;
+            scaled[side].assign(std::max(mLength, (size_t)B), 0.0f);
+            for (size_t t = 0; t < mLength; ++t) scaled[side][t] = h[t] * scale;
+        }
+
+        // Direct form: taps reversed, so each output is one dot product over
+        // the last B inputs, oldest first.
+        mTaps.assign(2 * (size_t)B);
+        for (int side = 0; side < 2; ++side) {
+            for (int k = 0; k < B; ++k) mTaps.data()[side * B + k] = scaled[side][B - 1 - k];
+        }
+        mDirect.assign(2 * (size_t)B);
+
+        const size_t headEnd = std::min(mLength, 2 * (size_t)mTailBlock);
+        const float *head[2] = { scaled[0].data() + B, scaled[1].data() + B };
+        mHead.configure(head, (headEnd > (size_t)B) ? headEnd - B : 0, B);
+        mHeadInput.assign(B);
+        mHeadOutput.assign(2 * (size_t)B);
+
+        mTail.reset();
+        if (mLength > headEnd) {
+            mTail = std::make_unique<Tail>();
+            const float *tail[2] = { scaled[0].data() + headEnd, scaled[1].data() + headEnd };
+            mTail->convolver.configure(tail, mLength - headEnd, mTailBlock);
+            mTail->slots.assign((size_t)kTailSlots * 3 * mTailBlock);
+        }
+        mHeadPos    = 0;
+        mTailPos    = 0;
+        mTailIndex  = 0;
+        mSubmitted  = 0;
+        mRunStart   = 0;
+        mFeeding    = true;
+        mTailReady  = false;
+        mLateBlocks = 0;
+        mOverruns   = 0;
+        startWorker();
+    }
+
+    void release() {
+        stopWorker();
+        mTail.reset();
+        mHead.release();
+        mTaps.release();
+        mDirect.release();
+        mLength = 0;
+    }
+
+    bool empty() const { return mTaps.empty(); }
+
+    // Back to silence. A tail job in flight is left to finish and ignored;
+    // if the worker is still busy with one, the tail is fed again from the
+    // first block after it is done.
+    void reset() {
+        mDirect.clear();
+        mHead.reset();
+        mHeadInput.clear();
+        mHeadOutput.clear();
+        mTailReady = false;
+        if (!mTail) return;
+        if (mTail->completed.load(std::memory_order_acquire) == mSubmitted) {
+            startRun();
+            std::fill_n(slot(mTailIndex), mTailPos, 0.0f);
+        } else {
+            mFeeding  = false;
+            mRunStart = kNoRun;
+        }
+    }
+
+    // n mono samples in; outL/outR receive the reverb.
+    void process(const float *in, float *outL, float *outR, int n) {
+        constexpr int B = ConvolutionTuning::kHeadTaps;
+        const int L = mTailBlock;
+        for (int k = 0; k < n; ) {
+            if (mTail && mTailPos == 0) beginTailBlock();
+            const int run = std::min({ n - k, B - mHeadPos, L - mTailPos });
+            const float *x = in + k;
+            float *yL = outL + k;
+            float *yR = outR + k;
+
+            processDirect(x, yL, yR, run);
+            const float *headL = mHeadOutput.data() + mHeadPos;
+            const float *headR = headL + B;
+            for (int i = 0; i < run; ++i) {
+                yL[i] += headL[i];
+                yR[i] += headR[i];
+            }
+            std::copy_n(x, run, mHeadInput.data() + mHeadPos);
+            if (mTailReady) {
+                const float *tailL = slot(mTailIndex - 2) + L + mTailPos;
+                const float *tailR = tailL + L;
+                for (int i = 0; i < run; ++i) {
+                    yL[i] += tailL[i];
+                    yR[i] += tailR[i];
+                }
+            }
+            if (mTail && mFeeding) std::copy_n(x, run, slot(mTailIndex) + mTailPos);
+
+            k        += run;
+            mHeadPos += run;
+            mTailPos += run;
+            if (mHeadPos == B) {
+                mHead.processBlock(mHeadInput.data(), mHeadOutput.data(), mHeadOutput.data() + B);
+                mHeadPos = 0;
+            }
+            if (mTailPos == L) {
+                if (mTail) endTailBlock();
+                mTailPos = 0;
+            }
+        }
+    }
+
+    // Render thread. On for offline renders: late tail jobs are waited for
+    // rather than skipped. Takes effect at the next block of L.
+    void setWaitsForTail(bool wait) { mWaitForTail = wait; }
+    bool waitsForTail() const       { return mWaitForTail; }
+
+    // Frames of quiet feed after which the output can hold nothing of what
+    // came before: the response's length.
+    int settleFrames() const { return (int)mLength; }
+
+    size_t responseFrames() const { return mLength; }
+    int    tailBlock() const      { return mTailBlock; }
+    int    headPartitions() const { return mHead.partitions(); }
+    int    tailPartitions() const { return mTail ? mTail->convolver.partitions() : 0; }
+    ConvolutionTailThread tailThread() const { return mThread; }
+
+    // Render thread: tail blocks skipped because the worker was late, and
+    // times it fell so far behind that the tail restarted.
+    uint64_t lateBlocks() const { return mLateBlocks; }
+    uint64_t overruns() const   { return mOverruns; }
+
+    // Bytes held by the engine: spectra, histories, slots and scratch.
+    size_t bytes() const {
+        size_t total = mHead.bytes() + (mTaps.size() + mDirect.size() + mHeadInput.size() + mHeadOutput.size()) * sizeof(float);
+        if (mTail) total += mTail->convolver.bytes() + mTail->slots.size() * sizeof(float);
+        return total;
+    }
+
+    // Waits for the worker to finish the jobs it has been given; not for the
+    // render thread.
+    void saveState(VXFissionStateWriter &writer) const {
+        writer.floats(mDirect.data(), mDirect.size());
+        mHead.saveState(writer);
+        writer.floats(mHeadInput.data(), mHeadInput.size());
+        writer.floats(mHeadOutput.data(), mHeadOutput.size());
+        writer.value(mHeadPos);
+        writer.value(mTailPos);
+        writer.value(mTailIndex);
+        writer.value(mSubmitted);
+        writer.value(mRunStart);
+        writer.value(mFeeding);
+        writer.value(mTailReady);
+        if (!mTail) return;
+        waitForTail();
+        mTail->convolver.saveState(writer);
+        writer.floats(mTail->slots.data(), mTail->slots.size());
+        writer.value(mTail->next);
+        writer.value(mTail->run);
+        writer.value(mTail->runStart.load());
+    }
+
+    // Stops the worker while the state is replaced.
+    void loadState(VXFissionStateReader &reader) {
+        stopWorker();
+        reader.floats(mDirect.data(), mDirect.size());
+        mHead.loadState(reader);
+        reader.floats(mHeadInput.data(), mHeadInput.size());
+        reader.floats(mHeadOutput.data(), mHeadOutput.size());
+        reader.value(mHeadPos);
+        reader.value(mTailPos);
+        reader.value(mTailIndex);
+        reader.value(mSubmitted);
+        reader.value(mRunStart);
+        reader.value(mFeeding);
+        reader.value(mTailReady);
+        if (mTail) {
+            int64_t runStart = 0;
+            mTail->convolver.loadState(reader);
+            reader.floats(mTail->slots.data(), mTail->slots.size());
+            reader.value(mTail->next);
+            reader.value(mTail->run);
+            reader.value(runStart);
+            mTail->runStart.store(runStart);
+            mTail->submitted.store(mSubmitted);
+            mTail->completed.store(mSubmitted);
+        }
+        startWorker();
+    }
+
+private:
+    static constexpr int64_t kNoRun = INT64_MAX;
+
+    // What the render thread and the worker share. On the heap, so its
+    // address holds still for the worker while the engine is moved about.
+    struct Tail {
+        UniformPartitionedConvolver convolver;    // the worker's (the render thread's, inline)
+        AlignedFloatBuffer slots;                 // kTailSlots × (input, left, right), L each
+        int64_t next = 0;                         // the worker's next job
+        int64_t run  = 0;                         // the run the convolver's history belongs to
+        alignas(kCacheLineBytes) std::atomic<int64_t> submitted { 0 };  // one past the last job handed over
+        alignas(kCacheLineBytes) std::atomic<int64_t> completed { 0 };  // one past the last job finished
+        std::atomic<int64_t> runStart { 0 };      // first job fed since the history was last silent
+        std::atomic<bool>    quit { false };
+        std::thread          thread;
+    };
+
+    float *slot(int64_t job) const {
+        return mTail->slots.data() + (size_t)(job % kTailSlots) * 3 * mTailBlock;
+    }
+
+    // The direct-form taps over `run` ≤ B frames. mDirect holds the last
+    // B − 1 inputs ahead of the run, so every output's window is contiguous.
+    void processDirect(const float *x, float *yL, float *yR, int run) {
+        constexpr int B = ConvolutionTuning::kHeadTaps;
+        constexpr int W = SIMDFloat::kWidth;
+        float *history = mDirect.data();
+        std::copy_n(x, run, history + B - 1);
+        const float *tapsL = mTaps.data();
+        const float *tapsR = tapsL + B;
+        for (int i = 0; i < run; ++i) {
+            const float *window = history + i;
+            SIMDFloat accL = SIMDFloat::broadcast(0.0f);
+            SIMDFloat accR = SIMDFloat::broadcast(0.0f);
+            for (int k = 0; k < B; k += W) {
+                const SIMDFloat v = SIMDFloat::load(window + k);
+                accL = accL + v * SIMDFloat::load(tapsL + k);
+                accR = accR + v * SIMDFloat::load(tapsR + k);
+            }
+            yL[i] = accL.sum();
+            yR[i] = accR.sum();
+        }
+        std::memmove(history, history + run, (size_t)(B - 1) * sizeof(float));
+    }
+
+    // Feeds the tail from the current block, with its history silent.
+    void startRun() {
+        mRunStart = mTailIndex;
+        mTail->runStart.store(mTailIndex, std::memory_order_relaxed);  // published by the next submit
+        mFeeding = true;
+    }
+
+    void beginTailBlock() {
+        if (mWaitForTail) waitForTail();
+        const int64_t completed = mTail->completed.load(std::memory_order_acquire);
+        if (!mFeeding && completed == mSubmitted) startRun();
+        // The slot to fill still holds a job the worker has not finished.
+        if (mFeeding && mTailIndex - kTailSlots >= mRunStart && completed <= mTailIndex - kTailSlots) {
+            mFeeding  = false;
+            mRunStart = kNoRun;
+            ++mOverruns;
+        }
+        const int64_t due = mTailIndex - 2;
+        mTailReady = due >= mRunStart && completed > due;
+        if (due >= mRunStart && !mTailReady) ++mLateBlocks;
+    }
+
+    void endTailBlock() {
+        if (mFeeding) {
+            mSubmitted = mTailIndex + 1;
+            if (mThread == ConvolutionTailThread::Render) {
+                mTail->submitted.store(mSubmitted, std::memory_order_relaxed);
+                runJobs(*mTail, mSubmitted, mTailBlock);
+            } else {
+                mTail->submitted.store(mSubmitted, std::memory_order_release);
+                mTail->submitted.notify_one();
+            }
+        }
+        ++mTailIndex;
+    }
+
+    // Every job before `submitted` not yet run. The first job of a new run
+    // starts from silence; jobs never fed are skipped. A run only starts
+    // while the worker is idle, so the jobs of the last one are all done.
+    static void runJobs(Tail &tail, int64_t submitted, int block) {
+        while (tail.next < submitted) {
+            const int64_t runStart = tail.runStart.load(std::memory_order_relaxed);
+            if (tail.run != runStart) {
+                tail.convolver.reset();
+                tail.run  = runStart;
+                tail.next = std::max(tail.next, runStart);
+                continue;
+            }
+            float *s = tail.slots.data() + (size_t)(tail.next % kTailSlots) * 3 * block;
+            tail.convolver.processBlock(s, s + block, s + 2 * block);
+            tail.completed.store(++tail.next, std::memory_order_release);
+        }
+    }
+
+    // Flushes denormals as process() does: a fading feed would otherwise
+    // slow the tail's FFTs and multiply-accumulates until jobs run late.
+    static void workerLoop(Tail &tail, int block) {
+        const ScopedFlushDenormals flushDenormals;
+        for (;;) {
+            const int64_t submitted = tail.submitted.load(std::memory_order_acquire);
+            if (tail.quit.load(std::memory_order_relaxed)) return;
+            if (tail.next >= submitted) {
+                tail.submitted.wait(submitted, std::memory_order_acquire);
+                continue;
+            }
+            runJobs(tail, submitted, block);
+        }
+    }
+
+    void startWorker() {
+        if (!mTail || mThread != ConvolutionTailThread::Worker || mTail->thread.joinable()) return;
+        mTail->quit.store(false);
+        Tail *tail = mTail.get();
+        const int block = mTailBlock;
+        mTail->thread = std::thread([tail, block] { workerLoop(*tail, block); });
+    }
+
+    // Lets the worker finish what it has, then ends it. The submitted count
+    // moves past the last job only to wake it.
+    void stopWorker() {
+        if (!mTail || !mTail->thread.joinable()) return;
+        waitForTail();
+        mTail->quit.store(true, std::memory_order_relaxed);
+        mTail->submitted.fetch_add(1, std::memory_order_release);
+        mTail->submitted.notify_one();
+        mTail->thread.join();
+        mTail->submitted.store(mSubmitted);
+    }
+
+    void waitForTail() const {
+        if (!mTail) return;
+        while (mTail->completed.load(std::memory_order_acquire) < mSubmitted) std::this_thread::yield();
+    }
+
+    ConvolutionTailThread mThread = ConvolutionTailThread::Render;
+    size_t mLength    = 0;     // response frames used
+    int    mTailBlock = ConvolutionTuning::kMinTailBlock;  // L
+
+    AlignedFloatBuffer mTaps;        // direct form, [side][B], reversed
+    AlignedFloatBuffer mDirect;      // the last B − 1 inputs, then the run being computed
+    UniformPartitionedConvolver mHead;
+    AlignedFloatBuffer mHeadInput;   // the current block of B
+    AlignedFloatBuffer mHeadOutput;  // [side][B]: the head's output for the current block
+    int mHeadPos = 0;                // frames into the current block of B
+    int mTailPos = 0;                // frames into the current block of L
+
+    // Tail, render-thread side
+    std::unique_ptr<Tail> mTail;     // null when the response ends within the head
+    int64_t  mTailIndex  = 0;        // the current block of L: the job its input is for
+    int64_t  mSubmitted  = 0;        // one past the last job handed over
+    int64_t  mRunStart   = 0;        // first job of the current run, or kNoRun while not feeding
+    bool     mFeeding    = true;     // the current block's input goes to the tail
+    bool     mTailReady  = false;    // the job due now (two blocks back) is complete
+    bool     mWaitForTail = false;   // offline: wait for the worker instead of skipping
+    uint64_t mLateBlocks = 0;
+    uint64_t mOverruns   = 0;
+};
@@ -0,0 +1,1638 @@
+//
+//  VXFissionExtensionDSPCore.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "VXFissionExtensionChannelMap.hpp"
+#include "VXFissionExtensionCompressor.hpp"
+#include "VXFissionExtensionControlRate.hpp"
+#include "VXFissionExtensionConvolution.hpp"
+#include "VXFissionExtensionDelayArena.hpp"
+#include "VXFissionExtensionDenormals.hpp"
+#include "VXFissionExtensionInterpolation.hpp"
+#include "VXFissionExtensionLockFree.hpp"
+#include "VXFissionExtensionMetering.hpp"
+#include "VXFissionExtensionProfiling.hpp"
+#include "VXFissionExtensionQuality.hpp"
+#include "VXFissionExtensionRateTables.hpp"
+#include "VXFissionExtensionReverb.hpp"
+#include "VXFissionExtensionState.hpp"
+
+/*
+ VXFissionExtensionDSPCore
+ The complete VX Fission signal path with no Apple dependencies, so it can be
+ built, benchmarked and tested on any platform. VXFissionExtensionDSPKernel
+ wraps it for the Audio Unit; offline tools (see Tools/) drive it directly.
+
+ Stereo Haas delay: a single signed knob controls both channel and amount.
+   delayTime < 0 → delay left channel by abs(delayTime) ms
+   delayTime > 0 → delay right channel by abs(delayTime) ms
+   delayTime = 0 → pass-through (no delay)
+
+ Any channel count up to VXFissionChannelMap::kMaxChannels renders the same
+ way: the channel map (see VXFissionExtensionChannelMap.hpp) gives each
+ channel its share of the Haas offset and its side of the reverb. Per-channel
+ state is held as arrays indexed by channel and every stage runs channel by
+ channel over the whole sub-block. A mono output still renders two channels
+ internally, keeping the stereo detector and reverb feed, and writes the first.
+
+ The block path is compiled per channel layout — mono in to stereo, stereo in
+ to stereo, and any count (N → N, or mono upmixed to N) — and initialize()
+ picks the instantiation once. The stereo layouts have their channel count
+ as a constant; with a mono input every channel's Haas ring would hold the
+ same samples, so there is only one, written once and read by every channel.
+
+ The Haas read is fractional; HaasInterpolator (see
+ VXFissionExtensionInterpolation.hpp) picks its quality at compile time.
+ DelaySample (see VXFissionExtensionDelayFormat.hpp) is what the Haas and
+ reverb rings store: float, or a narrower format that trades a little noise
+ for a smaller arena. VXFissionExtensionDSPCore is the build's default.
+
+ The wet bus renders at one of three quality tiers (see
+ VXFissionExtensionQuality.hpp), fixed or chosen by a governor from the
+ measured render time. Standard is the default, and Auto renders at
+ standard while rendering offline, so offline renders are the same on every
+ machine.
+ */
+template <typename HaasInterpolator, typename DelaySample = VXFISSION_DELAY_SAMPLE>
+class VXFissionExtensionDSPCoreT {
+public:
+    void initialize(int inputChannelCount, int outputChannelCount, double inSampleRate) {
+        mSampleRate = inSampleRate;
+        mChannels   = std::clamp(outputChannelCount, 2, kMaxChannels);
+        mMonoInput  = (inputChannelCount == 1);
+        mProcessBlock = blockRendererFor(mChannels, mMonoInput);
+        if (mChannelMap.count != mChannels) mChannelMap = VXFissionChannelMap::defaultFor(mChannels);
+        applyChannelMap();
+        // Enough for 50 ms at the current sample rate, plus one extra sample so a
+        // delay of exactly 50 ms never wraps onto itself.
+        mDelayLength = (int)(mSampleRate * 0.050) + 1;
+        mBlockCapacity = std::max<uint32_t>(mMaxFramesToRender, 1);
+        // Everything derived from the rate by exp / sin: a table lookup at the
+        // standard rates (VXFissionExtensionRateTables.hpp).
+        const VXFissionRateTuning tuning = rateTuningFor(inSampleRate, mBypassFadeStorage);
+        // Hosts re-initialise several times while loading a project, mostly at
+        // the layout already held (deInitialize() keeps it): then nothing is
+        // laid out or reallocated, and the buffers are only cleared if audio
+        // has run since.
+        const bool sameLayout = !mArena.empty() && inSampleRate == mLayoutRate
+                             && mChannels == mLayoutChannels && mMonoInput == mLayoutMonoInput
+                             && mBlockCapacity == mLayoutCapacity && mReverbEngine == mLayoutReverbEngine
+                             && mImpulseVersion == mLayoutImpulseVersion && mTailThread == mLayoutTailThread;
+        if (!sameLayout) {
+            allocateBuffers(tuning);
+        } else if (mRendered) {
+            clearBuffers();
+        }
+        mRendered  = false;
+        mWriteHead = 0;
+        std::fill(std::begin(mHaasState), std::end(mHaasState), typename HaasInterpolator::State {});
+        // Equal-power fade: dry gain sin(π/2 · k/N) at step k, effect gain the
+        // same curve read from the other end.
+        mBypassFade       = tuning.bypassFade;
+        mBypassFadeFrames = tuning.bypassFadeFrames;
+        mBypassEngaged  = mBypassed.load();
+        mBypassPosition = mBypassEngaged ? mBypassFadeFrames : 0;
+        mFadeTrails     = false;
+        mTrailsRinging  = false;
+        mMsToSamples         = (float)(inSampleRate / 1000.0);
+        mSmoothedDelayTimeMs = 0.0f;
+        // One-pole smoothing: ~20 ms time constant eliminates read-head jumps.
+        mSmoothingCoeff = tuning.smoothingCoeff;
+        // Chorus LFO: 0.8 Hz sine wave, starting at phase 0.
+        mLFO.reset();
+        // Control-rate values start at rest: knob centred, dry only.
+        mDelayRamp.reset(0.0f);
+        mCurrentDelayMs = 0.0f;
+        mRampFramesLeft = 0;
+        mChorusDelayRamp.reset(chorusDelaySamples(0.0f));
+        mDryGainRamp.reset(1.0f);
+        mWetGainRamp.reset(0.0f);
+        // Quality: the tier asked for, in full from the first frame.
+        mQualityFadeFrames = std::max(1, (int)(inSampleRate * kQualityFadeSeconds));
+        mGovernor.initialize(inSampleRate);
+        mQualityModeLatched = renderedQualityMode();
+        mQualityTier        = wantedQualityTier();
+        mControlTier        = mQualityTier;
+        mChorusBlend        = chorusBlendFor(mQualityTier);
+        mChorusBlendTarget  = mChorusBlend;
+        mReverb.setCombsPerSide(mArena, combsPerSideFor(mQualityTier), 0);
+        mQualityTierOut.store((int)mQualityTier);
+        configureControlRate();
+        // Compressor: gentle 2:1 ratio above -6 dBFS, depth scales with busAmount.
+        mCompressor.reset();
+        mCompressor.setOversampling(mOversamplingParam.load());
+        for (LatencyDelay &delay : mBypassDelay) delay.reset();
+#if VXFISSION_PROFILING
+        mProfiler.initialize(inSampleRate);
+#endif
+        // Sleep/wake: everything starts silent, so the wet bus starts asleep.
+        mBusCloseFlushFrames = (int)(inSampleRate * 0.200);
+        mSilentInputFrames   = mRingSize;
+        mBusClosedFrames     = 0;
+        mReverbQuietFrames   = 0;
+        mReverbAsleep        = true;
+        mWetBusAsleep        = true;
+        mMeters.reset();
+        mReady = true;
+    }
+
+    // Lays out the arena and sizes every buffer for the current rate, channel
+    // count and block capacity. Everything comes back zeroed.
+    void allocateBuffers(const VXFissionRateTuning &tuning) {
+        // The block pipeline writes a whole sub-block into the rings before any
+        // frame of it is read, so the rings carry one block of headroom on top of
+        // the delay length; otherwise the oldest sample a full-deflection read
+        // needs would already be overwritten by a later frame of the same block.
+        // The Haas interpolator's older taps need their own few samples on top.
+        // Haas rings and reverb share one arena allocation; at a rate whose
+        // layout fits what is already held, nothing is reallocated. The
+        // convolution engine keeps its own buffers, so with it selected the
+        // arena holds only the rings.
+        const size_t ringSamples = (size_t)mDelayLength + mBlockCapacity + HaasInterpolator::kTapsOlder;
+        // A mono input keeps one ring, which every channel reads.
+        mRingCount = mMonoInput ? 1 : mChannels;
+        mArena.beginLayout();
+        for (int c = 0; c < mRingCount; ++c) mDelayLine[c] = mArena.reserveRing(ringSamples);
+        for (int c = mRingCount; c < mChannels; ++c) mDelayLine[c] = mDelayLine[0];
+        if (mReverbEngine == VXFissionReverbEngine::Freeverb) {
+            mReverb.layout(mArena, tuning.sampleRate);
+            mConvolution.release();
+        } else {
+            mReverb.release();
+            configureConvolution(tuning.sampleRate);
+        }
+        mArena.allocate();
+        mReverb.resetState();
+        mRingSize  = mDelayLine[0].size;
+        mRingMask  = mDelayLine[0].mask;
+        // Per-stage scratch, sized once here so process() never allocates.
+        mSmoothedBlock.assign(mBlockCapacity, 0.0f);
+        mBusBlock.assign(mBlockCapacity, 0.0f);
+        mChorusDelayBlock.assign(mBlockCapacity, 0.0f);
+        mDryGainBlock.assign(mBlockCapacity, 0.0f);
+        mWetGainBlock.assign(mBlockCapacity, 0.0f);
+        mWetStride = roundUpToCacheLine(mBlockCapacity);
+        mWetBlock.assign(mWetStride * mChannels, 0.0f);
+        mReverbInBlock.assign(mBlockCapacity, 0.0f);
+        mReverbBlockL.assign(mBlockCapacity, 0.0f);
+        mReverbBlockR.assign(mBlockCapacity, 0.0f);
+        mBypassDryBlock.assign(mWetStride * mChannels, 0.0f);
+        mBypassInBlock.assign(mWetStride * mChannels, 0.0f);
+        mFadeWetBlock.assign(mBlockCapacity, 0.0f);
+        mFadeDryBlock.assign(mBlockCapacity, 0.0f);
+        mCompressor.initialize(tuning.compressor, (int)mBlockCapacity, mChannels);
+        mLayoutRate           = tuning.sampleRate;
+        mLayoutChannels       = mChannels;
+        mLayoutMonoInput      = mMonoInput;
+        mLayoutCapacity       = mBlockCapacity;
+        mLayoutReverbEngine   = mReverbEngine;
+        mLayoutImpulseVersion = mImpulseVersion;
+        mLayoutTailThread     = mTailThread;
+    }
+
+    // The loaded response at the session rate, or the synthetic room.
+    void configureConvolution(double sampleRate) {
+        const VXFissionImpulseResponse response = mImpulseResponse.empty()
+            ? VXFissionImpulseResponse::synthetic(ConvolutionTuning::kDefaultSeconds, sampleRate)
+            : mImpulseResponse.resampled(sampleRate);
+        mResponseFingerprint = mImpulseResponse.fingerprint();
+        mConvolution.configure(response, (int)mBlockCapacity, mTailThread);
+    }
+
+    // Zeroes the delay lines, reverb and scratch in place.
+    void clearBuffers() {
+        mArena.clear();
+        mReverb.resetState();
+        if (!mConvolution.empty()) mConvolution.reset();
+        for (std::vector<float> *block : { &mSmoothedBlock, &mBusBlock, &mChorusDelayBlock, &mDryGainBlock,
+                                           &mWetGainBlock, &mWetBlock, &mReverbInBlock, &mReverbBlockL,
+                                           &mReverbBlockR, &mBypassDryBlock, &mBypassInBlock,
+                                           &mFadeWetBlock, &mFadeDryBlock }) {
+            std::fill(block->begin(), block->end(), 0.0f);
+        }
+    }
+
+    // process() renders nothing until the next initialize(). The arena, reverb
+    // and scratch are kept, since the Audio Unit deallocates before every
+    // format renegotiation and usually gets the same layout back; they are
+    // replaced when the layout changes and freed with the core.
+    void deInitialize() {
+        mReady = false;
+    }
+
+    // MARK: - Bypass
+    // Parameter setters and getters may be called from any thread; process()
+    // latches the values once per call.
+    //
+    // Bypass crossfades (equal power, kBypassFadeSeconds) between the effect
+    // and the dry input; both paths run only during the fade. Once it is over
+    // bypass is a plain copy (or the oversampling latency delay) and the wet
+    // bus is cleared, so re-engaging starts from fresh state.
+    bool isBypassed() const {
+        return mBypassed.load();
+    }
+
+    void setBypass(bool shouldBypass) {
+        mBypassed.store(shouldBypass);
+    }
+
+    // Trails: on bypass the wet bus stops taking input but its delay, chorus
+    // and reverb tails ring out on top of the dry signal; the copy path takes
+    // over once they have decayed to silence. Latched when bypass engages.
+    bool bypassTrails() const {
+        return mBypassTrailsParam.load();
+    }
+
+    void setBypassTrails(bool shouldRingOut) {
+        mBypassTrailsParam.store(shouldRingOut);
+    }
+
+    // MARK: - Delay Time
+    float delayTime() const {
+        return mDelayTimeParam.load();
+    }
+
+    void setDelayTime(float delayTimeMs) {
+        mDelayTimeParam.store(delayTimeMs);
+    }
+
+    /*
+     Render thread only (host automation). Moves the delay time linearly from
+     wherever it is now to delayTimeMs over exactly durationFrames frames, or
+     with durationFrames = 0 jumps straight to it, bypassing the 20 ms
+     smoother, which is only for UI changes set with setDelayTime(). A later
+     setDelayTime() to a different value cancels the ramp and the smoother
+     takes over from the current position.
+     */
+    void rampDelayTime(float delayTimeMs, uint32_t durationFrames) {
+        mDelayTimeParam.store(delayTimeMs);
+        if (durationFrames == 0) {
+            mRampFramesLeft = 0;
+            mCurrentDelayMs = delayTimeMs;
+            settleDelayTime(delayTimeMs);
+            return;
+        }
+        mRampStartMs    = mCurrentDelayMs;
+        mRampTargetMs   = delayTimeMs;
+        mRampSlope      = (delayTimeMs - mCurrentDelayMs) / (float)durationFrames;
+        mRampElapsed    = 0;
+        mRampFramesLeft = (int)durationFrames;
+    }
+
+    /*
+     Render thread only. Queues a delay-time change (a jump, or a ramp when
+     rampFrames > 0) to land `offset` frames into the next process() call, so
+     dense automation renders in one pass instead of one call per event.
+     The result is the same as splitting the call at `offset` and calling
+     rampDelayTime() in between. Events must be queued in
+     time order; any at or past the end of the call apply after its last
+     frame. Returns false when the queue is full: the caller then splits.
+     */
+    bool scheduleDelayTime(uint32_t offset, float delayTimeMs, uint32_t rampFrames) {
+        if (mScheduledCount == kMaxScheduledEvents) return false;
+        mScheduled[mScheduledCount++] = { offset, delayTimeMs, rampFrames };
+        return true;
+    }
+
+    // Render thread. Applies whatever is still queued now; process() does this
+    // after its last frame. Call it before changing the delay time directly,
+    // so earlier queued events do not land after the change.
+    void flushScheduledEvents() {
+        if (mScheduledNext < mScheduledCount) applyScheduledEvents(UINT32_MAX, mCurrentDelayMs);
+        mScheduledCount = 0;
+        mScheduledNext  = 0;
+    }
+
+    // MARK: - Oversampling
+    // Compressor oversampling factor: 1 (off), 2 or 4. Any thread; process()
+    // applies a change at its next call, restarting the resampling filters.
+    int oversampling() const {
+        return mOversamplingParam.load();
+    }
+
+    void setOversampling(int factor) {
+        mOversamplingParam.store((factor >= 4) ? 4 : (factor >= 2) ? 2 : 1);
+    }
+
+    // Output delay, in frames, for the requested oversampling factor. Bypass
+    // is delayed by the same amount so toggling it does not shift the audio.
+    int latencySamples() const {
+        return Oversampler::latencyFor(oversampling());
+    }
+
+    // MARK: - Metering
+    // Render thread: publish everything rendered since the last call. The
+    // Audio Unit calls this once per render block.
+    void publishMeters() {
+        mMeters.publish();
+    }
+
+    // UI thread: levels since the previous read. Never blocks the render thread.
+    VXFissionMeterSnapshot readMeters() {
+        return mMeters.read();
+    }
+
+    // MARK: - Profiling
+    // Per-stage render timings (VXFissionExtensionProfiling.hpp), compiled in
+    // with VXFISSION_PROFILING=1; otherwise these do nothing. The Audio Unit
+    // brackets each render call so its timing covers pulling input and events;
+    // a process() outside such a bracket (offline tools) is a render by itself.
+    void beginRenderProfile() {
+#if VXFISSION_PROFILING
+        mProfiler.beginRender();
+#endif
+    }
+
+    void endRenderProfile(uint32_t frameCount) {
+#if VXFISSION_PROFILING
+        mProfiler.endRender(frameCount);
+#else
+        (void)frameCount;
+#endif
+    }
+
+    // Any thread.
+    std::string profileJSON() const {
+#if VXFISSION_PROFILING
+        return mProfiler.toJSON();
+#else
+        return "{ \"enabled\": false }\n";
+#endif
+    }
+
+    // Any thread; takes effect at the end of the next render.
+    void resetProfile() {
+#if VXFISSION_PROFILING
+        mProfiler.reset();
+#endif
+    }
+
+    // MARK: - Quality
+    /*
+     The wet bus's quality tier (VXFissionExtensionQuality.hpp): fixed, or
+     Auto for the governor to choose from each render's time against its
+     buffer's duration. Any thread; process() latches the mode once per call.
+     While rendering offline Auto is standard, untimed: a bounce's render time
+     says nothing about the realtime deadline. A switch crossfades over
+     kQualityFadeSeconds — the comb gains and the chorus read — and the
+     control interval changes at the next control point, between two ramps,
+     so nothing steps.
+     */
+    VXFissionQualityMode qualityMode() const {
+        return (VXFissionQualityMode)mQualityModeParam.load();
+    }
+
+    void setQualityMode(VXFissionQualityMode mode) {
+        mQualityModeParam.store((int)mode);
+    }
+
+    // Any thread: the tier process() last switched to.
+    VXFissionQualityTier qualityTier() const {
+        return (VXFissionQualityTier)mQualityTierOut.load();
+    }
+
+    // Not for use while rendering.
+    void setGovernorSettings(const VXFissionGovernorSettings &settings) {
+        mGovernor.setSettings(settings);
+    }
+
+    /*
+     The Audio Unit brackets each render call so the governor times all of
+     it, pulling input included; a process() outside such a bracket is timed
+     by itself. Only Auto is timed, and not while rendering offline.
+     */
+    void beginRenderTiming() {
+        if (renderedQualityMode() == VXFissionQualityMode::Auto) mGovernor.beginRender();
+    }
+
+    void endRenderTiming(uint32_t frameCount) {
+        if (mGovernor.renderOpen()) mGovernor.endRender(frameCount);
+    }
+
+    // MARK: - Reverb Engine
+    /*
+     The wet bus's reverb: the Freeverb bank, or convolution with a room
+     impulse response (VXFissionExtensionConvolution.hpp), the synthetic room
+     until one is loaded. The engine, the response and the convolution tail's
+     thread are not for use while rendering and apply from the next
+     initialize(). The tail runs on the render thread unless moved to a
+     worker, so a render is the same every time; the Audio Unit moves it
+     there, and waits for it while rendering offline (see below).
+     */
+    VXFissionReverbEngine reverbEngine() const {
+        return mReverbEngine;
+    }
+
+    void setReverbEngine(VXFissionReverbEngine engine) {
+        mReverbEngine = engine;
+    }
+
+    const VXFissionImpulseResponse &impulseResponse() const {
+        return mImpulseResponse;
+    }
+
+    // At any rate: it is resampled to the session's. Empty for the synthetic room.
+    void setImpulseResponse(VXFissionImpulseResponse response) {
+        mImpulseResponse = std::move(response);
+        ++mImpulseVersion;
+    }
+
+    ConvolutionTailThread convolutionTailThread() const {
+        return mTailThread;
+    }
+
+    void setConvolutionTailThread(ConvolutionTailThread thread) {
+        mTailThread = thread;
+    }
+
+    // The engine as initialised, for its partitioning and late-block counts.
+    const ConvolutionReverb &convolution() const {
+        return mConvolution;
+    }
+
+    // MARK: - Rendering Offline
+    /*
+     Set while the host renders faster or slower than realtime, as for a
+     bounce; hosts may switch it with the core initialised. Any thread;
+     process() latches it once per call. While set, a convolution tail on its
+     worker is waited for instead of skipped when late, so the render matches
+     one with the tail inline, and Auto quality renders at standard.
+     */
+    bool renderingOffline() const {
+        return mRenderingOffline.load();
+    }
+
+    void setRenderingOffline(bool offline) {
+        mRenderingOffline.store(offline);
+    }
+
+    // MARK: - Max Frames
+    uint32_t maximumFramesToRender() const {
+        return mMaxFramesToRender;
+    }
+
+    void setMaximumFramesToRender(uint32_t maxFrames) {
+        mMaxFramesToRender = maxFrames;
+    }
+
+    double sampleRate() const {
+        return mSampleRate;
+    }
+
+    // MARK: - Control Rate
+    // Frames between control-rate updates of the smoothed delay, LFO and mix
+    // gains at the standard tier (eco takes 4× as long, high a quarter). 1
+    // recomputes them every frame. Not for use while rendering.
+    int controlInterval() const {
+        return mBaseControlInterval;
+    }
+
+    void setControlInterval(int frames) {
+        mBaseControlInterval = std::clamp(frames, 1, kMaxControlInterval);
+        configureControlRate();
+    }
+
+    // MARK: - Channels
+    // Channels rendered since initialize(): the output count, at least 2.
+    int channelCount() const {
+        return mChannels;
+    }
+
+    const VXFissionChannelMap &channelMap() const {
+        return mChannelMap;
+    }
+
+    // Not for use while rendering. A map for the current channel count applies
+    // at once; otherwise it is kept for an initialize() with that count, and
+    // any other count uses VXFissionChannelMap::defaultFor().
+    void setChannelMap(const VXFissionChannelMap &map) {
+        mChannelMap = map;
+        if (map.count == mChannels) applyChannelMap();
+    }
+
+    // MARK: - State
+    /*
+     Snapshots of the running state between process() calls, for offline
+     renders that checkpoint and resume (see VXFissionExtensionState.hpp).
+     Everything that carries from one frame to the next is included — rings,
+     reverb, compressor and resampling filters, smoothers, LFO, ramps, bypass
+     and sleep state, quality tier and its crossfades — along with the
+     delay-time, bypass, trails and quality parameters. Meters, profiling and
+     the governor's load history are not. A snapshot restores only into a core
+     initialised with the same rate, channel layout, block capacity,
+     oversampling, control interval, channel map, reverb engine and impulse
+     response: restoreState() returns false and changes nothing otherwise. A
+     restored core renders exactly what the saved one would have, unless the
+     convolution tail runs on its worker and the worker is late. Allocates;
+     not for the render thread.
+     */
+    std::vector<uint8_t> saveState() const {
+        std::vector<uint8_t> bytes;
+        saveState(bytes);
+        return bytes;
+    }
+
+    // Replaces the contents of bytes, reusing its allocation.
+    void saveState(std::vector<uint8_t> &bytes) const {
+        bytes.clear();
+        VXFissionStateWriter writer(bytes);
+        writer.value(stateLayout(0));
+        writer.value(mDelayTimeParam.load());
+        writer.value(mBypassed.load());
+        writer.value(mBypassTrailsParam.load());
+        writer.value(mOversamplingParam.load());
+        writer.value(mQualityModeParam.load());
+        writeStateBody(writer);
+        const uint64_t total = bytes.size();
+        std::memcpy(bytes.data() + offsetof(StateLayout, totalBytes), &total, sizeof(total));
+    }
+
+    bool restoreState(std::span<const uint8_t> bytes) {
+        VXFissionStateReader reader(bytes);
+        StateLayout layout;
+        reader.value(layout);
+        if (!reader.ok() || !(layout == stateLayout(bytes.size()))) return false;
+
+        float delayTimeMs  = 0.0f;
+        bool  bypassed     = false;
+        bool  trails       = false;
+        int   oversampling = 1;
+        int   qualityMode  = 0;
+        reader.value(delayTimeMs);
+        reader.value(bypassed);
+        reader.value(trails);
+        reader.value(oversampling);
+        reader.value(qualityMode);
+        mDelayTimeParam.store(delayTimeMs);
+        mBypassed.store(bypassed);
+        mBypassTrailsParam.store(trails);
+        mOversamplingParam.store(oversampling);
+        mQualityModeParam.store(qualityMode);
+        readStateBody(reader);
+        mQualityTierOut.store((int)mQualityTier);
+        if (mQualityModeLatched == VXFissionQualityMode::Auto) mGovernor.restart(mQualityTier);
+        mRendered = true;
+        return reader.ok();
+    }
+
+    /*
+     Moves the control-rate clocks — the chorus LFO's phase and the position
+     within the control interval — to where they would be after `frame`
+     frames rendered since initialize(). The signal state is left alone. A
+     render that starts partway through a timeline seeks first, so its chorus
+     sweep lines up with a render of the whole (at a fixed quality tier: the
+     interval is the current tier's throughout).
+     */
+    void seek(uint64_t frame) {
+        const uint64_t interval = (uint64_t)mControlInterval;
+        const uint64_t steps    = (frame + interval - 1) / interval;  // control points already passed
+        mControlPhase = (steps > 0) ? (int)(frame - (steps - 1) * interval) : mControlInterval;
+        mLFO.setPhase(std::fmod((double)steps * lfoStep(), 2.0 * M_PI));
+    }
+
+    // MARK: - Process
+    /*
+     Renders in sub-blocks of at most mBlockCapacity frames. Each stage runs
+     over the whole sub-block into preallocated scratch before the next stage
+     starts, so every loop touches only the state it needs and the stateless
+     ones can vectorise.
+
+     In place is safe: output c may be input c (and, with a mono input, output
+     0 may be the one input). Every input frame of a sub-block is consumed —
+     written to the rings, copied or mixed into the wet scratch — before the
+     compressor writes any output frame, and the paths that write straight
+     from input (bypass, asleep) go from the highest channel down.
+
+     The call runs with denormals flushed to zero, restoring the caller's FPU
+     mode on return (see VXFissionExtensionDenormals.hpp).
+     */
+    void process(std::span<float const*> inputBuffers, std::span<float *> outputBuffers, uint32_t frameCount) {
+        const ScopedFlushDenormals flushDenormals;
+        const bool timed = !mGovernor.renderOpen() && renderedQualityMode() == VXFissionQualityMode::Auto;
+        if (timed) mGovernor.beginRender();
+#if VXFISSION_PROFILING
+        const bool standalone = !mProfiler.renderOpen();
+        if (standalone) mProfiler.beginRender();
+        VXFISSION_PROFILE_STAGE(mProfiler, VXFissionStage::Process, processSegment(inputBuffers, outputBuffers, frameCount));
+        if (standalone) mProfiler.endRender(frameCount);
+#else
+        processSegment(inputBuffers, outputBuffers, frameCount);
+#endif
+        flushScheduledEvents();
+        if (timed) mGovernor.endRender(frameCount);
+    }
+
+    // True when the last process() call wrote nothing but zeros, so the host
+    // can be told via kAudioUnitRenderAction_OutputIsSilence.
+    bool outputIsSilent() const {
+        return mOutputIsSilent;
+    }
+
+    // One process() call's worth of rendering, in sub-blocks.
+    void processSegment(std::span<float const*> inputBuffers, std::span<float *> outputBuffers, uint32_t frameCount) {
+        int numIn  = (int)inputBuffers.size();
+        int numOut = (int)outputBuffers.size();
+
+        mOutputIsSilent = false;
+        if (numIn == 0 || numOut == 0) return;
+        if (!mReady) return;
+        mRendered = true;
+        mConvolution.setWaitsForTail(mRenderingOffline.load());
+
+        mDelayTimeMs = mDelayTimeParam.load();
+        if (mRampFramesLeft > 0 && mDelayTimeMs != mRampTargetMs) cancelParameterRamp();
+
+        const int oversamplingFactor = mOversamplingParam.load();
+        if (oversamplingFactor != mCompressor.oversampling()) mCompressor.setOversampling(oversamplingFactor);
+        const int latency = mCompressor.latency();
+        updateQualityTier();
+
+        // Input samples with mono upmix: channel c reads input min(c, numIn - 1),
+        // and only the first input when initialised for a mono one. Outputs
+        // beyond the initialised channel count are left alone.
+        const int channels = mChannels;
+        const int inputs   = mMonoInput ? 1 : numIn;
+        numOut = std::min(numOut, channels);
+        const float *in[kMaxChannels];
+        float       *out[kMaxChannels];
+        for (int c = 0; c < channels; ++c) in[c]  = inputBuffers[std::min(c, inputs - 1)];
+        for (int c = 0; c < numOut;   ++c) out[c] = outputBuffers[c];
+
+        const bool bypass = mBypassed.load();
+        if (bypass != mBypassEngaged) {
+            // A fade starts (or reverses from where it is).
+            mBypassEngaged = bypass;
+            if (bypass) {
+                mFadeTrails    = mBypassTrailsParam.load();
+                mTrailsRinging = mFadeTrails;
+            }
+        }
+        // Sub-blocks of the effect, of a bypass fade, then (once bypass has
+        // fully engaged) the copy path for the rest. A fade sub-block ends on
+        // the fade's last frame, so where a call is split changes nothing.
+        bool silent = true;
+        const float *inBlock[kMaxChannels];
+        float       *outBlock[kMaxChannels];
+        for (uint32_t done = 0; done < frameCount; ) {
+            const bool fading = bypass ? (mBypassPosition < mBypassFadeFrames || mTrailsRinging)
+                                       : (mBypassPosition > 0);
+            if (bypass && !fading) {
+                renderBypassed(in, out, numOut, done, frameCount - done, latency);
+                silent = false;
+                break;
+            }
+            int n = (int)std::min(frameCount - done, mBlockCapacity);
+            if (fading && !bypass)                           n = std::min(n, mBypassPosition);
+            if (fading && mBypassPosition < mBypassFadeFrames) n = std::min(n, mBypassFadeFrames - mBypassPosition);
+            for (int c = 0; c < channels; ++c) inBlock[c]  = in[c] + done;
+            for (int c = 0; c < numOut;   ++c) outBlock[c] = out[c] + done;
+            mBlockStart = done;
+            if (fading) {
+                silent &= processBypassFade(inBlock, outBlock, numOut, n, latency);
+            } else {
+                // Keep the bypass path primed, so engaging it mid-stream stays aligned.
+                if (latency > 0) {
+                    for (int c = 0; c < numOut; ++c) mBypassDelay[c].push(inBlock[c], n);
+                }
+                silent &= (this->*mProcessBlock)(inBlock, outBlock, numOut, n);
+            }
+            done += (uint32_t)n;
+        }
+        mOutputIsSilent = silent;
+
+        if (silent) mMeters.addSilence((int)frameCount);
+        else        mMeters.addOutput(out[0], out[std::min(1, numOut - 1)], (int)frameCount);
+    }
+
+    // Fully bypassed from frame `start` of the call: the input, delayed by the
+    // oversampling latency, as a block copy.
+    void renderBypassed(const float *const *in, float *const *out, int numOut, uint32_t start, uint32_t n, int latency) {
+        // Queued events still land in order, so a ramp keeps its timing.
+        uint32_t position = start;
+        while (nextScheduledOffset() < start + n) {
+            skipParameterRamp((int)(std::max(nextScheduledOffset(), position) - position));
+            position = std::max(nextScheduledOffset(), position);
+            applyScheduledEvents(position, mCurrentDelayMs);
+        }
+        skipParameterRamp((int)(start + n - position));
+        // Highest channel first: with an upmixed input aliasing output 0,
+        // every other channel reads it before channel 0 is written.
+        for (int c = numOut - 1; c >= 0; --c) {
+            if (latency > 0) {
+                mBypassDelay[c].process(in[c] + start, out[c] + start, (int)n, latency);
+            } else if (out[c] != in[c]) {
+                std::copy_n(in[c] + start, n, out[c] + start);
+            }
+        }
+    }
+
+    // MARK: - Block Stages
+    /*
+     One sub-block of the effect for a channel layout: kChannels is the
+     channel count, or 0 for mChannels; kMonoInput means every in[c] is the
+     same input and there is one Haas ring. Returns true if the block's output
+     is all zeros.
+     */
+    template <int kChannels, bool kMonoInput>
+    bool processBlock(const float *const *in, float *const *out, int numOut, int n) {
+        VXFISSION_PROFILE_STAGE(mProfiler, VXFissionStage::Control, updateControl(n));
+        mCurrentDelayMs = mSmoothedBlock[n - 1];
+
+        // Once the input has been silent for longer than the rings hold and the
+        // reverb tail has gone to sleep, every wet-bus stage would only add
+        // silence to the dry signal, so the whole bus is skipped.
+        const int channels = kChannels ? kChannels : mChannels;
+        float inputPeak = peakAbs(in[0], n);
+        for (int c = 1; c < (kMonoInput ? 1 : channels); ++c) {
+            if (in[c] == in[c - 1]) continue;  // upmixed: same input
+            inputPeak = std::max(inputPeak, peakAbs(in[c], n));
+        }
+        mSilentInputFrames = (inputPeak <= kSilenceThreshold) ? std::min(mSilentInputFrames + n, mRingSize) : 0;
+        if (mReverbAsleep && mSilentInputFrames >= mRingSize) {
+            renderAsleep(in, out, numOut, n);
+            mWriteHead = wrapRing(mWriteHead + n);
+            return inputPeak == 0.0f;
+        }
+        mWetBusAsleep = false;
+
+        VXFISSION_PROFILE_STAGE(mProfiler, VXFissionStage::Write,  writeDelayLines<kChannels, kMonoInput>(in, n));
+        VXFISSION_PROFILE_STAGE(mProfiler, VXFissionStage::Haas,   readHaas<kChannels>(in, n));
+        VXFISSION_PROFILE_STAGE(mProfiler, VXFissionStage::Chorus, applyChorus<kChannels, kMonoInput>(n));
+        VXFISSION_PROFILE_STAGE(mProfiler, VXFissionStage::Reverb, applyReverb<kChannels>(n));
+        VXFISSION_PROFILE_STAGE(mProfiler, VXFissionStage::Mix,    mixAndCompress<kChannels>(in, out, numOut, n));
+        mWriteHead = wrapRing(mWriteHead + n);
+        return false;
+    }
+
+    /*
+     A sub-block during a bypass fade, or while trails ring out. The dry path
+     (input, delayed by the oversampling latency) goes to scratch first, so
+     in-place rendering stays safe, then the effect renders and the two are
+     blended with the fade gains. Going into bypass without trails the
+     effect's output fades, cutting its tails. Otherwise its input does: with
+     trails the tails it holds keep sounding, and coming out of bypass the
+     rings and reverb fill with a faded-in signal, so the Haas and chorus
+     reads do not start on a step when the first input reaches them.
+     Returns true if the block's output is all zeros.
+     */
+    bool processBypassFade(const float *const *in, float *const *out, int numOut, int n, int latency) {
+        float dryPeak = 0.0f;
+        for (int c = numOut - 1; c >= 0; --c) {
+            float *dry = bypassDryBlock(c);
+            if (latency > 0) mBypassDelay[c].process(in[c], dry, n, latency);
+            else             std::copy_n(in[c], n, dry);
+            dryPeak = std::max(dryPeak, peakAbs(dry, n));
+        }
+
+        const int direction = mBypassEngaged ? 1 : -1;
+        for (int f = 0; f < n; ++f) {
+            mBypassPosition   = std::clamp(mBypassPosition + direction, 0, mBypassFadeFrames);
+            mFadeWetBlock[f]  = mBypassFade[mBypassFadeFrames - mBypassPosition];
+            mFadeDryBlock[f]  = mBypassFade[mBypassPosition];
+        }
+
+        bool wetSilent;
+        if (mFadeTrails || !mBypassEngaged) {
+            const float *wetIn[kMaxChannels];
+            for (int c = 0; c < mChannels; ++c) {
+                if (mMonoInput && c > 0) {
+                    wetIn[c] = wetIn[0];
+                    continue;
+                }
+                float *x = bypassInBlock(c);
+                for (int f = 0; f < n; ++f) x[f] = in[c][f] * mFadeWetBlock[f];
+                wetIn[c] = x;
+            }
+            wetSilent = (this->*mProcessBlock)(wetIn, out, numOut, n);
+            for (int c = 0; c < numOut; ++c) {
+                const float *dry = bypassDryBlock(c);
+                float       *y   = out[c];
+                for (int f = 0; f < n; ++f) y[f] += dry[f] * mFadeDryBlock[f];
+            }
+        } else {
+            wetSilent = (this->*mProcessBlock)(in, out, numOut, n);
+            for (int c = 0; c < numOut; ++c) {
+                const float *dry = bypassDryBlock(c);
+                float       *y   = out[c];
+                for (int f = 0; f < n; ++f) y[f] = y[f] * mFadeWetBlock[f] + dry[f] * mFadeDryBlock[f];
+            }
+        }
+
+        if (mBypassEngaged && mBypassPosition == mBypassFadeFrames) {
+            // Fully bypassed: without trails the effect is done with now; with
+            // them, once the bus has slept through a whole block.
+            if (!mFadeTrails) resetWetBus();
+            else if (wetSilent) mTrailsRinging = false;
+        } else if (!mBypassEngaged && mBypassPosition == 0) {
+            mTrailsRinging = false;
+        }
+        return wetSilent && dryPeak == 0.0f;
+    }
+
+    // Puts the wet bus to sleep with cleared state, as after initialize(),
+    // so coming out of bypass does not replay audio from before it.
+    void resetWetBus() {
+        for (int c = 0; c < mRingCount; ++c) mArena.clear(mDelayLine[c]);
+        std::fill(std::begin(mHaasState), std::end(mHaasState), typename HaasInterpolator::State {});
+        sleepReverb();
+        mCompressor.reset();
+        mSilentInputFrames = mRingSize;
+        mBusClosedFrames   = 0;
+        mWetBusAsleep      = true;
+    }
+
+    // Wet bus asleep: only the dry half of the gain-compensated blend remains.
+    // The LFO keeps running in updateControl() and the compressor envelope is
+    // advanced in closed form, so both wake up where they would have been.
+    void renderAsleep(const float *const *in, float *const *out, int numOut, int n) {
+        if (!mWetBusAsleep) {
+            // The rings only hold sub-threshold samples by now; clear them so
+            // the Haas and chorus reads wake up on true silence.
+            for (int c = 0; c < mRingCount; ++c) mArena.clear(mDelayLine[c]);
+            std::fill(std::begin(mHaasState), std::end(mHaasState), typename HaasInterpolator::State {});
+            mCompressor.resetFilters();
+            mWetBusAsleep = true;
+        }
+        mCompressor.decay(n);
+
+        // Highest channel first, as in bypass, so an aliased upmix is safe.
+        for (int c = numOut - 1; c >= 0; --c) {
+            const float *x = in[c];
+            float       *y = out[c];
+            for (int f = 0; f < n; ++f) y[f] = x[f] * mDryGainBlock[f];
+        }
+    }
+
+    // Copies the map's weights into the per-channel arrays.
+    void applyChannelMap() {
+        for (int c = 0; c < kMaxChannels; ++c) {
+            mHaasWeight[c] = mChannelMap.haasWeight[c];
+            mIsLFE[c]      = mChannelMap.lfe[c];
+        }
+    }
+
+    float *wetBlock(int channel) {
+        return mWetBlock.data() + (size_t)channel * mWetStride;
+    }
+
+    float *bypassDryBlock(int channel) {
+        return mBypassDryBlock.data() + (size_t)channel * mWetStride;
+    }
+
+    float *bypassInBlock(int channel) {
+        return mBypassInBlock.data() + (size_t)channel * mWetStride;
+    }
+
+    int wrapRing(int index) const {
+        return index & mRingMask;
+    }
+
+    // Every tier's control rate, worked out here so a switch on the render
+    // thread is a copy; then the current one's.
+    void configureControlRate() {
+        for (int t = 0; t < kQualityTiers; ++t) {
+            const int interval = tierControlInterval((VXFissionQualityTier)t);
+            TierControlRate &rate = mTierControlRate[t];
+            rate.interval = interval;
+            rate.inverse  = 1.0f / (float)interval;
+            // The one-pole smoother's response over a whole interval.
+            rate.smoothingDecay = std::pow(1.0f - mSmoothingCoeff, (float)interval);
+            rate.lfo.setStep(2.0 * M_PI * 0.8 * interval / mSampleRate);
+        }
+        useControlRate(mControlTier);
+    }
+
+    int tierControlInterval(VXFissionQualityTier tier) const {
+        switch (tier) {
+            case VXFissionQualityTier::Eco:  return std::min(mBaseControlInterval * 4, kMaxControlInterval);
+            case VXFissionQualityTier::High: return std::max(mBaseControlInterval / 4, 1);
+            default:                         return mBaseControlInterval;
+        }
+    }
+
+    // Starts a fresh interval at `tier`'s rate; the LFO keeps its phase.
+    void useControlRate(VXFissionQualityTier tier) {
+        const TierControlRate &rate = mTierControlRate[(int)tier];
+        mControlTier            = tier;
+        mControlInterval        = rate.interval;
+        mInverseControlInterval = rate.inverse;
+        mSmoothingDecay         = rate.smoothingDecay;
+        mLFO.rotCos             = rate.lfo.rotCos;
+        mLFO.rotSin             = rate.lfo.rotSin;
+        mControlPhase           = mControlInterval;
+    }
+
+    // Chorus LFO: 0.8 Hz, in radians per control interval.
+    double lfoStep() const {
+        return 2.0 * M_PI * 0.8 * mControlInterval / mSampleRate;
+    }
+
+    // Chorus: 15 ms base ± 5 ms depth (fixed within the wet bus), in samples,
+    // kept clear of both ends of the ring for the interpolated read.
+    float chorusDelaySamples(float lfo) const {
+        float samples = (15.0f + lfo * 5.0f) * mMsToSamples;
+        return std::max(1.0f, std::min(samples, (float)(mDelayLength - 2)));
+    }
+
+    // Control points: step the smoother, LFO and mix gains one whole interval
+    // ahead. Everything between is a linear ramp, so no value ever jumps.
+    void retargetControl() {
+        if (mRampFramesLeft > 0) {
+            // Host ramp: where the automation will be one interval from now.
+            mSmoothedDelayTimeMs = (mRampFramesLeft > mControlInterval)
+                ? mRampStartMs + mRampSlope * (float)(mRampElapsed + mControlInterval)
+                : mRampTargetMs;
+        } else {
+            mSmoothedDelayTimeMs = mDelayTimeMs + flushDenormal((mSmoothedDelayTimeMs - mDelayTimeMs) * mSmoothingDecay);
+        }
+        mDelayRamp.retarget(mSmoothedDelayTimeMs, mInverseControlInterval);
+
+        mLFO.advance();
+        mChorusDelayRamp.retarget(chorusDelaySamples(mLFO.sine), mInverseControlInterval);
+
+        // === Master dry/wet blend (gain-compensated parallel) ===
+        // Dry stays at full level; wet is added on top and the sum is
+        // normalised by (1 + masterMix) to compensate for the added energy.
+        // Preserves the weight of the dry signal across the full knob range.
+        float masterMix = std::sqrt(std::abs(mSmoothedDelayTimeMs) / 50.0f);
+        float dryGain   = 1.0f / (1.0f + masterMix);
+        mDryGainRamp.retarget(dryGain, mInverseControlInterval);
+        mWetGainRamp.retarget(masterMix * dryGain, mInverseControlInterval);
+    }
+
+    // Smooth target → current, moving the read head gradually to avoid
+    // discontinuities. Values are exact at each control point and linearly
+    // interpolated between them; control points run on their own grid, so
+    // block size does not change the result.
+    //
+    // Queued delay-time events land at their frame: a run stops short of the
+    // next one, which then applies before the frames after it are computed.
+    void updateControl(int n) {
+        for (int f = 0; f < n; ) {
+            const uint32_t position = mBlockStart + (uint32_t)f;
+            if (nextScheduledOffset() <= position) {
+                applyScheduledEvents(position, (f > 0) ? mSmoothedBlock[f - 1] : mCurrentDelayMs);
+            }
+            if (mControlPhase == mControlInterval) {
+                // A tier switch changes the interval here, between two ramps.
+                if (mControlTier != mQualityTier) useControlRate(mQualityTier);
+                retargetControl();
+                mControlPhase = 0;
+            }
+            int run = std::min(n - f, mControlInterval - mControlPhase);
+            run     = (int)std::min<uint32_t>((uint32_t)run, nextScheduledOffset() - position);
+            for (int k = 0; k < run; ++k) {
+                int j = mControlPhase + k + 1;
+                mSmoothedBlock[f + k]    = mDelayRamp.at(j);
+                mChorusDelayBlock[f + k] = mChorusDelayRamp.at(j);
+                mDryGainBlock[f + k]     = mDryGainRamp.at(j);
+                mWetGainBlock[f + k]     = mWetGainRamp.at(j);
+            }
+            if (mRampFramesLeft > 0) applyParameterRamp(f, run);
+            f             += run;
+            mControlPhase += run;
+        }
+    }
+
+    // Overwrites the interpolated delay time with the exact host ramp, so
+    // automation is sample-accurate even where the ramp starts or ends
+    // between control points. The mix gains keep following at control rate.
+    void applyParameterRamp(int first, int run) {
+        int m = std::min(run, mRampFramesLeft);
+        for (int k = 0; k < m; ++k) {
+            mSmoothedBlock[first + k] = mRampStartMs + mRampSlope * (float)(mRampElapsed + k + 1);
+        }
+        mRampElapsed    += m;
+        mRampFramesLeft -= m;
+        if (mRampFramesLeft > 0) return;
+
+        // Land exactly on the target and hold it for the rest of the interval.
+        std::fill(mSmoothedBlock.begin() + first + m - 1, mSmoothedBlock.begin() + first + run, mRampTargetMs);
+        settleDelayTime(mRampTargetMs);
+    }
+
+    // MARK: Scheduled Events
+    // Offset of the next queued event in the current process() call, or
+    // UINT32_MAX when there is none.
+    uint32_t nextScheduledOffset() const {
+        return (mScheduledNext < mScheduledCount) ? mScheduled[mScheduledNext].offset : UINT32_MAX;
+    }
+
+    // Applies every queued event due by `position`, as the host adapter would
+    // between two process() calls: set the target, then latch it as process()
+    // does. currentMs is the delay time of the last rendered frame.
+    void applyScheduledEvents(uint32_t position, float currentMs) {
+        mCurrentDelayMs = currentMs;
+        while (mScheduledNext < mScheduledCount && mScheduled[mScheduledNext].offset <= position) {
+            const ScheduledDelayTime &event = mScheduled[mScheduledNext++];
+            rampDelayTime(event.valueMs, event.rampFrames);
+        }
+        mDelayTimeMs = mDelayTimeParam.load();
+        if (mRampFramesLeft > 0 && mDelayTimeMs != mRampTargetMs) cancelParameterRamp();
+    }
+
+    // Bypassed: the ramp keeps time so it is not resumed half-way later.
+    void skipParameterRamp(int n) {
+        if (mRampFramesLeft == 0) return;
+        int m = std::min(n, mRampFramesLeft);
+        mRampElapsed    += m;
+        mRampFramesLeft -= m;
+        mCurrentDelayMs  = mRampStartMs + mRampSlope * (float)mRampElapsed;
+        if (mRampFramesLeft == 0) {
+            mCurrentDelayMs = mRampTargetMs;
+            settleDelayTime(mRampTargetMs);
+        }
+    }
+
+    // A jump arrived mid-ramp: the smoother continues from where the ramp got to.
+    void cancelParameterRamp() {
+        mRampFramesLeft = 0;
+        settleDelayTime(mCurrentDelayMs);
+    }
+
+    // Holds the smoothed delay at valueMs until the next control point.
+    void settleDelayTime(float valueMs) {
+        mSmoothedDelayTimeMs = valueMs;
+        mDelayRamp.reset(valueMs);
+    }
+
+    // Always write every ring so the buffers are current for whichever
+    // channels become the delayed ones (avoids stale-data clicks when the sign
+    // flips and the delayed side switches). The whole sub-block goes in
+    // before any read, which the ring headroom set up in initialize() allows.
+    // A mono input's one ring is written whatever the channel map says.
+    template <int kChannels, bool kMonoInput>
+    void writeDelayLines(const float *const *in, int n) {
+        int first = std::min(n, mRingSize - mWriteHead);
+        const int rings = kMonoInput ? 1 : (kChannels ? kChannels : mChannels);
+        for (int c = 0; c < rings; ++c) {
+            if (!kMonoInput && mIsLFE[c]) continue;
+            DelaySample *ring = mArena.data(mDelayLine[c]);
+            encodeDelaySamples(in[c], ring + mWriteHead, (size_t)first);
+            encodeDelaySamples(in[c] + first, ring, (size_t)(n - first));
+        }
+    }
+
+    // === Wet bus: full Haas delay ===
+    // The read head moves continuously with the smoothed delay instead of in
+    // whole-sample steps, so a moving knob does not zipper. Channel c is
+    // delayed while delayTime × its Haas weight is positive; the others pass
+    // straight onto the wet bus.
+    template <int kChannels>
+    void readHaas(const float *const *in, int n) {
+        // Bus send amount: 0 at centre, 1.0 at full deflection.
+        for (int f = 0; f < n; ++f) mBusBlock[f] = std::abs(mSmoothedBlock[f]) / 50.0f;
+
+        const float maxDelay = (float)(mDelayLength - 1);
+        for (int c = 0; c < (kChannels ? kChannels : mChannels); ++c) {
+            const float *x      = in[c];
+            float       *wet    = wetBlock(c);
+            const float  weight = mHaasWeight[c];
+            typename HaasInterpolator::State &state = mHaasState[c];
+
+            if (mIsLFE[c] || weight == 0.0f) {
+                std::copy_n(x, n, wet);
+                for (int f = 0; f < n; ++f) HaasInterpolator::follow(state, x[f]);
+                continue;
+            }
+            const DelaySample *ring = mArena.data(mDelayLine[c]);
+            for (int f = 0; f < n; ++f) {
+                float delayMs = mSmoothedBlock[f] * weight;
+                if (delayMs > 0.001f) {
+                    float delay = std::min(delayMs * mMsToSamples, maxDelay);
+                    wet[f] = HaasInterpolator::read(ring, mRingMask, wrapRing(mWriteHead + f), delay, state);
+                } else {
+                    wet[f] = x[f];
+                    HaasInterpolator::follow(state, x[f]);
+                }
+            }
+        }
+    }
+
+    // === Chorus on the wet bus ===
+    // With a mono input every channel would read the same ring at the same
+    // LFO delay, so the chorus tap is read once, into the reverb feed's
+    // scratch (not filled until applyReverb()), and blended into each.
+    //
+    // The tap is linear, or Hermite at the high tier; switching between them
+    // reads both and crossfades (mChorusBlend is the Hermite share).
+    enum class ChorusRead { Linear, Hermite, Blend };
+
+    template <int kChannels, bool kMonoInput>
+    void applyChorus(int n) {
+        if (mChorusBlend != mChorusBlendTarget) {
+            applyChorus<kChannels, kMonoInput, ChorusRead::Blend>(n);
+            const float step = (float)n / (float)mQualityFadeFrames;
+            mChorusBlend = (mChorusBlendTarget > mChorusBlend) ? std::min(mChorusBlend + step, mChorusBlendTarget)
+                                                               : std::max(mChorusBlend - step, mChorusBlendTarget);
+        } else if (mChorusBlend == 0.0f) {
+            applyChorus<kChannels, kMonoInput, ChorusRead::Linear>(n);
+        } else {
+            applyChorus<kChannels, kMonoInput, ChorusRead::Hermite>(n);
+        }
+    }
+
+    template <int kChannels, bool kMonoInput, ChorusRead kRead>
+    void applyChorus(int n) {
+        const float *shared = nullptr;
+        if constexpr (kMonoInput) {
+            float *tap = mReverbInBlock.data();
+            readChorus<kRead>(mArena.data(mDelayLine[0]), tap, n);
+            shared = tap;
+        }
+        for (int c = 0; c < (kChannels ? kChannels : mChannels); ++c) {
+            if (mIsLFE[c]) continue;
+            const DelaySample *ring = mArena.data(mDelayLine[c]);
+            float             *wet  = wetBlock(c);
+            for (int f = 0; f < n; ++f) {
+                if (mBusBlock[f] <= 0.001f) continue;
+                float chorus = kMonoInput ? shared[f] : chorusTap<kRead>(ring, f);
+
+                // Blend chorus into the wet bus at a fixed 25 % ratio.
+                wet[f] = wet[f] * 0.75f + chorus * 0.25f;
+            }
+        }
+    }
+
+    // The ring at frame f's LFO-swept delay, from the control-rate ramp.
+    template <ChorusRead kRead>
+    float chorusTap(const DelaySample *ring, int f) const {
+        const float delay = mChorusDelayBlock[f];
+        const int   now   = wrapRing(mWriteHead + f);
+        LinearInterpolator::State  linearState;
+        HermiteInterpolator::State hermiteState;
+        if constexpr (kRead == ChorusRead::Linear) {
+            return LinearInterpolator::read(ring, mRingMask, now, delay, linearState);
+        } else if constexpr (kRead == ChorusRead::Hermite) {
+            return HermiteInterpolator::read(ring, mRingMask, now, delay, hermiteState);
+        } else {
+            const float linear  = LinearInterpolator::read(ring, mRingMask, now, delay, linearState);
+            const float hermite = HermiteInterpolator::read(ring, mRingMask, now, delay, hermiteState);
+            const float step    = (mChorusBlendTarget > mChorusBlend) ? 1.0f : -1.0f;
+            const float blend   = std::clamp(mChorusBlend + step * (float)(f + 1) / (float)mQualityFadeFrames, 0.0f, 1.0f);
+            return linear + blend * (hermite - linear);
+        }
+    }
+
+    template <ChorusRead kRead>
+    void readChorus(const DelaySample *ring, float *tap, int n) const {
+        for (int f = 0; f < n; ++f) tap[f] = chorusTap<kRead>(ring, f);
+    }
+
+    // === Reverb on the wet bus ===
+    // The bank runs on every frame while awake, fed silence where the bus is
+    // shut, so a tail keeps decaying instead of freezing and bursting out when
+    // the bus reopens. It sleeps (skipped entirely) once its tail has decayed or
+    // the bus has been shut long enough that the tail is no longer mixed in.
+    template <int kChannels>
+    void applyReverb(int n) {
+        // Classic Freeverb approach: mono-sum into comb bank, stereo spread
+        // comes from the slightly different delay times in L vs R combs. The
+        // convolution engine takes the same feed, its stereo from the response.
+        const int channels = kChannels ? kChannels : mChannels;
+        float *feed     = mReverbInBlock.data();
+        int    summed   = 0;
+        for (int c = 0; c < channels; ++c) {
+            if (mIsLFE[c]) continue;
+            const float *wet = wetBlock(c);
+            if (summed++ == 0) std::copy_n(wet, n, feed);
+            else               for (int f = 0; f < n; ++f) feed[f] += wet[f];
+        }
+        const float average = (summed > 0) ? 1.0f / (float)summed : 0.0f;
+        bool busOpen = false;
+        for (int f = 0; f < n; ++f) {
+            bool open = mBusBlock[f] > 0.001f;
+            feed[f]   = open ? feed[f] * average : 0.0f;
+            busOpen  |= open;
+        }
+        mBusClosedFrames = busOpen ? 0 : std::min(mBusClosedFrames + n, mBusCloseFlushFrames);
+
+        float feedPeak = peakAbs(mReverbInBlock.data(), n);
+        if (mReverbAsleep) {
+            if (feedPeak <= kTailThreshold) return;
+            mReverbAsleep      = false;
+            mReverbQuietFrames = 0;
+        }
+
+        if (mLayoutReverbEngine == VXFissionReverbEngine::Convolution) {
+            mConvolution.process(mReverbInBlock.data(), mReverbBlockL.data(), mReverbBlockR.data(), n);
+        } else {
+            mReverb.process(mArena, mReverbInBlock.data(), mReverbBlockL.data(), mReverbBlockR.data(), n);
+        }
+
+        // Blend reverb into the wet bus at 3%: left-weighted channels take the
+        // left return, right-weighted the right, centred ones both. The feed
+        // has been consumed, so its scratch holds the centre return.
+        float *centre = nullptr;
+        for (int c = 0; c < channels; ++c) {
+            if (mIsLFE[c]) continue;
+            const float *ret = mReverbBlockL.data();
+            if (mHaasWeight[c] > 0.0f) {
+                ret = mReverbBlockR.data();
+            } else if (mHaasWeight[c] == 0.0f) {
+                if (!centre) {
+                    centre = mReverbInBlock.data();
+                    for (int f = 0; f < n; ++f) centre[f] = (mReverbBlockL[f] + mReverbBlockR[f]) * 0.5f;
+                }
+                ret = centre;
+            }
+            float *wet = wetBlock(c);
+            for (int f = 0; f < n; ++f) {
+                if (mBusBlock[f] <= 0.001f) continue;
+                wet[f] = wet[f] * 0.97f + ret[f] * 0.03f;
+            }
+        }
+        mMeters.addReverb(mReverbBlockL.data(), mReverbBlockR.data(), n);
+
+        updateReverbSleep(feedPeak, n);
+    }
+
+    void updateReverbSleep(float feedPeak, int n) {
+        // Knob parked at centre: the tail is no longer mixed in, so flushing it
+        // is inaudible and stops it costing CPU.
+        if (mBusClosedFrames >= mBusCloseFlushFrames) {
+            sleepReverb();
+            return;
+        }
+        float outPeak = std::max(peakAbs(mReverbBlockL.data(), n), peakAbs(mReverbBlockR.data(), n));
+        if (feedPeak > kTailThreshold || outPeak > kTailThreshold) {
+            mReverbQuietFrames = 0;
+            return;
+        }
+        // Quiet output can still hide energy in flight inside the combs, so only
+        // after a full settle time is the whole bank checked before sleeping.
+        // Convolution has no feedback: once the response's length of feed has
+        // been quiet, nothing louder is left in it.
+        mReverbQuietFrames += n;
+        if (mLayoutReverbEngine == VXFissionReverbEngine::Convolution) {
+            if (mReverbQuietFrames >= mConvolution.settleFrames()) sleepReverb();
+            return;
+        }
+        if (mReverbQuietFrames < mReverb.settleFrames()) return;
+        if (mReverb.peakLevel(mArena) <= kTailThreshold) {
+            sleepReverb();
+        } else {
+            mReverbQuietFrames = 0;
+        }
+    }
+
+    void sleepReverb() {
+        if (mLayoutReverbEngine == VXFissionReverbEngine::Convolution) mConvolution.reset();
+        else                                                          mReverb.reset(mArena);
+        mReverbAsleep      = true;
+        mReverbQuietFrames = 0;
+    }
+
+    template <int kChannels>
+    void mixAndCompress(const float *const *in, float *const *out, int numOut, int n) {
+        // Gain-compensated dry/wet blend (gains from retargetControl()), formed
+        // in the wet scratch, which is not needed after this. Every input is
+        // read here, before the compressor writes any output.
+        const float *mix[kMaxChannels];
+        for (int c = 0; c < (kChannels ? kChannels : mChannels); ++c) {
+            const float *x   = in[c];
+            float       *wet = wetBlock(c);
+            for (int f = 0; f < n; ++f) wet[f] = x[f] * mDryGainBlock[f] + wet[f] * mWetGainBlock[f];
+            mix[c] = wet;
+        }
+
+        // === Light compression on mixed output ===
+        // Feed-forward peak compressor: 2:1 above -6 dBFS, depth scales with busAmount.
+        float minGain = mCompressor.process(mix, out, numOut, mBusBlock.data(), n);
+        mMeters.addGainReduction(minGain);
+    }
+
+    // MARK: Quality Tiers
+    static VXFissionQualityTier fixedQualityTier(VXFissionQualityMode mode) {
+        switch (mode) {
+            case VXFissionQualityMode::Eco:  return VXFissionQualityTier::Eco;
+            case VXFissionQualityMode::High: return VXFissionQualityTier::High;
+            default:                         return VXFissionQualityTier::Standard;
+        }
+    }
+
+    static int combsPerSideFor(VXFissionQualityTier tier) {
+        return (tier == VXFissionQualityTier::Eco) ? FreeverbTuning::kCombsPerSide / 2 : FreeverbTuning::kCombsPerSide;
+    }
+
+    static float chorusBlendFor(VXFissionQualityTier tier) {
+        return (tier == VXFissionQualityTier::High) ? 1.0f : 0.0f;
+    }
+
+    // The mode as set, with Auto as standard while rendering offline.
+    VXFissionQualityMode renderedQualityMode() const {
+        const VXFissionQualityMode mode = (VXFissionQualityMode)mQualityModeParam.load();
+        return (mode == VXFissionQualityMode::Auto && mRenderingOffline.load()) ? VXFissionQualityMode::Standard : mode;
+    }
+
+    VXFissionQualityTier wantedQualityTier() const {
+        return (mQualityModeLatched == VXFissionQualityMode::Auto) ? mGovernor.tier() : fixedQualityTier(mQualityModeLatched);
+    }
+
+    // Once per process() call: latches the mode and starts a switch to the
+    // tier it asks for. Governing starts from the tier already rendering.
+    void updateQualityTier() {
+        const VXFissionQualityMode mode = renderedQualityMode();
+        if (mode != mQualityModeLatched) {
+            mQualityModeLatched = mode;
+            if (mode == VXFissionQualityMode::Auto) mGovernor.restart(mQualityTier);
+        }
+        const VXFissionQualityTier tier = wantedQualityTier();
+        if (tier == mQualityTier) return;
+        mQualityTier = tier;
+        // A sleeping bank holds nothing to fade.
+        mReverb.setCombsPerSide(mArena, combsPerSideFor(tier), mReverbAsleep ? 0 : mQualityFadeFrames);
+        mChorusBlendTarget = chorusBlendFor(tier);
+        mQualityTierOut.store((int)tier);
+    }
+
+    // MARK: State Snapshots
+    static constexpr uint32_t kStateMagic   = 0x53465856;  // "VXFS"
+    static constexpr uint32_t kStateVersion = 4;
+
+    // What a snapshot must agree on to be restored: its header.
+    struct StateLayout {
+        uint32_t magic           = kStateMagic;
+        uint32_t version         = kStateVersion;
+        uint64_t totalBytes      = 0;
+        double   sampleRate      = 0.0;
+        int32_t  channels        = 0;
+        int32_t  monoInput       = 0;
+        int32_t  oversampling    = 0;
+        int32_t  controlInterval = 0;
+        int32_t  ringSize        = 0;
+        uint32_t haasStateBytes  = 0;
+        uint32_t sampleBytes     = 0;
+        uint64_t arenaBytes      = 0;
+        int32_t  reverbEngine    = 0;
+        int32_t  convolutionTail = 0;   // block of the tail partitions
+        uint64_t responseHash    = 0;   // the loaded response's fingerprint
+        float    haasWeight[VXFissionChannelMap::kMaxChannels] = {};
+        int32_t  lfe[VXFissionChannelMap::kMaxChannels]        = {};
+
+        bool operator==(const StateLayout &) const = default;
+    };
+
+    StateLayout stateLayout(uint64_t totalBytes) const {
+        StateLayout layout;
+        layout.totalBytes      = totalBytes;
+        layout.sampleRate      = mSampleRate;
+        layout.channels        = mChannels;
+        layout.monoInput       = mMonoInput;
+        layout.oversampling    = mCompressor.oversampling();
+        layout.controlInterval = mBaseControlInterval;
+        layout.ringSize        = mRingSize;
+        layout.haasStateBytes  = sizeof(typename HaasInterpolator::State);
+        layout.sampleBytes     = sizeof(DelaySample);
+        layout.arenaBytes      = mArena.bytes();
+        layout.reverbEngine    = (int32_t)mLayoutReverbEngine;
+        if (mLayoutReverbEngine == VXFissionReverbEngine::Convolution) {
+            layout.convolutionTail = mConvolution.tailBlock();
+            layout.responseHash    = mResponseFingerprint;
+        }
+        for (int c = 0; c < mChannels; ++c) {
+            layout.haasWeight[c] = mHaasWeight[c];
+            layout.lfe[c]        = mIsLFE[c];
+        }
+        return layout;
+    }
+
+    // The render-thread state after the parameters, in one order for both directions.
+    template <typename Archive, typename Core>
+    static void visitState(Archive &archive, Core &core) {
+        archive.value(core.mDelayTimeMs);
+        archive.value(core.mSmoothedDelayTimeMs);
+        archive.value(core.mCurrentDelayMs);
+        archive.value(core.mRampStartMs);
+        archive.value(core.mRampTargetMs);
+        archive.value(core.mRampSlope);
+        archive.value(core.mRampElapsed);
+        archive.value(core.mRampFramesLeft);
+        archive.value(core.mControlPhase);
+        archive.value(core.mControlInterval);
+        archive.value(core.mInverseControlInterval);
+        archive.value(core.mSmoothingDecay);
+        archive.value(core.mControlTier);
+        archive.value(core.mQualityModeLatched);
+        archive.value(core.mQualityTier);
+        archive.value(core.mChorusBlend);
+        archive.value(core.mChorusBlendTarget);
+        archive.value(core.mLFO);
+        archive.value(core.mDelayRamp);
+        archive.value(core.mChorusDelayRamp);
+        archive.value(core.mDryGainRamp);
+        archive.value(core.mWetGainRamp);
+        archive.value(core.mWriteHead);
+        archive.value(core.mHaasState);
+        archive.value(core.mBypassPosition);
+        archive.value(core.mBypassEngaged);
+        archive.value(core.mFadeTrails);
+        archive.value(core.mTrailsRinging);
+        archive.value(core.mSilentInputFrames);
+        archive.value(core.mBusClosedFrames);
+        archive.value(core.mReverbQuietFrames);
+        archive.value(core.mReverbAsleep);
+        archive.value(core.mWetBusAsleep);
+        archive.value(core.mOutputIsSilent);
+    }
+
+    void writeStateBody(VXFissionStateWriter &writer) const {
+        visitState(writer, *this);
+        for (int c = 0; c < mChannels; ++c) mBypassDelay[c].saveState(writer);
+        mArena.saveState(writer);
+        if (mLayoutReverbEngine == VXFissionReverbEngine::Convolution) mConvolution.saveState(writer);
+        else                                                          mReverb.saveState(writer);
+        mCompressor.saveState(writer);
+    }
+
+    void readStateBody(VXFissionStateReader &reader) {
+        visitState(reader, *this);
+        for (int c = 0; c < mChannels; ++c) mBypassDelay[c].loadState(reader);
+        mArena.loadState(reader);
+        if (mLayoutReverbEngine == VXFissionReverbEngine::Convolution) mConvolution.loadState(reader);
+        else                                                          mReverb.loadState(reader);
+        mCompressor.loadState(reader);
+    }
+
+    // MARK: Member Variables
+    double   mSampleRate           = 44100.0;
+    AtomicValue<float> mDelayTimeParam { 0.0f };  // target from any thread: signed ms (<0=delay L, >0=delay R, 0=dry)
+    AtomicValue<bool>  mBypassed { false };
+    float    mDelayTimeMs          = 0.0f;   // target latched by process() for the render thread
+    float    mSmoothedDelayTimeMs  = 0.0f;   // one-pole smoothed value at the next control point
+    float    mSmoothingCoeff       = 0.0f;   // per-sample coefficient, computed in initialize()
+    float    mSmoothingDecay       = 0.0f;   // (1 - mSmoothingCoeff)^mControlInterval, for the current tier
+    float    mMsToSamples          = 44.1f;  // sampleRate / 1000
+    uint32_t mMaxFramesToRender    = 1024;
+    uint32_t mBlockCapacity        = 1024;   // scratch length, fixed in initialize()
+
+    // Per-channel state, one array entry per channel
+    static constexpr int kMaxChannels = VXFissionChannelMap::kMaxChannels;
+    int                 mChannels = 2;                 // channels rendered, ≥ 2
+    bool                mMonoInput = true;             // initialised for one input, upmixed to every channel
+    VXFissionChannelMap mChannelMap;                   // as set, or the default for mChannels
+    float               mHaasWeight[kMaxChannels] = {};  // from mChannelMap
+    bool                mIsLFE[kMaxChannels]      = {};
+    DelayLine           mDelayLine[kMaxChannels];      // ring buffers, in mArena (all the same one for a mono input)
+    typename HaasInterpolator::State mHaasState[kMaxChannels];  // Haas read filter state (Thiran only)
+    LatencyDelay        mBypassDelay[kMaxChannels];    // input delayed by the oversampling latency, for bypass
+
+    DelayArenaT<DelaySample> mArena;   // every delay line: Haas rings + reverb
+    int mDelayLength = 0;              // 50 ms + 1 sample: the longest readable delay
+    int mRingSize    = 0;              // power of two ≥ mDelayLength + one block of write-ahead headroom + interpolator taps
+    int mRingMask    = 0;              // mRingSize - 1
+    int mWriteHead   = 0;
+    int mRingCount   = 0;              // distinct rings: 1 for a mono input, else mChannels
+
+    double   mLayoutRate      = 0.0;    // what the arena and scratch were last laid out for
+    int      mLayoutChannels  = 0;
+    bool     mLayoutMonoInput = false;
+    uint32_t mLayoutCapacity  = 0;
+    VXFissionReverbEngine mLayoutReverbEngine   = VXFissionReverbEngine::Freeverb;
+    uint64_t              mLayoutImpulseVersion = 0;
+    ConvolutionTailThread mLayoutTailThread     = ConvolutionTailThread::Render;
+    bool     mRendered        = false;  // process() has run since initialize()
+    bool     mReady           = false;  // initialised, and not deInitialize()d since
+
+    // The block path for the initialised layout (see processBlock()).
+    using BlockRenderer = bool (VXFissionExtensionDSPCoreT::*)(const float *const *, float *const *, int, int);
+    BlockRenderer mProcessBlock = &VXFissionExtensionDSPCoreT::template processBlock<2, true>;
+
+    static BlockRenderer blockRendererFor(int channels, bool monoInput) {
+        if (channels == 2) {
+            return monoInput ? &VXFissionExtensionDSPCoreT::template processBlock<2, true>
+                             : &VXFissionExtensionDSPCoreT::template processBlock<2, false>;
+        }
+        return monoInput ? &VXFissionExtensionDSPCoreT::template processBlock<0, true>
+                         : &VXFissionExtensionDSPCoreT::template processBlock<0, false>;
+    }
+
+    // Control rate
+    static constexpr int kDefaultControlInterval = 16;
+    static constexpr int kMaxControlInterval     = 256;
+    int   mBaseControlInterval    = kDefaultControlInterval;  // as set: the standard tier's
+    int   mControlInterval        = kDefaultControlInterval;  // the control tier's
+    int   mControlPhase           = kDefaultControlInterval;  // frames into the current interval
+    float mInverseControlInterval = 1.0f / kDefaultControlInterval;
+    QuadratureOscillator mLFO;       // 0.8 Hz chorus LFO, stepped once per interval
+    ControlRamp mDelayRamp;          // smoothed delay time (ms)
+    ControlRamp mChorusDelayRamp;    // chorus read delay (samples)
+    ControlRamp mDryGainRamp;        // 1 / (1 + masterMix)
+    ControlRamp mWetGainRamp;        // masterMix / (1 + masterMix)
+
+    // Quality (render thread, except the mode parameter and the published tier)
+    static constexpr double kQualityFadeSeconds = 0.05;
+    struct TierControlRate {
+        int   interval       = kDefaultControlInterval;
+        float inverse        = 1.0f / kDefaultControlInterval;
+        float smoothingDecay = 0.0f;
+        QuadratureOscillator lfo;    // only the step is used
+    };
+    AtomicValue<int>     mQualityModeParam { (int)VXFissionQualityMode::Standard };  // any thread
+    AtomicValue<int>     mQualityTierOut   { (int)VXFissionQualityTier::Standard };  // published for the host
+    VXFissionQualityMode mQualityModeLatched = VXFissionQualityMode::Standard;
+    VXFissionQualityTier mQualityTier        = VXFissionQualityTier::Standard;  // comb count and chorus read
+    VXFissionQualityTier mControlTier        = VXFissionQualityTier::Standard;  // control rate: follows at a control point
+    TierControlRate      mTierControlRate[kQualityTiers];
+    VXFissionQualityGovernor mGovernor;
+    int   mQualityFadeFrames = 1;
+    float mChorusBlend       = 0.0f;   // Hermite share of the chorus tap
+    float mChorusBlendTarget = 0.0f;
+
+    // Host automation ramp on the delay time (render thread)
+    float mCurrentDelayMs = 0.0f;    // delay time of the last rendered frame
+    float mRampStartMs    = 0.0f;
+    float mRampTargetMs   = 0.0f;
+    float mRampSlope      = 0.0f;    // ms per frame
+    int   mRampElapsed    = 0;
+    int   mRampFramesLeft = 0;       // 0 = no ramp, smoother in charge
+
+    // Delay-time events queued for the current process() call (render thread)
+    struct ScheduledDelayTime {
+        uint32_t offset;                 // frames into the call
+        float    valueMs;
+        uint32_t rampFrames;             // 0 = jump
+    };
+    static constexpr int kMaxScheduledEvents = 256;
+    ScheduledDelayTime mScheduled[kMaxScheduledEvents];
+    int      mScheduledCount = 0;
+    int      mScheduledNext  = 0;        // first not yet applied
+    uint32_t mBlockStart     = 0;        // frames of the call before the current sub-block
+
+    // Bypass crossfade (render thread, except the trails parameter)
+    static constexpr double kBypassFadeSeconds = VXFissionRateTuning::kBypassFadeSeconds;
+    AtomicValue<bool>  mBypassTrailsParam { false };
+    const float       *mBypassFade = nullptr;  // sin(π/2 · k / mBypassFadeFrames), k = 0…mBypassFadeFrames
+    std::vector<float> mBypassFadeStorage;     // mBypassFade's values at a rate without a table
+    int  mBypassFadeFrames = 1;
+    int  mBypassPosition   = 0;              // 0 = effect, mBypassFadeFrames = bypassed
+    bool mBypassEngaged    = false;          // bypass as last latched
+    bool mFadeTrails       = false;          // trails mode, latched when bypass engages
+    bool mTrailsRinging    = false;          // bypassed with trails, tails not yet silent
+
+    OutputCompressor   mCompressor;  // output compressor, optionally oversampled
+    AtomicValue<int>   mOversamplingParam { 1 };  // requested factor from any thread: 1, 2 or 4
+
+    FreeverbBankT<DelaySample> mReverb;  // 8+8 combs as SIMD lanes (4+4 at eco), 4+4 all-passes
+
+    // Convolution reverb (configured only while selected)
+    VXFissionReverbEngine    mReverbEngine        = VXFissionReverbEngine::Freeverb;  // for the next initialize()
+    ConvolutionTailThread    mTailThread          = ConvolutionTailThread::Render;
+    VXFissionImpulseResponse mImpulseResponse;             // as loaded; empty for the synthetic room
+    uint64_t                 mImpulseVersion      = 0;     // bumped by every load
+    uint64_t                 mResponseFingerprint = 0;     // of the response configured
+    ConvolutionReverb        mConvolution;
+    AtomicValue<bool>        mRenderingOffline { false };  // any thread
+
+    MeterPublisher mMeters;  // output levels, gain reduction and reverb energy for the UI
+#if VXFISSION_PROFILING
+    VXFissionProfiler mProfiler;  // per-stage render timings
+#endif
+
+    // Sleep/wake
+    static constexpr float kSilenceThreshold = 1e-6f;  // -120 dBFS: input counts as silent
+    static constexpr float kTailThreshold    = 1e-5f;  // reverb tail level that may be dropped (≤ -130 dBFS at the output after the 3 % blend)
+    int  mSilentInputFrames   = 0;     // consecutive frames of silent input (capped at mRingSize)
+    int  mBusClosedFrames     = 0;     // consecutive frames with the bus shut (capped)
+    int  mBusCloseFlushFrames = 0;     // 200 ms: shut-bus time after which the tail is flushed
+    int  mReverbQuietFrames   = 0;     // consecutive frames of sub-threshold reverb feed and output
+    bool mReverbAsleep        = true;  // bank flushed and skipped
+    bool mWetBusAsleep        = true;  // whole wet bus skipped, rings cleared
+    bool mOutputIsSilent      = false; // last process() output was all zeros
+
+    // Per-stage scratch (mBlockCapacity frames each)
+    std::vector<float> mSmoothedBlock;     // smoothed delay time per frame
+    std::vector<float> mBusBlock;          // bus send amount per frame
+    std::vector<float> mChorusDelayBlock;  // chorus read delay per frame (samples)
+    std::vector<float> mDryGainBlock;      // dry gain per frame
+    std::vector<float> mWetGainBlock;      // wet gain per frame
+    std::vector<float> mWetBlock;          // wet bus, one block per channel, mWetStride apart
+    size_t             mWetStride = 0;
+    std::vector<float> mReverbInBlock;     // mono reverb feed (silence where the bus is shut)
+    std::vector<float> mReverbBlockL;      // reverb output — left
+    std::vector<float> mReverbBlockR;      // reverb output — right
+    std::vector<float> mBypassDryBlock;    // bypass fade: dry path, one block per channel, mWetStride apart
+    std::vector<float> mBypassInBlock;     // bypass fade with trails: faded effect input, likewise
+    std::vector<float> mFadeWetBlock;      // bypass fade: effect gain per frame
+    std::vector<float> mFadeDryBlock;      // bypass fade: dry gain per frame
+};
+
+using VXFissionExtensionDSPCore = VXFissionExtensionDSPCoreT<VXFISSION_HAAS_INTERPOLATOR>;
+
+// The Audio Unit holds the kernel, and so the core, by value from Swift.
+static_assert(std::is_copy_constructible_v<VXFissionExtensionDSPCore> && std::is_copy_assignable_v<VXFissionExtensionDSPCore>,
+              "the DSP core must stay copyable for Swift's C++ interop");
@@ -0,0 +1,107 @@
+//
+//  VXFissionExtensionDelayArena.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <numeric>
+
+#include "VXFissionExtensionDelayFormat.hpp"
+#include "VXFissionExtensionSIMD.hpp"
+#include "VXFissionExtensionState.hpp"
+
+// Smallest power of two ≥ n (n ≥ 1).
+constexpr size_t nextPowerOfTwo(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+// One line inside a DelayArena. Lines are addressed by offset rather than
+// pointer, so whatever holds them copies cleanly along with its arena.
+struct DelayLine {
+    size_t offset = 0;  // samples from the start of the arena
+    int    size   = 0;  // samples; a power of two for rings
+    int    mask   = 0;  // size - 1 for rings, so wrapping is `index & mask`
+};
+
+/*
+ DelayArenaT
+ Every delay line of the signal path in one cache-line aligned allocation,
+ stored as `Sample` (see VXFissionExtensionDelayFormat.hpp). Owners reserve
+ their lines in a layout pass, then allocate() makes (or reuses) the single
+ block. Each line starts on a cache line and is followed by one spare cache
+ line: power-of-two rings laid end to end would otherwise all start at large
+ power-of-two offsets, so the same index in every ring would map to the same
+ cache set. The stagger spreads them across sets. (A 3-byte sample only
+ lands on a cache line every 64 samples, so its lines start on those and the
+ stagger is three lines.)
+ */
+template <typename Sample>
+class DelayArenaT {
+public:
+    // Samples per step of line placement: the fewest that fill whole cache lines.
+    static constexpr size_t kSamplesPerStep = kCacheLineBytes / std::gcd(kCacheLineBytes, sizeof(Sample));
+
+    void beginLayout() {
+        mLayoutSamples = 0;
+    }
+
+    // A line of exactly `samples` samples.
+    DelayLine reserve(size_t samples) {
+        DelayLine line;
+        line.offset = mLayoutSamples;
+        line.size   = (int)samples;
+        line.mask   = line.size - 1;
+        mLayoutSamples += (samples + kSamplesPerStep - 1) / kSamplesPerStep * kSamplesPerStep + kSamplesPerStep;
+        return line;
+    }
+
+    // A power-of-two ring holding at least `minSamples` samples.
+    DelayLine reserveRing(size_t minSamples) {
+        return reserve(nextPowerOfTwo(minSamples));
+    }
+
+    // One allocation for everything reserved since beginLayout(), zeroed.
+    // A re-layout that fits in the current block (e.g. a lower sample rate)
+    // allocates nothing.
+    void allocate() {
+        mStorage.assign((mLayoutSamples * sizeof(Sample) + sizeof(float) - 1) / sizeof(float));
+        mSamples = mLayoutSamples;
+    }
+
+    void release() {
+        mStorage.release();
+        mSamples = 0;
+    }
+
+    void clear() {
+        mStorage.clear();
+    }
+
+    void clear(const DelayLine &line) {
+        std::memset(data(line), 0, (size_t)line.size * sizeof(Sample));
+    }
+
+    // Every line's contents, for a state snapshot of an arena with the same layout.
+    void saveState(VXFissionStateWriter &writer) const { writer.bytes(mStorage.data(), bytes()); }
+    void loadState(VXFissionStateReader &reader)       { reader.bytes(mStorage.data(), bytes()); }
+
+    Sample       *data(const DelayLine &line)       { return reinterpret_cast<Sample *>(mStorage.data()) + line.offset; }
+    const Sample *data(const DelayLine &line) const { return reinterpret_cast<const Sample *>(mStorage.data()) + line.offset; }
+    bool   empty() const { return mStorage.empty(); }
+    size_t samples() const { return mSamples; }
+    size_t bytes() const { return mSamples * sizeof(Sample); }
+
+private:
+    AlignedFloatBuffer mStorage;  // sized in floats, holding samples
+    size_t mLayoutSamples = 0;
+    size_t mSamples       = 0;
+};
+
+using DelayArena = DelayArenaT<float>;
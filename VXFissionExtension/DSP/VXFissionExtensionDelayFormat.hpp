@@ -0,0 +1,298 @@
+//
+//  VXFissionExtensionDelayFormat.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "VXFissionExtensionSIMD.hpp"
+
+#if VXFISSION_SIMD_AVX2 || VXFISSION_SIMD_SSE
+    #define VXFISSION_DELAY_SSE2 1
+    #if defined(__SSSE3__)
+        #include <tmmintrin.h>
+        #define VXFISSION_DELAY_SSSE3 1
+    #endif
+    #if VXFISSION_SIMD_AVX2 && defined(__F16C__)
+        #define VXFISSION_DELAY_F16C 1
+    #endif
+#elif VXFISSION_SIMD_NEON && defined(__aarch64__)
+    #define VXFISSION_DELAY_NEON_F16 1
+#endif
+
+// ─── Delay-line sample formats ───────────────────────────────────────────────
+// What the Haas rings and reverb rings store. The signal path always computes
+// in float; a narrower format only changes what is kept between a write and
+// the read that comes back for it, so each ring is encoded as a block goes in
+// and decoded as taps come out. The DSP core and DelayArenaT / FreeverbBankT
+// take the sample type as a template parameter:
+//
+//   float          32-bit, exact; the default
+//   DelayPacked24  the top 24 bits of a float32, rounded to nearest even:
+//                  float32's range with a 16-bit significand (about −96 dB
+//                  relative), 3 bytes
+//   DelayHalf      IEEE binary16, subnormals kept: an 11-bit significand
+//                  (about −66 dB relative) down to 6e-8, 2 bytes
+//
+// Every format holds zero as all-zero bits, so rings are cleared with memset.
+//
+//   delaySample(s)                    one stored sample as float (for taps)
+//   encodeDelaySamples(in, out, n)    n floats into the format
+//   decodeDelaySamples(in, out, n)    n stored samples to float
+//
+// Blocks convert in SIMD. Half uses F16C (with the AVX2 build) or NEON on
+// AArch64, otherwise the same bit arithmetic as the scalar path on SSE2
+// integer lanes. Packed 24-bit samples are rounded four at a time and packed
+// with one byte shuffle on SSSE3 (the AVX2 build), shifts and masks on SSE2,
+// and as three 32-bit words per four samples elsewhere.
+
+struct DelayHalf {
+    uint16_t bits;
+};
+
+struct DelayPacked24 {
+    uint8_t bytes[3];
+};
+static_assert(sizeof(DelayHalf) == 2 && sizeof(DelayPacked24) == 3, "delay samples are stored packed");
+
+template <typename Sample> struct DelayFormat;
+template <> struct DelayFormat<float>         { static constexpr const char *kName = "float32"; };
+template <> struct DelayFormat<DelayHalf>     { static constexpr const char *kName = "float16"; };
+template <> struct DelayFormat<DelayPacked24> { static constexpr const char *kName = "packed24"; };
+
+namespace vxfission_delay_format {
+
+inline uint32_t floatBits(float x)    { uint32_t u; std::memcpy(&u, &x, sizeof u); return u; }
+inline float    bitsFloat(uint32_t u) { float x; std::memcpy(&x, &u, sizeof x); return x; }
+
+// binary32 → binary16, round to nearest even; out-of-range values become
+// infinity and NaN stays NaN (F. Giesen's float_to_half_fast3_rtne).
+inline uint16_t halfFromFloat(float x) {
+    uint32_t u    = floatBits(x);
+    uint32_t sign = (u >> 16) & 0x8000u;
+    u &= 0x7FFFFFFFu;
+    // Subnormal halves: adding 0.5f lines the 10 kept bits up at the bottom
+    // of the significand and rounds them in the FPU.
+    const uint32_t subnormal = floatBits(bitsFloat(u) + 0.5f) - 0x3F000000u;
+    const uint32_t normal    = (u + 0xC8000FFFu + ((u >> 13) & 1u)) >> 13;  // rebias (−112 << 23), round
+    const uint32_t special   = (u > 0x7F800000u) ? 0x7E00u : 0x7C00u;
+    const uint32_t h = (u >= 0x47800000u) ? special : (u < 0x38800000u) ? subnormal : normal;
+    return (uint16_t)(h | sign);
+}
+
+// binary16 → binary32, exactly (F. Giesen's half_to_float).
+inline float floatFromHalf(uint16_t h) {
+    const uint32_t shiftedExp = 0x7C00u << 13;
+    uint32_t u   = (uint32_t)(h & 0x7FFFu) << 13;
+    uint32_t exp = u & shiftedExp;
+    u += (127 - 15) << 23;
+    float f = bitsFloat((exp == shiftedExp) ? u + ((128 - 16) << 23) : u);
+    if (exp == 0) f = bitsFloat(u + (1u << 23)) - bitsFloat(113u << 23);  // zero and subnormals
+    return bitsFloat(floatBits(f) | ((uint32_t)(h & 0x8000u) << 16));
+}
+
+// Top 24 bits of the float, rounded to nearest even on the dropped byte.
+inline uint32_t packed24FromFloat(float x) {
+    const uint32_t u = floatBits(x);
+    return (u + 0x7Fu + ((u >> 8) & 1u)) >> 8;
+}
+
+#if VXFISSION_DELAY_SSE2
+// The conversions above, four lanes at a time in SSE2 integer registers.
+
+// Four floats → four halves, each sign-extended in a 32-bit lane so that
+// _mm_packs_epi32 narrows them without saturating.
+inline __m128i halvesFromFloats(__m128 x) {
+    const __m128i bits = _mm_castps_si128(x);
+    const __m128i sign = _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(0x8000));
+    const __m128i u    = _mm_and_si128(bits, _mm_set1_epi32(0x7FFFFFFF));
+    const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(u), _mm_set1_ps(0.5f))),
+                                            _mm_set1_epi32(0x3F000000));
+    const __m128i odd    = _mm_and_si128(_mm_srli_epi32(u, 13), _mm_set1_epi32(1));
+    const __m128i normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(u, _mm_set1_epi32((int)0xC8000FFFu)), odd), 13);
+    const __m128i isNaN   = _mm_cmpgt_epi32(u, _mm_set1_epi32(0x7F800000));
+    const __m128i special = _mm_or_si128(_mm_set1_epi32(0x7C00), _mm_and_si128(isNaN, _mm_set1_epi32(0x0200)));
+    const __m128i tooBig  = _mm_cmpgt_epi32(u, _mm_set1_epi32(0x477FFFFF));
+    const __m128i tooSmall = _mm_cmplt_epi32(u, _mm_set1_epi32(0x38800000));
+    __m128i h = _mm_or_si128(_mm_and_si128(tooSmall, subnormal), _mm_andnot_si128(tooSmall, normal));
+    h = _mm_or_si128(_mm_and_si128(tooBig, special), _mm_andnot_si128(tooBig, h));
+    return _mm_srai_epi32(_mm_slli_epi32(_mm_or_si128(h, sign), 16), 16);
+}
+
+// Four halves, zero-extended in 32-bit lanes → four floats.
+inline __m128 floatsFromHalves(__m128i h) {
+    const __m128i shiftedExp = _mm_set1_epi32(0x7C00 << 13);
+    __m128i u = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7FFF)), 13);
+    const __m128i exp = _mm_and_si128(u, shiftedExp);
+    u = _mm_add_epi32(u, _mm_set1_epi32((127 - 15) << 23));
+    u = _mm_add_epi32(u, _mm_and_si128(_mm_cmpeq_epi32(exp, shiftedExp), _mm_set1_epi32((128 - 16) << 23)));
+    const __m128i isSmall  = _mm_cmpeq_epi32(exp, _mm_setzero_si128());
+    const __m128  subnormal = _mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(u, _mm_set1_epi32(1 << 23))),
+                                         _mm_castsi128_ps(_mm_set1_epi32(113 << 23)));
+    u = _mm_or_si128(_mm_and_si128(isSmall, _mm_castps_si128(subnormal)), _mm_andnot_si128(isSmall, u));
+    return _mm_castsi128_ps(_mm_or_si128(u, _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16)));
+}
+
+// Four floats → 12 packed bytes in the low bytes of the register.
+inline __m128i packed24FromFloats(__m128 x) {
+    const __m128i u = _mm_castps_si128(x);
+    const __m128i rounded = _mm_add_epi32(_mm_add_epi32(u, _mm_set1_epi32(0x7F)),
+                                          _mm_and_si128(_mm_srli_epi32(u, 8), _mm_set1_epi32(1)));
+#if VXFISSION_DELAY_SSSE3
+    return _mm_shuffle_epi8(rounded, _mm_setr_epi8(1, 2, 3, 5, 6, 7, 9, 10, 11, 13, 14, 15, -1, -1, -1, -1));
+#else
+    // Pairs of 24-bit values into 48 bits per 64-bit lane, then the upper
+    // lane down against the lower.
+    const __m128i v     = _mm_srli_epi32(rounded, 8);
+    const __m128i pairs = _mm_or_si128(_mm_and_si128(v, _mm_set_epi32(0, 0xFFFFFF, 0, 0xFFFFFF)),
+                                       _mm_and_si128(_mm_srli_epi64(v, 8), _mm_set_epi32(0xFFFF, (int)0xFF000000u, 0xFFFF, (int)0xFF000000u)));
+    const __m128i lower = _mm_set_epi32(0, 0, -1, -1);
+    return _mm_or_si128(_mm_and_si128(pairs, lower), _mm_srli_si128(_mm_andnot_si128(lower, pairs), 2));
+#endif
+}
+
+// 12 packed bytes → four floats.
+inline __m128 floatsFromPacked24(__m128i bytes) {
+#if VXFISSION_DELAY_SSSE3
+    return _mm_castsi128_ps(_mm_shuffle_epi8(bytes, _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11)));
+#else
+    // Bytes 0–5 and 6–11 in the two 64-bit lanes, then each lane's pair of
+    // 24-bit values up into the top of its two 32-bit lanes.
+    const __m128i pairs = _mm_unpacklo_epi64(bytes, _mm_srli_si128(bytes, 6));
+    const __m128i even  = _mm_and_si128(_mm_slli_epi32(pairs, 8),  _mm_set_epi32(0, -1, 0, -1));
+    const __m128i odd   = _mm_and_si128(_mm_slli_epi64(pairs, 16), _mm_set_epi32((int)0xFFFFFF00u, 0, (int)0xFFFFFF00u, 0));
+    return _mm_castsi128_ps(_mm_or_si128(even, odd));
+#endif
+}
+
+inline __m128i loadPacked24(const void *p) {
+    uint32_t last;
+    std::memcpy(&last, (const uint8_t *)p + 8, sizeof last);
+    return _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p), _mm_cvtsi32_si128((int)last));
+}
+
+inline void storePacked24(void *p, __m128i bytes) {
+    const uint32_t last = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(bytes, 8));
+    _mm_storel_epi64((__m128i *)p, bytes);
+    std::memcpy((uint8_t *)p + 8, &last, sizeof last);
+}
+#endif
+
+} // namespace vxfission_delay_format
+
+// MARK: - One sample
+
+inline float delaySample(float s) { return s; }
+
+inline float delaySample(DelayHalf s) {
+#if VXFISSION_DELAY_F16C
+    return _cvtsh_ss(s.bits);
+#elif VXFISSION_DELAY_NEON_F16
+    return vgetq_lane_f32(vcvt_f32_f16(vreinterpret_f16_u16(vdup_n_u16(s.bits))), 0);
+#else
+    return vxfission_delay_format::floatFromHalf(s.bits);
+#endif
+}
+
+inline float delaySample(DelayPacked24 s) {
+    return vxfission_delay_format::bitsFloat((uint32_t)s.bytes[0] << 8 | (uint32_t)s.bytes[1] << 16 | (uint32_t)s.bytes[2] << 24);
+}
+
+// MARK: - Blocks
+
+inline void encodeDelaySamples(const float *in, float *out, size_t n) { std::memcpy(out, in, n * sizeof(float)); }
+inline void decodeDelaySamples(const float *in, float *out, size_t n) { std::memcpy(out, in, n * sizeof(float)); }
+
+inline void encodeDelaySamples(const float *in, DelayHalf *out, size_t n) {
+    size_t i = 0;
+#if VXFISSION_DELAY_F16C
+    for (; i + 8 <= n; i += 8) {
+        _mm_storeu_si128((__m128i *)(out + i), _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+    }
+#elif VXFISSION_DELAY_SSE2
+    for (; i + 8 <= n; i += 8) {
+        const __m128i lo = vxfission_delay_format::halvesFromFloats(_mm_loadu_ps(in + i));
+        const __m128i hi = vxfission_delay_format::halvesFromFloats(_mm_loadu_ps(in + i + 4));
+        _mm_storeu_si128((__m128i *)(out + i), _mm_packs_epi32(lo, hi));
+    }
+#elif VXFISSION_DELAY_NEON_F16
+    for (; i + 4 <= n; i += 4) {
+        vst1_u16(&out[i].bits, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(in + i))));
+    }
+#endif
+    for (; i < n; ++i) out[i].bits = vxfission_delay_format::halfFromFloat(in[i]);
+}
+
+inline void decodeDelaySamples(const DelayHalf *in, float *out, size_t n) {
+    size_t i = 0;
+#if VXFISSION_DELAY_F16C
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(in + i))));
+    }
+#elif VXFISSION_DELAY_SSE2
+    for (; i + 8 <= n; i += 8) {
+        const __m128i halves = _mm_loadu_si128((const __m128i *)(in + i));
+        _mm_storeu_ps(out + i,     vxfission_delay_format::floatsFromHalves(_mm_unpacklo_epi16(halves, _mm_setzero_si128())));
+        _mm_storeu_ps(out + i + 4, vxfission_delay_format::floatsFromHalves(_mm_unpackhi_epi16(halves, _mm_setzero_si128())));
+    }
+#elif VXFISSION_DELAY_NEON_F16
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(out + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(&in[i].bits))));
+    }
+#endif
+    for (; i < n; ++i) out[i] = delaySample(in[i]);
+}
+
+// Four samples are 12 bytes. Without a byte shuffle they go as three
+// little-endian words: v0 | v1 << 24, v1 >> 8 | v2 << 16, v2 >> 16 | v3 << 8.
+inline void encodeDelaySamples(const float *in, DelayPacked24 *out, size_t n) {
+    using namespace vxfission_delay_format;
+    size_t i = 0;
+#if VXFISSION_DELAY_SSE2
+    for (const size_t whole = n & ~(size_t)3; i < whole; i += 4) {
+        storePacked24(out + i, packed24FromFloats(_mm_loadu_ps(in + i)));
+    }
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (const size_t whole = n & ~(size_t)3; i < whole; i += 4) {
+        const uint32_t v0 = packed24FromFloat(in[i]),     v1 = packed24FromFloat(in[i + 1]);
+        const uint32_t v2 = packed24FromFloat(in[i + 2]), v3 = packed24FromFloat(in[i + 3]);
+        const uint32_t words[3] = { v0 | v1 << 24, v1 >> 8 | v2 << 16, v2 >> 16 | v3 << 8 };
+        std::memcpy(out + i, words, sizeof words);
+    }
+#endif
+    for (; i < n; ++i) {
+        const uint32_t v = packed24FromFloat(in[i]);
+        out[i].bytes[0] = (uint8_t)v; out[i].bytes[1] = (uint8_t)(v >> 8); out[i].bytes[2] = (uint8_t)(v >> 16);
+    }
+}
+
+inline void decodeDelaySamples(const DelayPacked24 *in, float *out, size_t n) {
+    using namespace vxfission_delay_format;
+    size_t i = 0;
+#if VXFISSION_DELAY_SSE2
+    for (const size_t whole = n & ~(size_t)3; i < whole; i += 4) {
+        _mm_storeu_ps(out + i, floatsFromPacked24(loadPacked24(in + i)));
+    }
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (const size_t whole = n & ~(size_t)3; i < whole; i += 4) {
+        uint32_t w[3];
+        std::memcpy(w, in + i, sizeof w);
+        out[i]     = bitsFloat(w[0] << 8);
+        out[i + 1] = bitsFloat((w[0] >> 24 | w[1] << 8) << 8);
+        out[i + 2] = bitsFloat((w[1] >> 16 | w[2] << 16) << 8);
+        out[i + 3] = bitsFloat(w[2] & 0xFFFFFF00u);
+    }
+#endif
+    for (; i < n; ++i) out[i] = delaySample(in[i]);
+}
+
+// Default delay-line format; define VXFISSION_DELAY_SAMPLE to build another.
+#ifndef VXFISSION_DELAY_SAMPLE
+    #define VXFISSION_DELAY_SAMPLE float
+#endif
@@ -0,0 +1,206 @@
+//
+//  VXFissionExtensionFFT.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "VXFissionExtensionSIMD.hpp"
+
+/*
+ RealFFT
+ Forward and inverse FFTs of real signals of one power-of-two size N ≥ 16,
+ for the partitioned convolution (VXFissionExtensionConvolution.hpp). The
+ N real samples go through an N/2-point complex FFT as even/odd pairs and
+ are split into the real spectrum afterwards.
+
+ Spectra are split complex — separate re and im arrays — in the packed
+ layout: N/2 bins, the Nyquist bin's real part held in im[0] where DC's
+ (always zero) imaginary part would be. Every array is then N/2 long, a
+ whole number of vectors, and a spectrum multiply is one loop over them
+ with bin 0 patched up. The radix-2 butterflies run across SIMDFloat lanes
+ from the first stage whose span is a whole vector; the earlier ones are
+ scalar.
+
+ initialize() allocates the twiddles and scratch; forward() and inverse()
+ never allocate. Neither is scaled, so inverse(forward(x)) is N·x. An
+ instance owns its scratch: each thread needs its own.
+ */
+class RealFFT {
+public:
+    void initialize(int size) {
+        mSize = size;
+        mHalf = size / 2;
+        const int M = mHalf;
+        // Stage twiddles e^(−2πi·j / 2h), j < h, laid end to end: stage h at h − 1.
+        mStageCos.assign((size_t)M);
+        mStageSin.assign((size_t)M);
+        for (int h = 1; h < M; h <<= 1) {
+            for (int j = 0; j < h; ++j) {
+                const double angle = -M_PI * j / h;
+                mStageCos.data()[h - 1 + j] = (float)std::cos(angle);
+                mStageSin.data()[h - 1 + j] = (float)std::sin(angle);
+            }
+        }
+        // e^(−2πi·k / N), k < N/2, for the even/odd split.
+        mSplitCos.assign((size_t)M);
+        mSplitSin.assign((size_t)M);
+        for (int k = 0; k < M; ++k) {
+            const double angle = -2.0 * M_PI * k / size;
+            mSplitCos.data()[k] = (float)std::cos(angle);
+            mSplitSin.data()[k] = (float)std::sin(angle);
+        }
+        mReverse.assign((size_t)M, 0);
+        int bits = 0;
+        while ((1 << bits) < M) ++bits;
+        for (int k = 0; k < M; ++k) {
+            int r = 0;
+            for (int b = 0; b < bits; ++b) r |= ((k >> b) & 1) << (bits - 1 - b);
+            mReverse[k] = r;
+        }
+        mWorkRe.assign((size_t)M);
+        mWorkIm.assign((size_t)M);
+    }
+
+    int size() const { return mSize; }
+    int bins() const { return mHalf; }  // of a packed spectrum
+
+    // N samples → N/2 packed bins.
+    void forward(const float *x, float *re, float *im) {
+        const int M  = mHalf;
+        float    *wr = mWorkRe.data();
+        float    *wi = mWorkIm.data();
+        for (int k = 0; k < M; ++k) {
+            const int r = mReverse[k];
+            wr[k] = x[2 * r];
+            wi[k] = x[2 * r + 1];
+        }
+        transform(wr, wi);
+
+        // X[k] = E[k] + W^k·O[k], with E and O (the even and odd samples'
+        // spectra) taken from Z[k] and conj(Z[N/2 − k]); X[N/2 − k] follows
+        // from the same pair.
+        re[0] = wr[0] + wi[0];
+        im[0] = wr[0] - wi[0];
+        const float *c = mSplitCos.data();
+        const float *s = mSplitSin.data();
+        for (int k = 1; k <= M / 2; ++k) {
+            const float zr = wr[k], zi = wi[k], yr = wr[M - k], yi = wi[M - k];
+            const float er = 0.5f * (zr + yr), ei = 0.5f * (zi - yi);
+            const float orr = 0.5f * (zi + yi), oi = -0.5f * (zr - yr);
+            const float tr = orr * c[k] - oi * s[k];
+            const float ti = orr * s[k] + oi * c[k];
+            re[k]     = er + tr;
+            im[k]     = ei + ti;
+            re[M - k] = er - tr;
+            im[M - k] = ti - ei;
+        }
+    }
+
+    // N/2 packed bins → N samples, N times the signal forward() was given.
+    void inverse(const float *re, const float *im, float *x) {
+        const int M  = mHalf;
+        float    *wr = mWorkRe.data();
+        float    *wi = mWorkIm.data();
+        const float *c = mSplitCos.data();
+        const float *s = mSplitSin.data();
+
+        // Z[k] = E[k] + i·O[k], loaded re ↔ im swapped (and bit-reversed) so
+        // the forward transform computes the inverse.
+        wr[0] = re[0] - im[0];
+        wi[0] = re[0] + im[0];
+        for (int k = 1; k <= M / 2; ++k) {
+            const float xr = re[k], xi = im[k], yr = re[M - k], yi = im[M - k];
+            const float er = xr + yr, ei = xi - yi;
+            const float dr = xr - yr, di = xi + yi;
+            const float orr = dr * c[k] + di * s[k];
+            const float oi  = di * c[k] - dr * s[k];
+            wi[mReverse[k]]     = er - oi;
+            wr[mReverse[k]]     = ei + orr;
+            wi[mReverse[M - k]] = er + oi;
+            wr[mReverse[M - k]] = orr - ei;
+        }
+        transform(wr, wi);
+        for (int k = 0; k < M; ++k) {
+            x[2 * k]     = wi[k];
+            x[2 * k + 1] = wr[k];
+        }
+    }
+
+private:
+    // In-place radix-2 decimation in time of N/2 points already in
+    // bit-reversed order.
+    void transform(float *re, float *im) const {
+        constexpr int W = SIMDFloat::kWidth;
+        const int M = mHalf;
+        for (int h = 1; h < M; h <<= 1) {
+            const float *wc = mStageCos.data() + h - 1;
+            const float *ws = mStageSin.data() + h - 1;
+            for (int start = 0; start < M; start += 2 * h) {
+                float *ar = re + start, *ai = im + start;
+                float *br = ar + h,     *bi = ai + h;
+                int j = 0;
+                if (h >= W) {
+                    for (; j < h; j += W) {
+                        const SIMDFloat c  = SIMDFloat::load(wc + j), s = SIMDFloat::load(ws + j);
+                        const SIMDFloat xr = SIMDFloat::load(br + j), xi = SIMDFloat::load(bi + j);
+                        const SIMDFloat tr = xr * c - xi * s;
+                        const SIMDFloat ti = xr * s + xi * c;
+                        const SIMDFloat yr = SIMDFloat::load(ar + j), yi = SIMDFloat::load(ai + j);
+                        (yr + tr).store(ar + j);
+                        (yi + ti).store(ai + j);
+                        (yr - tr).store(br + j);
+                        (yi - ti).store(bi + j);
+                    }
+                }
+                for (; j < h; ++j) {
+                    const float tr = br[j] * wc[j] - bi[j] * ws[j];
+                    const float ti = br[j] * ws[j] + bi[j] * wc[j];
+                    br[j] = ar[j] - tr;
+                    bi[j] = ai[j] - ti;
+                    ar[j] += tr;
+                    ai[j] += ti;
+                }
+            }
+        }
+    }
+
+    int mSize = 0;
+    int mHalf = 0;
+    AlignedFloatBuffer   mStageCos, mStageSin;  // butterfly twiddles, every stage
+    AlignedFloatBuffer   mSplitCos, mSplitSin;  // even/odd split twiddles
+    AlignedFloatBuffer   mWorkRe, mWorkIm;      // the N/2-point complex transform
+    std::vector<int32_t> mReverse;              // bit reversal of N/2 indices
+};
+
+/*
+ Packed-spectrum multiply-accumulate: acc += a · b over `bins` bins of the
+ layout above. Bin 0 holds two real bins (DC and Nyquist), so it is
+ multiplied as two reals instead of one complex.
+ */
+inline void spectrumMultiplyAdd(const float *aRe, const float *aIm, const float *bRe, const float *bIm,
+                                float *accRe, float *accIm, int bins) {
+    constexpr int W = SIMDFloat::kWidth;
+    const float dc      = accRe[0] + aRe[0] * bRe[0];
+    const float nyquist = accIm[0] + aIm[0] * bIm[0];
+    int k = 0;
+    for (; k + W <= bins; k += W) {
+        const SIMDFloat ar = SIMDFloat::load(aRe + k), ai = SIMDFloat::load(aIm + k);
+        const SIMDFloat br = SIMDFloat::load(bRe + k), bi = SIMDFloat::load(bIm + k);
+        (SIMDFloat::load(accRe + k) + ar * br - ai * bi).store(accRe + k);
+        (SIMDFloat::load(accIm + k) + ar * bi + ai * br).store(accIm + k);
+    }
+    for (; k < bins; ++k) {
+        const float ar = aRe[k], ai = aIm[k], br = bRe[k], bi = bIm[k];
+        accRe[k] += ar * br - ai * bi;
+        accIm[k] += ar * bi + ai * br;
+    }
+    accRe[0] = dc;
+    accIm[0] = nyquist;
+}
@@ -0,0 +1,111 @@
+//
+//  VXFissionExtensionInterpolation.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <algorithm>
+
+#include "VXFissionExtensionDelayFormat.hpp"
+
+// ─── Fractional delay-line reads ─────────────────────────────────────────────
+// Each interpolator reads a ring `delay` samples (fractional) before the
+// sample at index `now`. They share one static interface so the DSP core can
+// take the read as a template parameter and pay for no mode switch at runtime:
+//
+//   kName        label for benchmarks
+//   kTapsOlder   how many samples beyond floor(delay) the read touches; the
+//                ring must hold that many extra samples of history
+//   State        per-channel filter state (empty for the FIR kernels)
+//   read(ring, mask, now, delay, state)   ring size is mask + 1, a power of two;
+//                the ring holds any delay-line sample type (see
+//                VXFissionExtensionDelayFormat.hpp), read through delaySample()
+//   follow(state, input)  keeps the state warm while the channel is not delayed
+
+// Index of the sample `delay` whole frames before `now` in a power-of-two ring.
+inline int ringTap(int now, int delay, int mask) {
+    return (now - delay) & mask;
+}
+
+// Two-point linear interpolation: cheapest, with a slight high-frequency
+// droop at half-sample positions.
+struct LinearInterpolator {
+    static constexpr const char *kName = "linear";
+    static constexpr int kTapsOlder = 1;
+    struct State {};
+
+    template <typename Sample>
+    static float read(const Sample *ring, int mask, int now, float delay, State &) {
+        int   d0 = (int)delay;
+        float t  = delay - (float)d0;
+        float x0 = delaySample(ring[ringTap(now, d0, mask)]);
+        float x1 = delaySample(ring[ringTap(now, d0 + 1, mask)]);
+        return x0 + t * (x1 - x0);
+    }
+    static void follow(State &, float) {}
+};
+
+// Four-point, third-order Hermite (Catmull-Rom): flat to well above the vocal
+// range at any fractional position. Below one sample of delay the newer tap
+// would be a frame not yet written, so it is clamped to the current frame.
+struct HermiteInterpolator {
+    static constexpr const char *kName = "hermite";
+    static constexpr int kTapsOlder = 2;
+    struct State {};
+
+    template <typename Sample>
+    static float read(const Sample *ring, int mask, int now, float delay, State &) {
+        int   d0 = (int)delay;
+        float t  = delay - (float)d0;
+        int   i0 = ringTap(now, d0, mask);
+        float xm, x0, x1, x2;
+        if (d0 > 0 && i0 >= 2 && i0 + 1 <= mask) {
+            // All four taps contiguous: the usual case away from the wrap.
+            const Sample *p = ring + i0;
+            xm = delaySample(p[1]); x0 = delaySample(p[0]); x1 = delaySample(p[-1]); x2 = delaySample(p[-2]);
+        } else {
+            xm = delaySample(ring[ringTap(now, std::max(d0 - 1, 0), mask)]);
+            x0 = delaySample(ring[i0]);
+            x1 = delaySample(ring[ringTap(now, d0 + 1, mask)]);
+            x2 = delaySample(ring[ringTap(now, d0 + 2, mask)]);
+        }
+        float c1 = 0.5f * (x1 - xm);
+        float c2 = xm - 2.5f * x0 + 2.0f * x1 - 0.5f * x2;
+        float c3 = 0.5f * (x2 - xm) + 1.5f * (x0 - x1);
+        return ((c3 * t + c2) * t + c1) * t + x0;
+    }
+    static void follow(State &, float) {}
+};
+
+// First-order Thiran all-pass: flat magnitude at every delay, so no droop,
+// with maximally flat group delay. The fractional part is kept in [0.5, 1.5)
+// where the all-pass is best conditioned. Being recursive, it trades a small
+// transient whenever the integer part steps for its flat response.
+struct ThiranInterpolator {
+    static constexpr const char *kName = "thiran";
+    static constexpr int kTapsOlder = 1;
+    struct State {
+        float y1 = 0.0f;  // previous output
+    };
+
+    template <typename Sample>
+    static float read(const Sample *ring, int mask, int now, float delay, State &state) {
+        int   m    = std::max((int)(delay - 0.5f), 0);
+        float frac = delay - (float)m;
+        float a    = (1.0f - frac) / (1.0f + frac);
+        float x0   = delaySample(ring[ringTap(now, m, mask)]);
+        float x1   = delaySample(ring[ringTap(now, m + 1, mask)]);
+        float y    = a * (x0 - state.y1) + x1;
+        state.y1   = y;
+        return y;
+    }
+    static void follow(State &state, float input) { state.y1 = input; }
+};
+
+// Default Haas read; define VXFISSION_HAAS_INTERPOLATOR to build another.
+#ifndef VXFISSION_HAAS_INTERPOLATOR
+    #define VXFISSION_HAAS_INTERPOLATOR HermiteInterpolator
+#endif
@@ -0,0 +1,97 @@
+//
+//  VXFissionExtensionLockFree.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// ─── Lock-free hand-off between the UI and render threads ────────────────────
+// Neither type ever blocks, allocates or makes a system call. Both are
+// copyable (copying takes a snapshot of the value) so the DSP core that owns
+// them stays copyable for Swift's C++ interop.
+
+/*
+ AtomicValue
+ A single parameter word shared between threads. Stores and loads are
+ relaxed: each value stands alone, nothing else is published through it.
+ */
+template <typename T>
+class AtomicValue {
+    static_assert(std::atomic<T>::is_always_lock_free, "AtomicValue must be lock-free");
+
+public:
+    AtomicValue(T value = T {}) : mValue(value) {}
+    AtomicValue(const AtomicValue &other) : mValue(other.load()) {}
+    AtomicValue &operator=(const AtomicValue &other) {
+        store(other.load());
+        return *this;
+    }
+
+    T    load() const     { return mValue.load(std::memory_order_relaxed); }
+    void store(T value)   { mValue.store(value, std::memory_order_relaxed); }
+    T    exchange(T value) { return mValue.exchange(value, std::memory_order_relaxed); }
+
+private:
+    std::atomic<T> mValue;
+};
+
+/*
+ SeqLock
+ Single-writer snapshot of a trivially copyable struct. publish() is
+ wait-free for the writer (the render thread); readers retry only if a publish
+ lands mid-copy. The payload is held in relaxed atomic words so a torn read is
+ detected by the sequence check rather than being a data race.
+ */
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock payload must be trivially copyable");
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+public:
+    SeqLock() { publish(T {}); }
+    SeqLock(const SeqLock &other) { publish(other.read()); }
+    SeqLock &operator=(const SeqLock &other) {
+        publish(other.read());
+        return *this;
+    }
+
+    void publish(const T &value) {
+        uint32_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        uint32_t sequence = mSequence.load(std::memory_order_relaxed);
+        mSequence.store(sequence + 1, std::memory_order_relaxed);  // odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i) mWords[i].store(words[i], std::memory_order_relaxed);
+        mSequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // One attempt; false if a publish overlapped the copy.
+    bool tryRead(T &value) const {
+        uint32_t before = mSequence.load(std::memory_order_acquire);
+        if (before & 1u) return false;
+        uint32_t words[kWords];
+        for (size_t i = 0; i < kWords; ++i) words[i] = mWords[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (mSequence.load(std::memory_order_relaxed) != before) return false;
+        std::memcpy(&value, words, sizeof(T));
+        return true;
+    }
+
+    T read() const {
+        T value;
+        while (!tryRead(value)) {}
+        return value;
+    }
+
+private:
+    std::atomic<uint32_t> mSequence { 0 };
+    std::atomic<uint32_t> mWords[kWords] = {};
+};
@@ -0,0 +1,128 @@
+//
+//  VXFissionExtensionMetering.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "VXFissionExtensionLockFree.hpp"
+#include "VXFissionExtensionSIMD.hpp"
+
+// Levels over every render block since the UI's previous read. All gains and
+// levels are linear.
+struct VXFissionMeterSnapshot {
+    float    peakL;          // output peak, left
+    float    peakR;          // output peak, right
+    float    rmsL;           // output RMS, left
+    float    rmsR;           // output RMS, right
+    float    gainReduction;  // smallest compressor gain applied (1 = none)
+    float    reverbEnergy;   // mean square of the reverb return (tail energy)
+    uint32_t frames;         // frames covered
+};
+
+/*
+ MeterPublisher
+ The render thread accumulates each block and publish()es once per render;
+ the UI calls read() at display rate. A read marks the window consumed, so
+ the next publish starts a fresh one: peaks between two UI frames are held,
+ not overwritten. If a publish lands between the UI's copy and its consume
+ mark, that one block drops out of the next window — a meter can live with it.
+ */
+class MeterPublisher {
+public:
+    // MARK: Render thread
+    void addOutput(const float *outL, const float *outR, int n) {
+        mBlock.peakL  = std::max(mBlock.peakL, peakAbs(outL, n));
+        mBlock.peakR  = std::max(mBlock.peakR, peakAbs(outR, n));
+        mBlockSumSqL += sumOfSquares(outL, n);
+        mBlockSumSqR += sumOfSquares(outR, n);
+        mBlock.frames += (uint32_t)n;
+    }
+
+    void addSilence(int n) {
+        mBlock.frames += (uint32_t)n;
+    }
+
+    void addGainReduction(float gain) {
+        mBlock.gainReduction = std::min(mBlock.gainReduction, gain);
+    }
+
+    // Reverb return; its frames are counted with the output.
+    void addReverb(const float *revL, const float *revR, int n) {
+        mBlockReverbSumSq += sumOfSquares(revL, n) + sumOfSquares(revR, n);
+    }
+
+    void publish() {
+        if (mBlock.frames == 0) return;
+        if (mConsumed.exchange(false)) resetWindow();
+
+        mWindow.peakL          = std::max(mWindow.peakL, mBlock.peakL);
+        mWindow.peakR          = std::max(mWindow.peakR, mBlock.peakR);
+        mWindow.gainReduction  = std::min(mWindow.gainReduction, mBlock.gainReduction);
+        mWindow.frames        += mBlock.frames;
+        mWindowSumSqL         += mBlockSumSqL;
+        mWindowSumSqR         += mBlockSumSqR;
+        mWindowReverbSumSq    += mBlockReverbSumSq;
+
+        const double frames = (double)mWindow.frames;
+        mWindow.rmsL         = (float)std::sqrt(mWindowSumSqL / frames);
+        mWindow.rmsR         = (float)std::sqrt(mWindowSumSqR / frames);
+        mWindow.reverbEnergy = (float)(mWindowReverbSumSq / (2.0 * frames));
+        mSnapshot.publish(mWindow);
+        resetBlock();
+    }
+
+    void reset() {
+        resetBlock();
+        resetWindow();
+        mSnapshot.publish(mWindow);
+    }
+
+    // MARK: UI thread
+    // frames == 0 means nothing has been rendered since the previous read.
+    VXFissionMeterSnapshot read() {
+        if (mConsumed.load()) return emptySnapshot();
+        VXFissionMeterSnapshot snapshot = mSnapshot.read();
+        mConsumed.store(true);
+        return snapshot;
+    }
+
+private:
+    static VXFissionMeterSnapshot emptySnapshot() {
+        return { 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0 };
+    }
+
+    void resetBlock() {
+        mBlock            = emptySnapshot();
+        mBlockSumSqL      = 0.0;
+        mBlockSumSqR      = 0.0;
+        mBlockReverbSumSq = 0.0;
+    }
+
+    void resetWindow() {
+        mWindow            = emptySnapshot();
+        mWindowSumSqL      = 0.0;
+        mWindowSumSqR      = 0.0;
+        mWindowReverbSumSq = 0.0;
+    }
+
+    // Render-thread accumulators: the current block, and the window since the
+    // UI last read.
+    VXFissionMeterSnapshot mBlock  = emptySnapshot();
+    VXFissionMeterSnapshot mWindow = emptySnapshot();
+    double mBlockSumSqL       = 0.0;
+    double mBlockSumSqR       = 0.0;
+    double mBlockReverbSumSq  = 0.0;
+    double mWindowSumSqL      = 0.0;
+    double mWindowSumSqR      = 0.0;
+    double mWindowReverbSumSq = 0.0;
+
+    SeqLock<VXFissionMeterSnapshot> mSnapshot;
+    AtomicValue<bool> mConsumed { false };
+};
@@ -0,0 +1,313 @@
+//
+//  VXFissionExtensionOversampling.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "VXFissionExtensionConstexprMath.hpp"
+#include "VXFissionExtensionSIMD.hpp"
+#include "VXFissionExtensionState.hpp"
+
+// ─── Half-band filters ───────────────────────────────────────────────────────
+// Linear-phase half-band lowpass of length N = 4k + 3: every tap an even
+// distance from the centre is zero except the centre itself (0.5). Split into
+// its two polyphase branches, one branch is an ordinary FIR over the even taps
+// and the other is a pure k-sample delay, so a 2x resampler costs one
+// (N + 1) / 2-tap FIR per base-rate sample. The FIR runs over a whole block at
+// a time, vectorised along the block.
+
+// Kaiser-windowed half-band sinc; returns the (N + 1) / 2 even-index taps,
+// normalised so the full filter has unity gain at DC. Evaluated at compile
+// time for the resampler's stages (see Oversampler).
+template <int kLength>
+constexpr std::array<float, (kLength + 1) / 2> designHalfBand(double beta) {
+    static_assert(kLength % 4 == 3, "half-band length must be 4k + 3");
+    constexpr int kCentre = (kLength - 1) / 2;
+    std::array<double, (kLength + 1) / 2> taps {};
+    double sum = 0.0;
+    for (int j = 0; j < (int)taps.size(); ++j) {
+        int    m      = 2 * j - kCentre;  // odd, so the sinc is never 0/0
+        double x      = M_PI * m / 2.0;
+        double r      = (double)m / kCentre;
+        double window = vxfission_constexpr::besselI0(beta * vxfission_constexpr::sqrt(1.0 - r * r))
+                      / vxfission_constexpr::besselI0(beta);
+        // sin(πm/2) for odd m is exactly ±1.
+        double sine   = (((m % 4) + 4) % 4 == 1) ? 1.0 : -1.0;
+        taps[j] = 0.5 * sine / x * window;
+        sum    += taps[j];
+    }
+    std::array<float, (kLength + 1) / 2> result {};
+    for (int j = 0; j < (int)taps.size(); ++j) result[j] = (float)(taps[j] * 0.5 / sum);
+    return result;
+}
+
+// out[i] = Σ_j taps[j] · x[i - j] for i in [0, n), where x = history + kTaps - 1:
+// the block follows kTaps - 1 samples of history.
+template <int kTaps>
+inline void firBlock(const float *taps, const float *history, float *out, int n) {
+    constexpr int W = SIMDFloat::kWidth;
+    int i = 0;
+    // Four vectors of outputs per pass, so each tap is broadcast once per 4W.
+    for (; i + 4 * W <= n; i += 4 * W) {
+        SIMDFloat acc0 = SIMDFloat::broadcast(0.0f), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+        for (int j = 0; j < kTaps; ++j) {
+            const SIMDFloat tap = SIMDFloat::broadcast(taps[j]);
+            const float    *x   = history + i + (kTaps - 1 - j);
+            acc0 = acc0 + tap * SIMDFloat::load(x);
+            acc1 = acc1 + tap * SIMDFloat::load(x + W);
+            acc2 = acc2 + tap * SIMDFloat::load(x + 2 * W);
+            acc3 = acc3 + tap * SIMDFloat::load(x + 3 * W);
+        }
+        acc0.store(out + i);
+        acc1.store(out + i + W);
+        acc2.store(out + i + 2 * W);
+        acc3.store(out + i + 3 * W);
+    }
+    for (; i + W <= n; i += W) {
+        SIMDFloat acc = SIMDFloat::broadcast(0.0f);
+        for (int j = 0; j < kTaps; ++j) acc = acc + SIMDFloat::broadcast(taps[j]) * SIMDFloat::load(history + i + (kTaps - 1 - j));
+        acc.store(out + i);
+    }
+    for (; i < n; ++i) {
+        const float *x = history + i;
+        float acc = 0.0f;
+        for (int j = 0; j < kTaps; ++j) acc += taps[j] * x[kTaps - 1 - j];
+        out[i] = acc;
+    }
+}
+
+/*
+ HalfBandStage
+ One 2x step of a half-band filter of length kLength, in either direction:
+   up:   n samples in, 2n out — even outputs are the FIR, odd outputs the delay
+   down: 2n samples in, n out — the FIR over the even inputs plus half the
+         delayed odd input
+ Each direction delays the signal by (kLength - 1) / 2 samples at the 2x rate.
+ An instance keeps one direction's history, so use one per direction.
+ */
+template <int kLength>
+class HalfBandStage {
+public:
+    static constexpr int kTaps  = (kLength + 1) / 2;
+    static constexpr int kDelay = (kLength - 3) / 4;  // k: the delay branch, in low-rate samples
+
+    void initialize(const std::array<float, kTaps> &taps, int maxFrames) {
+        for (int j = 0; j < kTaps; ++j) {
+            mDownTaps[j] = taps[j];
+            mUpTaps[j]   = 2.0f * taps[j];  // zero-stuffing halves the level
+        }
+        mEven.assign(kTaps - 1 + maxFrames, 0.0f);
+        mOdd.assign(kDelay + 1 + maxFrames, 0.0f);
+        mFir.assign(maxFrames, 0.0f);
+    }
+
+    void reset() {
+        std::fill(mEven.begin(), mEven.end(), 0.0f);
+        std::fill(mOdd.begin(), mOdd.end(), 0.0f);
+    }
+
+    // The history carried between blocks (the front of each buffer).
+    void saveState(VXFissionStateWriter &writer) const {
+        writer.floats(mEven.data(), kTaps - 1);
+        writer.floats(mOdd.data(), kDelay + 1);
+    }
+
+    void loadState(VXFissionStateReader &reader) {
+        reader.floats(mEven.data(), kTaps - 1);
+        reader.floats(mOdd.data(), kDelay + 1);
+    }
+
+    void up(const float *in, int n, float *out) {
+        float *x = mEven.data() + (kTaps - 1);
+        std::copy_n(in, n, x);
+        firBlock<kTaps>(mUpTaps, mEven.data(), mFir.data(), n);
+        for (int i = 0; i < n; ++i) {
+            out[2 * i]     = mFir[i];
+            out[2 * i + 1] = x[i - kDelay];
+        }
+        keepHistory(mEven, kTaps - 1, n);
+    }
+
+    void down(const float *in, int n, float *out) {
+        float *even = mEven.data() + (kTaps - 1);
+        float *odd  = mOdd.data() + (kDelay + 1);
+        for (int i = 0; i < n; ++i) {
+            even[i] = in[2 * i];
+            odd[i]  = in[2 * i + 1];
+        }
+        firBlock<kTaps>(mDownTaps, mEven.data(), out, n);
+        for (int i = 0; i < n; ++i) out[i] += 0.5f * odd[i - kDelay - 1];
+        keepHistory(mEven, kTaps - 1, n);
+        keepHistory(mOdd, kDelay + 1, n);
+    }
+
+private:
+    // Moves the newest `history` samples to the front for the next block.
+    static void keepHistory(std::vector<float> &buffer, int history, int n) {
+        std::copy_n(buffer.data() + n, history, buffer.data());
+    }
+
+    float mUpTaps[kTaps]   = {};
+    float mDownTaps[kTaps] = {};
+    std::vector<float> mEven;  // history + block: up input, or down's even phase
+    std::vector<float> mOdd;   // history + block: down's odd phase
+    std::vector<float> mFir;   // up's even outputs before interleaving
+};
+
+/*
+ Oversampler
+ One channel's 1x / 2x / 4x resampler pair. 4x cascades a long first stage,
+ which sets the passband (flat to 0.41 × base rate, images and aliases
+ ≥ 86 dB down), and a short second stage, whose transition band can be wide
+ because the first stage left nothing above the base band. In 4x the second
+ stage's round trip is an odd number of 2x samples, so one 2x sample of
+ padding lands the total latency on a whole base-rate sample.
+ */
+class Oversampler {
+public:
+    static constexpr int kMaxFactor = 4;
+
+    void initialize(int maxFrames) {
+        mUp1.initialize(kStage1Taps, maxFrames);
+        mDown1.initialize(kStage1Taps, maxFrames);
+        mUp2.initialize(kStage2Taps, 2 * maxFrames);
+        mDown2.initialize(kStage2Taps, 2 * maxFrames);
+        mStage.assign(2 * maxFrames, 0.0f);
+        reset();
+    }
+
+    // 1, 2 or 4. Clears the filter history.
+    void setFactor(int factor) {
+        mFactor = (factor >= 4) ? 4 : (factor >= 2) ? 2 : 1;
+        reset();
+    }
+
+    void reset() {
+        mUp1.reset();
+        mDown1.reset();
+        mUp2.reset();
+        mDown2.reset();
+        mPad = 0.0f;
+    }
+
+    int factor() const { return mFactor; }
+
+    void saveState(VXFissionStateWriter &writer) const {
+        mUp1.saveState(writer);
+        mDown1.saveState(writer);
+        mUp2.saveState(writer);
+        mDown2.saveState(writer);
+        writer.value(mPad);
+    }
+
+    void loadState(VXFissionStateReader &reader) {
+        mUp1.loadState(reader);
+        mDown1.loadState(reader);
+        mUp2.loadState(reader);
+        mDown2.loadState(reader);
+        reader.value(mPad);
+    }
+
+    // Round-trip delay of upsample() + downsample(), in base-rate samples.
+    int latency() const { return latencyFor(mFactor); }
+
+    static constexpr int latencyFor(int factor) {
+        constexpr int stage1 = Stage1::kLength - 1;          // 2x samples, both directions
+        constexpr int stage2 = (Stage2::kLength - 1) / 2;    // 4x samples → 2x samples
+        constexpr int padded = stage1 + stage2 + ((stage1 + stage2) & 1);
+        return (factor == 4) ? padded / 2 : (factor == 2) ? stage1 / 2 : 0;
+    }
+
+    // n base-rate samples in, n × factor() out.
+    void upsample(const float *in, int n, float *out) {
+        if (mFactor == 4) {
+            mUp1.up(in, n, mStage.data());
+            mUp2.up(mStage.data(), 2 * n, out);
+        } else if (mFactor == 2) {
+            mUp1.up(in, n, out);
+        } else {
+            std::copy_n(in, n, out);
+        }
+    }
+
+    // n × factor() samples in, n base-rate samples out.
+    void downsample(const float *in, int n, float *out) {
+        if (mFactor == 4) {
+            mDown2.down(in, 2 * n, mStage.data());
+            if (kStage4Pad) {
+                for (int i = 0; i < 2 * n; ++i) std::swap(mStage[i], mPad);
+            }
+            mDown1.down(mStage.data(), n, out);
+        } else if (mFactor == 2) {
+            mDown1.down(in, n, out);
+        } else {
+            std::copy_n(in, n, out);
+        }
+    }
+
+private:
+    struct Stage1 { static constexpr int kLength = 63; };
+    struct Stage2 { static constexpr int kLength = 23; };
+    // Kaiser β 9 and 8: designed at compile time, copied in by initialize().
+    static constexpr auto kStage1Taps = designHalfBand<Stage1::kLength>(9.0);
+    static constexpr auto kStage2Taps = designHalfBand<Stage2::kLength>(8.0);
+    static constexpr bool kStage4Pad = ((Stage1::kLength - 1) + (Stage2::kLength - 1) / 2) & 1;
+
+    HalfBandStage<Stage1::kLength> mUp1, mDown1;
+    HalfBandStage<Stage2::kLength> mUp2, mDown2;
+    std::vector<float> mStage;  // 2x signal between the two stages
+    float mPad    = 0.0f;       // one 2x sample of latency padding (4x only)
+    int   mFactor = 1;
+};
+
+static_assert(Oversampler::latencyFor(4) <= 63, "LatencyDelay must cover the 4x latency");
+
+/*
+ LatencyDelay
+ Delays a signal by a whole number of samples, up to kMaxDelay. Used to keep
+ paths that skip the oversampler (bypass) time-aligned with those that go
+ through it. Keeps the last kMaxDelay input samples in order, so every call
+ is a few block copies rather than a per-sample ring; in and out may alias.
+ */
+class LatencyDelay {
+public:
+    static constexpr int kMaxDelay = 63;
+
+    void reset() {
+        std::fill(std::begin(mHistory), std::end(mHistory), 0.0f);
+    }
+
+    void saveState(VXFissionStateWriter &writer) const { writer.value(mHistory); }
+    void loadState(VXFissionStateReader &reader)       { reader.value(mHistory); }
+
+    // Writes without reading, to keep the line current while it is not used.
+    void push(const float *in, int n) {
+        if (n >= kMaxDelay) {
+            std::copy_n(in + n - kMaxDelay, kMaxDelay, mHistory);
+            return;
+        }
+        std::copy(mHistory + n, mHistory + kMaxDelay, mHistory);
+        std::copy_n(in, n, mHistory + kMaxDelay - n);
+    }
+
+    void process(const float *in, float *out, int n, int delay) {
+        // The `delay` oldest outputs come from before this block: set them
+        // aside, take the block into the history, then shift it into place.
+        float held[kMaxDelay];
+        std::copy_n(mHistory + kMaxDelay - delay, delay, held);
+        push(in, n);
+        if (n > delay) std::copy_backward(in, in + n - delay, out + n);
+        std::copy_n(held, std::min(delay, n), out);
+    }
+
+private:
+    float mHistory[kMaxDelay] = {};  // newest last
+};
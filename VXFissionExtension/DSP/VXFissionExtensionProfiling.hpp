@@ -0,0 +1,290 @@
+//
+//  VXFissionExtensionProfiling.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "VXFissionExtensionLockFree.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+// Render-thread profiling. Off unless the build defines VXFISSION_PROFILING=1
+// (CMake: -DVXFISSION_PROFILING=ON); when off, VXFISSION_PROFILE_STAGE is the
+// bare statement and the core holds no profiler, so nothing is left behind.
+#ifndef VXFISSION_PROFILING
+    #define VXFISSION_PROFILING 0
+#endif
+
+// ─── Cycle counter ───────────────────────────────────────────────────────────
+// The cheapest monotonic counter on the target: the TSC on x86 (reference
+// cycles at a fixed rate, not core clocks), the virtual counter on ARM64 (the
+// same timebase as mach_absolute_time), else steady_clock nanoseconds.
+inline uint64_t readCycleCounter() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+inline const char *cycleCounterName() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    return "tsc";
+#elif defined(__aarch64__)
+    return "cntvct";
+#else
+    return "steady_clock";
+#endif
+}
+
+// Counter ticks per second. Init-time only: on x86 the first call times the
+// counter against steady_clock for a couple of milliseconds, and later calls
+// (every initialize() of every instance) return that measurement.
+inline double cycleCounterFrequency() {
+#if defined(__aarch64__)
+    uint64_t frequency;
+    asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+    return (double)frequency;
+#elif defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    static const double frequency = [] {
+        auto     start = std::chrono::steady_clock::now();
+        uint64_t t0    = readCycleCounter();
+        while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(2)) {}
+        uint64_t t1    = readCycleCounter();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return (double)(t1 - t0) / seconds;
+    }();
+    return frequency;
+#else
+    return 1e9;
+#endif
+}
+
+// ─── Histogram ───────────────────────────────────────────────────────────────
+/*
+ CycleHistogram
+ Log-linear buckets over tick counts: exact below 16, then 8 buckets per
+ octave, so any recorded value is known to within 12.5 % (the maximum is kept
+ exactly). One writer (the render thread) stores with relaxed atomics and no
+ read-modify-write; any other thread may read at the same time. A reader can
+ see a record half applied — one bucket counted, the total not yet — which
+ percentiles over thousands of renders do not notice. Copying takes a relaxed
+ snapshot, as AtomicValue does, so the core stays copyable.
+ */
+class CycleHistogram {
+public:
+    static constexpr int kSubBuckets = 8;
+    static constexpr int kBuckets    = 16 + (64 - 4) * kSubBuckets;
+
+    CycleHistogram() = default;
+    CycleHistogram(const CycleHistogram &other) { *this = other; }
+    CycleHistogram &operator=(const CycleHistogram &other) {
+        for (int i = 0; i < kBuckets; ++i) mBuckets[i].store(other.mBuckets[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        mCount.store(other.count(), std::memory_order_relaxed);
+        mSum.store(other.sum(), std::memory_order_relaxed);
+        mMax.store(other.max(), std::memory_order_relaxed);
+        return *this;
+    }
+
+    // MARK: Writer
+    void record(uint64_t ticks) {
+        std::atomic<uint32_t> &bucket = mBuckets[bucketFor(ticks)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        mCount.store(mCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        mSum.store(mSum.load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+        if (ticks > mMax.load(std::memory_order_relaxed)) mMax.store(ticks, std::memory_order_relaxed);
+    }
+
+    void clear() {
+        for (std::atomic<uint32_t> &bucket : mBuckets) bucket.store(0, std::memory_order_relaxed);
+        mCount.store(0, std::memory_order_relaxed);
+        mSum.store(0, std::memory_order_relaxed);
+        mMax.store(0, std::memory_order_relaxed);
+    }
+
+    // MARK: Reader
+    uint64_t count() const { return mCount.load(std::memory_order_relaxed); }
+    uint64_t sum() const   { return mSum.load(std::memory_order_relaxed); }
+    uint64_t max() const   { return mMax.load(std::memory_order_relaxed); }
+
+    // Value at quantile q in [0, 1]: the middle of the bucket holding it.
+    double percentile(double q) const {
+        uint64_t total = 0;
+        for (const std::atomic<uint32_t> &bucket : mBuckets) total += bucket.load(std::memory_order_relaxed);
+        if (total == 0) return 0.0;
+        const uint64_t rank = std::min<uint64_t>(total - 1, (uint64_t)(q * (double)total));
+        uint64_t seen = 0;
+        for (int i = 0; i < kBuckets; ++i) {
+            seen += mBuckets[i].load(std::memory_order_relaxed);
+            if (seen > rank) return std::min((double)max(), 0.5 * (bucketLow(i) + bucketLow(i + 1)));
+        }
+        return (double)max();
+    }
+
+private:
+    static int bucketFor(uint64_t ticks) {
+        if (ticks < 16) return (int)ticks;
+        const int octave = 63 - __builtin_clzll(ticks);  // ≥ 4
+        const int sub    = (int)(ticks >> (octave - 3)) & (kSubBuckets - 1);
+        return 16 + (octave - 4) * kSubBuckets + sub;
+    }
+
+    static double bucketLow(int index) {
+        if (index < 16) return (double)index;
+        const int octave = 4 + (index - 16) / kSubBuckets;
+        const int sub    = (index - 16) % kSubBuckets;
+        return std::ldexp(1.0 + sub / (double)kSubBuckets, octave);
+    }
+
+    std::atomic<uint32_t> mBuckets[kBuckets] {};
+    std::atomic<uint64_t> mCount { 0 };
+    std::atomic<uint64_t> mSum { 0 };
+    std::atomic<uint64_t> mMax { 0 };
+};
+
+// ─── Profiler ────────────────────────────────────────────────────────────────
+enum class VXFissionStage : int {
+    Control,   // updateControl: smoother, LFO, gains
+    Write,     // writeDelayLines
+    Haas,      // readHaas
+    Chorus,    // applyChorus
+    Reverb,    // applyReverb
+    Mix,       // mixAndCompress: blend and output compressor
+    Process,   // all of the core's process() calls in the render
+    Render,    // the whole render call (internalRenderBlock: pull, events, process)
+    Count
+};
+
+inline const char *stageName(VXFissionStage stage) {
+    static const char *names[] = { "control", "write", "haas", "chorus", "reverb", "mix", "process", "render" };
+    return names[(int)stage];
+}
+
+/*
+ VXFissionProfiler
+ Stage times are summed over a render call (the host's render may split into
+ several process() calls around events), then each stage's total goes into
+ its histogram once per render. A render that takes longer than
+ frameCount / sampleRate counts as a deadline miss. Render-thread side:
+ beginRender / addStage / endRender. Any other thread: toJSON(), reset().
+ Copyable: the shared counters are snapshots (CycleHistogram, AtomicValue).
+ */
+class VXFissionProfiler {
+public:
+    static constexpr int kStages = (int)VXFissionStage::Count;
+
+    // Not on the render thread.
+    void initialize(double sampleRate) {
+        mTicksPerSecond = cycleCounterFrequency();
+        mSampleRate    = sampleRate;
+        mTicksPerFrame = mTicksPerSecond / sampleRate;
+        reset();
+    }
+
+    // MARK: Render thread
+    bool renderOpen() const { return mRenderOpen; }
+
+    void beginRender() {
+        std::fill(std::begin(mPending), std::end(mPending), 0);
+        mRenderOpen  = true;
+        mRenderStart = readCycleCounter();
+    }
+
+    void addStage(VXFissionStage stage, uint64_t ticks) {
+        mPending[(int)stage] += ticks;
+    }
+
+    void endRender(uint32_t frameCount) {
+        mPending[(int)VXFissionStage::Render] = readCycleCounter() - mRenderStart;
+        mRenderOpen = false;
+        if (mResetRequested.exchange(false)) {
+            for (CycleHistogram &histogram : mHistograms) histogram.clear();
+            mDeadlineMisses.store(0);
+        }
+        for (int s = 0; s < kStages; ++s) mHistograms[s].record(mPending[s]);
+        if ((double)mPending[(int)VXFissionStage::Render] > (double)frameCount * mTicksPerFrame) {
+            mDeadlineMisses.store(mDeadlineMisses.load() + 1);
+        }
+    }
+
+    // MARK: Any thread
+    // Applied by the render thread at its next endRender().
+    void reset() {
+        mResetRequested.store(true);
+    }
+
+    const CycleHistogram &histogram(VXFissionStage stage) const { return mHistograms[(int)stage]; }
+    uint64_t deadlineMisses() const { return mDeadlineMisses.load(); }
+
+    // Per stage: renders recorded, and p50 / p99 / max / mean in microseconds.
+    std::string toJSON() const {
+        const double usPerTick = (mTicksPerSecond > 0.0) ? 1e6 / mTicksPerSecond : 0.0;
+        char line[256];
+        std::string json = "{\n";
+        std::snprintf(line, sizeof line,
+                      "  \"counter\": \"%s\",\n  \"ticksPerSecond\": %.0f,\n  \"sampleRate\": %.0f,\n"
+                      "  \"renders\": %llu,\n  \"deadlineMisses\": %llu,\n  \"stages\": {\n",
+                      cycleCounterName(), mTicksPerSecond, mSampleRate,
+                      (unsigned long long)histogram(VXFissionStage::Render).count(),
+                      (unsigned long long)deadlineMisses());
+        json += line;
+        for (int s = 0; s < kStages; ++s) {
+            const CycleHistogram &h = mHistograms[s];
+            const double mean = h.count() ? (double)h.sum() / (double)h.count() : 0.0;
+            std::snprintf(line, sizeof line,
+                          "    \"%s\": { \"count\": %llu, \"p50Us\": %.3f, \"p99Us\": %.3f, \"maxUs\": %.3f, \"meanUs\": %.3f }%s\n",
+                          stageName((VXFissionStage)s), (unsigned long long)h.count(),
+                          h.percentile(0.50) * usPerTick, h.percentile(0.99) * usPerTick,
+                          (double)h.max() * usPerTick, mean * usPerTick,
+                          s + 1 < kStages ? "," : "");
+            json += line;
+        }
+        json += "  }\n}\n";
+        return json;
+    }
+
+private:
+    CycleHistogram        mHistograms[kStages];
+    AtomicValue<uint64_t> mDeadlineMisses { 0 };
+    AtomicValue<bool>     mResetRequested { false };
+
+    // Render thread only
+    uint64_t mPending[kStages] = {};
+    uint64_t mRenderStart      = 0;
+    bool     mRenderOpen       = false;
+
+    double mTicksPerSecond = 0.0;
+    double mTicksPerFrame  = 0.0;
+    double mSampleRate     = 0.0;
+};
+
+// Times `statement` as `stage` of the current render, or is just `statement`
+// when profiling is compiled out.
+#if VXFISSION_PROFILING
+    #define VXFISSION_PROFILE_STAGE(profiler, stage, ...)            \
+        do {                                                         \
+            const uint64_t vxfissionStageStart = readCycleCounter(); \
+            __VA_ARGS__;                                             \
+            (profiler).addStage(stage, readCycleCounter() - vxfissionStageStart); \
+        } while (0)
+#else
+    #define VXFISSION_PROFILE_STAGE(profiler, stage, ...) do { __VA_ARGS__; } while (0)
+#endif
@@ -0,0 +1,185 @@
+//
+//  VXFissionExtensionQuality.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "VXFissionExtensionProfiling.hpp"
+
+// ─── Wet-bus quality tiers ───────────────────────────────────────────────────
+// What the wet bus spends per frame. The dry path, the Haas read and the
+// compressor are the same in every tier.
+//
+//   Eco       4 + 4 reverb combs, linear chorus read, control interval × 4
+//   Standard  8 + 8 combs, linear chorus read, the configured control interval
+//   High      8 + 8 combs, Hermite chorus read, control interval ÷ 4
+//
+// The convolution reverb, when selected, is the same in every tier.
+enum class VXFissionQualityTier : int {
+    Eco      = 0,
+    Standard = 1,
+    High     = 2,
+};
+
+// The quality parameter: a fixed tier, or Auto to let the governor choose.
+// The values are the Audio Unit parameter's indices.
+enum class VXFissionQualityMode : int {
+    Auto     = 0,
+    Eco      = 1,
+    Standard = 2,
+    High     = 3,
+};
+
+inline constexpr int kQualityTiers = 3;
+
+inline const char *qualityTierName(VXFissionQualityTier tier) {
+    switch (tier) {
+        case VXFissionQualityTier::Eco:      return "eco";
+        case VXFissionQualityTier::Standard: return "standard";
+        case VXFissionQualityTier::High:     return "high";
+    }
+    return "?";
+}
+
+// ─── Governor ────────────────────────────────────────────────────────────────
+// Load is render time over the buffer's duration, divided by budgetShare:
+// 1.0 means the render took the whole share of the deadline it may use. A
+// plugin cannot see how busy the rest of the host's render is, so the share
+// is how much of each buffer period this instance claims. The default leaves
+// three quarters to the rest of the graph: at 1.0 Auto would only step down
+// once this instance alone nearly filled the period, which protects nothing
+// when it is one of several plugins.
+struct VXFissionGovernorSettings {
+    double budgetShare      = 0.25;   // of each buffer period
+    double panicLoad        = 0.90;   // one render above this steps down at once
+    double stepDownLoad     = 0.70;   // smoothed load above this steps down
+    double stepUpLoad       = 0.35;   // smoothed load below this, for stepUpSeconds, steps up
+    double stepUpSeconds    = 2.0;
+    double holdSeconds      = 0.5;    // after a switch, only a panic switches again
+    double smoothingSeconds = 0.25;   // time constant of the smoothed load
+};
+
+/*
+ VXFissionQualityGovernor
+ Picks a tier from the measured render time. One overrunning render steps
+ down a tier at once; otherwise the load is smoothed over audio time and
+ steps down when it stays high, and up only after it has been well below the
+ step-down level for stepUpSeconds, so a tier that fits is not left for one
+ that would not. A step down soon after a step up doubles the wait before the
+ next step up (up to 8×), so a load sitting between two tiers settles on the
+ lower one instead of bouncing.
+
+ beginRender, endRender and restart on the render thread; initialize and
+ setSettings are not for use while rendering. The counter frequency is
+ measured once per process.
+ */
+class VXFissionQualityGovernor {
+public:
+    void setSettings(const VXFissionGovernorSettings &settings) {
+        mSettings = settings;
+        if (mSampleRate > 0.0) initialize(mSampleRate);
+    }
+
+    const VXFissionGovernorSettings &settings() const { return mSettings; }
+
+    void initialize(double sampleRate) {
+        static const double ticksPerSecond = cycleCounterFrequency();
+        mSampleRate      = sampleRate;
+        mTicksPerFrame   = ticksPerSecond / sampleRate * std::max(mSettings.budgetShare, 1e-3);
+        mStepUpFrames    = (int64_t)(mSettings.stepUpSeconds * sampleRate);
+        mHoldFrames      = (int64_t)(mSettings.holdSeconds * sampleRate);
+        mSmoothingFrames = mSettings.smoothingSeconds * sampleRate;
+        restart(mTier);
+    }
+
+    // Starts governing from `tier`, with no load history. A render being
+    // timed stays open.
+    void restart(VXFissionQualityTier tier) {
+        mTier         = tier;
+        mLoad         = 0.0;
+        mLastLoad     = 0.0;
+        mLowFrames    = 0;
+        mHoldLeft     = mHoldFrames;
+        mSinceStepUp  = INT64_MAX / 2;
+        mStepUpWait   = mStepUpFrames;
+    }
+
+    // MARK: Render thread
+    bool renderOpen() const { return mRenderOpen; }
+
+    void beginRender() {
+        mRenderOpen  = true;
+        mRenderStart = readCycleCounter();
+    }
+
+    void endRender(uint32_t frameCount) {
+        const uint64_t ticks = readCycleCounter() - mRenderStart;
+        mRenderOpen = false;
+        if (frameCount == 0) return;
+
+        const double frames = (double)frameCount;
+        mLastLoad = (double)ticks / (frames * mTicksPerFrame);
+        mLoad    += (mLastLoad - mLoad) * (frames / (frames + mSmoothingFrames));
+        mHoldLeft     = std::max<int64_t>(0, mHoldLeft - frameCount);
+        mSinceStepUp += frameCount;
+
+        if (mLastLoad > mSettings.panicLoad) {
+            stepDown();
+            return;
+        }
+        if (mHoldLeft > 0) return;
+        if (mLoad > mSettings.stepDownLoad) {
+            stepDown();
+            return;
+        }
+        if (mLoad < mSettings.stepUpLoad && mTier != VXFissionQualityTier::High) {
+            mLowFrames += frameCount;
+            if (mLowFrames >= mStepUpWait) step(+1);
+        } else {
+            mLowFrames = 0;
+        }
+        // A tier that has held since the last step up resets the backoff.
+        if (mSinceStepUp >= 4 * mStepUpFrames) mStepUpWait = mStepUpFrames;
+    }
+
+    VXFissionQualityTier tier() const { return mTier; }
+    double load() const               { return mLoad; }      // smoothed
+    double lastLoad() const           { return mLastLoad; }  // the last render's
+
+private:
+    void stepDown() {
+        if (mTier == VXFissionQualityTier::Eco) return;
+        if (mSinceStepUp < mStepUpFrames) mStepUpWait = std::min(mStepUpWait * 2, 8 * mStepUpFrames);
+        step(-1);
+    }
+
+    void step(int direction) {
+        mTier      = (VXFissionQualityTier)std::clamp((int)mTier + direction, 0, kQualityTiers - 1);
+        mLowFrames = 0;
+        mHoldLeft  = mHoldFrames;
+        if (direction > 0) mSinceStepUp = 0;
+    }
+
+    VXFissionGovernorSettings mSettings;
+    double   mSampleRate      = 0.0;
+    double   mTicksPerFrame   = 1.0;   // counter ticks per frame of budget
+    double   mSmoothingFrames = 1.0;
+    int64_t  mStepUpFrames    = 0;
+    int64_t  mHoldFrames      = 0;
+
+    VXFissionQualityTier mTier = VXFissionQualityTier::Standard;
+    double   mLoad        = 0.0;
+    double   mLastLoad    = 0.0;
+    int64_t  mLowFrames   = 0;       // consecutive frames below stepUpLoad
+    int64_t  mHoldLeft    = 0;       // frames until a non-panic switch is allowed
+    int64_t  mSinceStepUp = 0;
+    int64_t  mStepUpWait  = 0;       // mStepUpFrames, doubled by backoff
+    uint64_t mRenderStart = 0;
+    bool     mRenderOpen  = false;
+};
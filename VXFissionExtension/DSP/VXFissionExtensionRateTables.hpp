@@ -0,0 +1,95 @@
+//
+//  VXFissionExtensionRateTables.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "VXFissionExtensionCompressor.hpp"
+#include "VXFissionExtensionConstexprMath.hpp"
+
+/*
+ VXFissionRateTuning
+ Everything initialize() derives from the sample rate by transcendental
+ math: the delay smoother's coefficient, the compressor's attack and release
+ at each oversampling factor, and the bypass crossfade curve. The standard
+ rates (44.1, 48, 88.2, 96, 176.4 and 192 kHz) are tabulated at compile time,
+ so initialising at one of them is a lookup. Any other rate is computed by
+ the same constexpr code at runtime, and gets its fade curve built into a
+ buffer the caller owns.
+ */
+struct VXFissionRateTuning {
+    static constexpr double kSmoothingSeconds  = 0.020;  // delay-time smoother time constant
+    static constexpr double kBypassFadeSeconds = 0.010;  // bypass crossfade length
+
+    double sampleRate       = 0.0;
+    float  smoothingCoeff   = 0.0f;
+    OutputCompressor::Envelope compressor;
+    int    bypassFadeFrames = 1;
+    // Equal-power fade, sin(π/2 · k / bypassFadeFrames) for k = 0…bypassFadeFrames.
+    // Null when the rate is not tabulated.
+    const float *bypassFade = nullptr;
+
+    static constexpr int fadeFramesFor(double sampleRate) {
+        return std::max(1, (int)(sampleRate * kBypassFadeSeconds));
+    }
+
+    static constexpr float fadeStep(int k, int frames) {
+        return (float)vxfission_constexpr::sin(0.5 * M_PI * k / frames);
+    }
+
+    static constexpr VXFissionRateTuning compute(double sampleRate) {
+        VXFissionRateTuning tuning;
+        tuning.sampleRate       = sampleRate;
+        tuning.smoothingCoeff   = vxfission_constexpr::onePoleCoefficient(sampleRate, kSmoothingSeconds);
+        tuning.compressor       = OutputCompressor::envelopeFor(sampleRate);
+        tuning.bypassFadeFrames = fadeFramesFor(sampleRate);
+        return tuning;
+    }
+};
+
+namespace vxfission_rate_tables {
+
+template <int kRate>
+constexpr auto makeBypassFade() {
+    constexpr int kFrames = VXFissionRateTuning::fadeFramesFor(kRate);
+    std::array<float, kFrames + 1> fade {};
+    for (int k = 0; k <= kFrames; ++k) fade[k] = VXFissionRateTuning::fadeStep(k, kFrames);
+    return fade;
+}
+
+template <int kRate>
+inline constexpr auto kBypassFade = makeBypassFade<kRate>();
+
+template <int kRate>
+constexpr VXFissionRateTuning tabulate() {
+    VXFissionRateTuning tuning = VXFissionRateTuning::compute(kRate);
+    tuning.bypassFade = kBypassFade<kRate>.data();
+    return tuning;
+}
+
+inline constexpr VXFissionRateTuning kStandard[] = {
+    tabulate<44100>(), tabulate<48000>(), tabulate<88200>(),
+    tabulate<96000>(), tabulate<176400>(), tabulate<192000>(),
+};
+
+} // namespace vxfission_rate_tables
+
+// The tuning for sampleRate: a table entry, or computed now (init-time only)
+// with its fade curve written to fadeStorage.
+inline VXFissionRateTuning rateTuningFor(double sampleRate, std::vector<float> &fadeStorage) {
+    for (const VXFissionRateTuning &tuning : vxfission_rate_tables::kStandard) {
+        if (tuning.sampleRate == sampleRate) return tuning;
+    }
+    VXFissionRateTuning tuning = VXFissionRateTuning::compute(sampleRate);
+    fadeStorage.resize(tuning.bypassFadeFrames + 1);
+    for (int k = 0; k <= tuning.bypassFadeFrames; ++k) fadeStorage[k] = VXFissionRateTuning::fadeStep(k, tuning.bypassFadeFrames);
+    tuning.bypassFade = fadeStorage.data();
+    return tuning;
+}
@@ -0,0 +1,485 @@
+//
+//  VXFissionExtensionReverb.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "VXFissionExtensionDelayArena.hpp"
+#include "VXFissionExtensionDenormals.hpp"
+#include "VXFissionExtensionSIMD.hpp"
+
+// ─── Reverb building blocks (Freeverb-style, public domain) ──────────────────
+// Scalar reference versions. The render path uses FreeverbBank below; these are
+// kept as the accuracy/speed baseline for the reverb microbenchmark.
+
+struct CombFilter {
+    std::vector<float> buf;
+    int   head     = 0;
+    float feedback = 0.90f;
+    float damp     = 0.15f;  // one-pole LP damping: 0 = bright, 1 = dark
+    float store    = 0.0f;   // LP filter state
+
+    void init(int delaySamples, float fb, float d) {
+        buf.assign(delaySamples, 0.0f);
+        head = 0; feedback = fb; damp = d; store = 0.0f;
+    }
+    float process(float in) {
+        float out = buf[head];
+        store     = out * (1.0f - damp) + store * damp;
+        buf[head] = withDenormalOffset(in) + store * feedback;
+        head      = (head + 1 < (int)buf.size()) ? head + 1 : 0;
+        return out;
+    }
+};
+
+struct AllPassFilter {
+    std::vector<float> buf;
+    int   head     = 0;
+    float feedback = 0.5f;
+
+    void init(int delaySamples) {
+        buf.assign(delaySamples, 0.0f);
+        head = 0;
+    }
+    float process(float in) {
+        float out = buf[head];
+        buf[head] = in + out * feedback;
+        head      = (head + 1 < (int)buf.size()) ? head + 1 : 0;
+        return out - in;
+    }
+};
+
+// Freeverb tuning shared by the reference filters and FreeverbBank.
+// Delay times derived from Freeverb's tuned 44100 Hz constants (public domain).
+struct FreeverbTuning {
+    static constexpr int   kCombsPerSide    = 8;
+    static constexpr int   kAllPassPerSide  = 4;
+    static constexpr float kCombMs[kCombsPerSide]      = { 25.31f, 26.94f, 28.96f, 30.75f,
+                                                           32.24f, 33.81f, 35.31f, 36.66f };
+    static constexpr float kAllPassMs[kAllPassPerSide] = { 12.61f, 10.00f,  7.73f,  5.10f };
+    static constexpr float kStereoSpreadMs  = 0.521f;   // ~23 samples at 44100
+    static constexpr float kFeedback        = 0.94f;
+    static constexpr float kDamp            = 0.15f;
+    static constexpr float kAllPassFeedback = 0.5f;
+
+    static int spread(double sampleRate)           { return (int)(kStereoSpreadMs * (float)sampleRate / 1000.0f); }
+    static int combLength(int i, double sr)        { return (int)(kCombMs[i] * (float)sr / 1000.0f); }
+    static int allPassLength(int i, double sr)     { return (int)(kAllPassMs[i] * (float)sr / 1000.0f); }
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+
+/*
+ FreeverbBankT
+ The 8 L + 8 R combs run as 16 SIMD lanes. Instead of one ring per comb they
+ share a single time-interleaved ring (one 16-float row per sample): every
+ sample writes one full row with vector stores, and each lane gathers its
+ output from the row `combLength` samples back. The damping recursion is
+ serial in time but independent across combs, so it vectorises across lanes.
+
+ Lanes run in groups of four, L0–3 R0–3 L4–7 R4–7, so the first half of the
+ row is four combs a side at any vector width. setCombsPerSide(4) runs only
+ those (the eco quality tier), each at √2 the gain so the tail keeps its
+ power; a change crossfades per-lane gains over the frames it is given.
+
+ The all-passes are in series, so they cannot be lanes; instead each one is
+ run across time over the whole block, which is element-wise within a run
+ between wraps and vectorises along the block.
+
+ The rings are lines in the owner's DelayArenaT (layout() reserves them,
+ every other call is handed the same arena), all power-of-two sized so row
+ and index wraps are masks. Output matches the scalar CombFilter /
+ AllPassFilter chain except for the order of the eight-way comb sum, which
+ the vector reduction performs as a tree.
+
+ With a narrower `Sample` than float the rings hold the encoded samples:
+ each comb row's 16 gathered taps are decoded together and the row written
+ back is encoded together, and the all-passes decode their read run and
+ encode their write run a chunk at a time. Only what the rings hold is
+ rounded; the damping state and all arithmetic stay float.
+ */
+template <typename Sample>
+class FreeverbBankT {
+public:
+    using Arena = DelayArenaT<Sample>;
+
+    static constexpr int kSides     = 2;
+    static constexpr int kCombLanes = FreeverbTuning::kCombsPerSide * kSides;
+    static constexpr int kAllPasses = FreeverbTuning::kAllPassPerSide * kSides;
+    static constexpr int kVectors   = kCombLanes / SIMDFloat::kWidth;
+
+    // Reserves the bank's rings in `arena`; call between beginLayout() and
+    // allocate(), then reset() once the arena is allocated.
+    void layout(Arena &arena, double sampleRate) {
+        const int spread = FreeverbTuning::spread(sampleRate);
+        mLongestComb = 0;
+        for (int lane = 0; lane < kCombLanes; ++lane) {
+            mCombLength[lane] = FreeverbTuning::combLength(combOf(lane), sampleRate) + sideOf(lane) * spread;
+            mLongestComb      = std::max(mLongestComb, mCombLength[lane]);
+        }
+        // At least one spare row so the longest comb never reads the row being written.
+        mCombRows    = (int)nextPowerOfTwo((size_t)mLongestComb + 1);
+        mCombRowMask = mCombRows - 1;
+        mCombRing    = arena.reserve((size_t)mCombRows * kCombLanes);
+
+        for (int i = 0; i < FreeverbTuning::kAllPassPerSide; ++i) {
+            int dL = FreeverbTuning::allPassLength(i, sampleRate);
+            mAllPassLength[i]                                  = dL;
+            mAllPassLength[i + FreeverbTuning::kAllPassPerSide] = dL + spread;
+        }
+        for (int i = 0; i < kAllPasses; ++i) {
+            mAllPassRing[i] = arena.reserveRing((size_t)mAllPassLength[i]);
+        }
+        mLaidOut = true;
+    }
+
+    void release() {
+        mLaidOut = false;
+    }
+
+    // Silences all rings and filter state without reallocating.
+    void reset(Arena &arena) {
+        arena.clear(mCombRing);
+        for (const DelayLine &ring : mAllPassRing) arena.clear(ring);
+        resetState();
+    }
+
+    // Filter state only, for when the owner has already cleared the arena.
+    // A comb-count crossfade in progress lands on its target.
+    void resetState() {
+        mWriteRow = 0;
+        std::fill(std::begin(mCombStore), std::end(mCombStore), 0.0f);
+        std::fill(std::begin(mAllPassHead), std::end(mAllPassHead), 0);
+        setGains(mTargetVectors);
+        mActiveVectors  = mTargetVectors;
+        mGainFramesLeft = 0;
+    }
+
+    /*
+     Combs per side: kCombsPerSide, or half that. The change crossfades over
+     fadeFrames (at once for 0, or while the bank is silent anyway). Leaving
+     lanes stop once their gain reaches zero and their ring lanes and damping
+     state are cleared, so they come back in from silence. Render thread,
+     with the arena the bank was laid out in.
+     */
+    void setCombsPerSide(Arena &arena, int combs, int fadeFrames) {
+        const int target = (combs < FreeverbTuning::kCombsPerSide) ? kVectors / 2 : kVectors;
+        if (target == mTargetVectors) return;
+        mTargetVectors = target;
+        if (fadeFrames <= 0 || !mLaidOut) {
+            mActiveVectors  = target;
+            mGainFramesLeft = 0;
+            setGains(target);
+            if (target < kVectors && mLaidOut) clearUpperLanes(arena);
+            return;
+        }
+        // From wherever the gains are now, including part-way through a fade.
+        float targetGain[kCombLanes];
+        gainsFor(target, targetGain);
+        for (int lane = 0; lane < kCombLanes; ++lane) {
+            mCombGainStep[lane] = (targetGain[lane] - mCombGain[lane]) / (float)fadeFrames;
+        }
+        mActiveVectors  = kVectors;
+        mGainFramesLeft = fadeFrames;
+    }
+
+    bool empty() const { return !mLaidOut; }
+
+    // Filter state; the rings are saved with the arena.
+    void saveState(VXFissionStateWriter &writer) const {
+        writer.value(mWriteRow);
+        writer.value(mCombStore);
+        writer.value(mAllPassHead);
+        writer.value(mActiveVectors);
+        writer.value(mTargetVectors);
+        writer.value(mGainFramesLeft);
+        writer.value(mCombGain);
+        writer.value(mCombGainStep);
+    }
+
+    void loadState(VXFissionStateReader &reader) {
+        reader.value(mWriteRow);
+        reader.value(mCombStore);
+        reader.value(mAllPassHead);
+        reader.value(mActiveVectors);
+        reader.value(mTargetVectors);
+        reader.value(mGainFramesLeft);
+        reader.value(mCombGain);
+        reader.value(mCombGainStep);
+    }
+
+    // Largest magnitude held anywhere in the bank: every ring sample plus the
+    // damping state. Scans every ring, so callers only ask for it when the
+    // output has already been quiet for settleFrames().
+    float peakLevel(const Arena &arena) const {
+        float peak = ringPeak(arena.data(mCombRing), (size_t)mCombRing.size);
+        for (const DelayLine &ring : mAllPassRing) peak = std::max(peak, ringPeak(arena.data(ring), (size_t)ring.size));
+        for (float store : mCombStore) peak = std::max(peak, std::fabs(store));
+        return peak;
+    }
+
+    // Frames for a sample entering the bank to work through the longest comb
+    // and the whole all-pass chain: after this many quiet output frames, any
+    // remaining energy would have shown up at the output.
+    int settleFrames() const {
+        int chain = 0;
+        for (int side = 0; side < kSides; ++side) {
+            int sum = 0;
+            for (int i = 0; i < FreeverbTuning::kAllPassPerSide; ++i) {
+                sum += mAllPassLength[side * FreeverbTuning::kAllPassPerSide + i];
+            }
+            chain = std::max(chain, sum);
+        }
+        return mLongestComb + 1 + chain;
+    }
+
+    /*
+     Feeds n mono samples through both comb banks and all-pass chains.
+     outL/outR receive the diffused reverb, already scaled by 1/8 (by √2/8
+     with four combs a side).
+     */
+    void process(Arena &arena, const float *in, float *outL, float *outR, int n) {
+        Sample *ring = arena.data(mCombRing);
+        for (int k = 0; k < n; ) {
+            if (mGainFramesLeft > 0) {
+                const int run = std::min(n - k, mGainFramesLeft);
+                processCombs<kVectors, true>(ring, in + k, outL + k, outR + k, run, 1.0f);
+                mGainFramesLeft -= run;
+                k += run;
+                if (mGainFramesLeft == 0) finishGainFade(arena);
+            } else if (mActiveVectors == kVectors) {
+                processCombs<kVectors, false>(ring, in + k, outL + k, outR + k, n - k, kCombScale);
+                k = n;
+            } else {
+                processCombs<kVectors / 2, false>(ring, in + k, outL + k, outR + k, n - k, kHalfCombScale);
+                k = n;
+            }
+        }
+        for (int i = 0; i < FreeverbTuning::kAllPassPerSide; ++i) {
+            processAllPass(arena, i, outL, n);
+            processAllPass(arena, i + FreeverbTuning::kAllPassPerSide, outR, n);
+        }
+    }
+
+private:
+    static constexpr bool  kFloatRings    = std::is_same_v<Sample, float>;
+    static constexpr int   kChunk         = 64;  // narrow rings: samples decoded / encoded at a time
+    static constexpr float kCombScale     = 0.125f;                    // 1/8
+    static constexpr float kHalfCombScale = 0.125f * 1.41421356f;      // four combs a side, same power
+
+    // Lane → Freeverb comb index and side (0 = L, 1 = R).
+    static constexpr int combOf(int lane) { return (lane / 8) * 4 + lane % 4; }
+    static constexpr int sideOf(int lane) { return (lane / 4) % 2; }
+
+    void gainsFor(int vectors, float *gain) const {
+        const float scale = (vectors == kVectors) ? kCombScale : kHalfCombScale;
+        for (int lane = 0; lane < kCombLanes; ++lane) gain[lane] = (lane < vectors * SIMDFloat::kWidth) ? scale : 0.0f;
+    }
+
+    void setGains(int vectors) {
+        gainsFor(vectors, mCombGain);
+        std::fill(std::begin(mCombGainStep), std::end(mCombGainStep), 0.0f);
+    }
+
+    void finishGainFade(Arena &arena) {
+        setGains(mTargetVectors);
+        mActiveVectors = mTargetVectors;
+        if (mActiveVectors < kVectors) clearUpperLanes(arena);
+    }
+
+    // The second half of every comb row, and its damping state: the lanes
+    // four-a-side leaves idle.
+    void clearUpperLanes(Arena &arena) {
+        constexpr int kFirst = kCombLanes / 2;
+        Sample *row = arena.data(mCombRing);
+        for (int r = 0; r < mCombRows; ++r, row += kCombLanes) std::fill(row + kFirst, row + kCombLanes, Sample {});
+        std::fill(mCombStore + kFirst, mCombStore + kCombLanes, 0.0f);
+    }
+
+    static float ringPeak(const Sample *ring, size_t n) {
+        if constexpr (kFloatRings) {
+            return peakAbs(ring, n);
+        } else {
+            alignas(kCacheLineBytes) float decoded[kChunk];
+            float peak = 0.0f;
+            for (size_t i = 0; i < n; i += kChunk) {
+                const size_t m = std::min<size_t>(kChunk, n - i);
+                decodeDelaySamples(ring + i, decoded, m);
+                peak = std::max(peak, peakAbs(decoded, m));
+            }
+            return peak;
+        }
+    }
+
+    /*
+     n frames of the first kActive vectors of combs. Without kGains every
+     lane is scaled by `scale`; with them each lane has its own gain, stepped
+     every frame (a comb-count crossfade). Each side's taps are summed in
+     comb order, as the reference chain does, up to the tree of the vector
+     reduction.
+     */
+    template <int kActive, bool kGains>
+    void processCombs(Sample *ring, const float *in, float *outL, float *outR, int n, float scale) {
+        constexpr int W     = SIMDFloat::kWidth;
+        constexpr int kLanes = kActive * W;
+
+        const SIMDFloat feedback     = SIMDFloat::broadcast(FreeverbTuning::kFeedback);
+        const SIMDFloat damp         = SIMDFloat::broadcast(FreeverbTuning::kDamp);
+        const SIMDFloat oneMinusDamp = SIMDFloat::broadcast(1.0f - FreeverbTuning::kDamp);
+
+        SIMDFloat store[kActive];
+        SIMDFloat gain[kGains ? kActive : 1];
+        SIMDFloat gainStep[kGains ? kActive : 1];
+        for (int v = 0; v < kActive; ++v) store[v] = SIMDFloat::load(mCombStore + v * W);
+        if constexpr (kGains) {
+            for (int v = 0; v < kActive; ++v) {
+                gain[v]     = SIMDFloat::load(mCombGain + v * W);
+                gainStep[v] = SIMDFloat::load(mCombGainStep + v * W);
+            }
+        }
+
+        int k = 0;
+        while (k < n) {
+            // Longest stretch in which neither the write row nor any read row
+            // wraps, so each lane's gather offset stays constant.
+            int run = std::min(n - k, mCombRows - mWriteRow);
+            alignas(kCacheLineBytes) int32_t offsets[kCombLanes];
+            for (int lane = 0; lane < kLanes; ++lane) {
+                int readRow = (mWriteRow - mCombLength[lane]) & mCombRowMask;
+                run = std::min(run, mCombRows - readRow);
+                offsets[lane] = (readRow - mWriteRow) * kCombLanes + lane;
+            }
+
+            Sample *row = ring + (size_t)mWriteRow * kCombLanes;
+            for (int j = 0; j < run; ++j, row += kCombLanes) {
+                const SIMDFloat x = SIMDFloat::broadcast(withDenormalOffset(in[k + j]));
+                // Vectors of four lanes alternate sides; a wider vector holds
+                // four of each, split after the sum.
+                SIMDFloat sum[2] = { SIMDFloat::broadcast(0.0f), SIMDFloat::broadcast(0.0f) };
+                alignas(kCacheLineBytes) float taps[kCombLanes];
+                alignas(kCacheLineBytes) float next[kCombLanes];
+                if constexpr (!kFloatRings) {
+                    alignas(kCacheLineBytes) Sample gathered[kCombLanes];
+                    for (int lane = 0; lane < kLanes; ++lane) gathered[lane] = row[offsets[lane]];
+                    decodeDelaySamples(gathered, taps, kLanes);
+                }
+                for (int v = 0; v < kActive; ++v) {
+                    SIMDFloat out;
+                    if constexpr (kFloatRings) out = SIMDFloat::gather(row, offsets + v * W);
+                    else                       out = SIMDFloat::load(taps + v * W);
+                    store[v] = out * oneMinusDamp + store[v] * damp;
+                    if constexpr (kFloatRings) (x + store[v] * feedback).store(row + v * W);
+                    else                       (x + store[v] * feedback).store(next + v * W);
+                    if constexpr (kGains) {
+                        out     = out * gain[v];
+                        gain[v] = gain[v] + gainStep[v];
+                    }
+                    const int side = (W >= 8) ? 0 : (v * W / 4) % 2;
+                    sum[side] = sum[side] + out;
+                }
+                if constexpr (!kFloatRings) encodeDelaySamples(next, row, kLanes);
+                float left, right;
+                if constexpr (W >= 8) {
+                    sum[0].halfSums(left, right);
+                } else {
+                    left  = sum[0].sum();
+                    right = sum[1].sum();
+                }
+                outL[k + j] = left * scale;
+                outR[k + j] = right * scale;
+            }
+
+            k += run;
+            mWriteRow = (mWriteRow + run) & mCombRowMask;
+        }
+
+        for (int v = 0; v < kActive; ++v) store[v].store(mCombStore + v * W);
+        if constexpr (kGains) {
+            for (int v = 0; v < kActive; ++v) gain[v].store(mCombGain + v * W);
+        }
+    }
+
+    // Each all-pass writes at its head and reads `length` samples back. Runs
+    // are capped at `length`, so a run never reads what it has just written.
+    void processAllPass(Arena &arena, int index, float *io, int n) {
+        const DelayLine &line  = mAllPassRing[index];
+        const int   length     = mAllPassLength[index];
+        Sample     *buf        = arena.data(line);
+        int         head       = mAllPassHead[index];
+
+        int i = 0;
+        while (i < n) {
+            int tail = (head - length) & line.mask;
+            int run  = std::min({ n - i, line.size - head, line.size - tail, length });
+            if constexpr (kFloatRings) {
+                allPassRun(buf + tail, buf + head, io + i, run);
+            } else {
+                alignas(kCacheLineBytes) float r[kChunk];
+                alignas(kCacheLineBytes) float w[kChunk];
+                for (int k = 0; k < run; k += kChunk) {
+                    const int m = std::min(kChunk, run - k);
+                    decodeDelaySamples(buf + tail + k, r, m);
+                    allPassRun(r, w, io + i + k, m);
+                    encodeDelaySamples(w, buf + head + k, m);
+                }
+            }
+            i   += run;
+            head = (head + run) & line.mask;
+        }
+        mAllPassHead[index] = head;
+    }
+
+    // One run: w = x + r·fb, x = r − x.
+    static void allPassRun(const float *r, float *w, float *x, int run) {
+        constexpr int W = SIMDFloat::kWidth;
+        const float     fb  = FreeverbTuning::kAllPassFeedback;
+        const SIMDFloat fbV = SIMDFloat::broadcast(fb);
+        int k = 0;
+        for (; k + W <= run; k += W) {
+            SIMDFloat in  = SIMDFloat::load(x + k);
+            SIMDFloat out = SIMDFloat::load(r + k);
+            (in + out * fbV).store(w + k);
+            (out - in).store(x + k);
+        }
+        for (; k < run; ++k) {
+            float in  = x[k];
+            float out = r[k];
+            w[k] = in + out * fb;
+            x[k] = out - in;
+        }
+    }
+
+    DelayLine mCombRing;           // mCombRows rows of kCombLanes floats
+    int  mCombRows    = 0;         // power of two
+    int  mCombRowMask = 0;
+    int  mWriteRow    = 0;
+    int  mLongestComb = 0;
+    bool mLaidOut     = false;
+    int  mCombLength[kCombLanes] = {};
+    alignas(kCacheLineBytes) float mCombStore[kCombLanes] = {};  // damping LP state per lane
+
+    // Combs per side, as vectors of lanes: kVectors (8 a side) or half (4)
+    int mActiveVectors  = kVectors;  // run this call: all of them while a fade is in progress
+    int mTargetVectors  = kVectors;
+    int mGainFramesLeft = 0;         // of the crossfade to mTargetVectors
+    alignas(kCacheLineBytes) float mCombGain[kCombLanes]     = { kCombScale, kCombScale, kCombScale, kCombScale,
+                                                                  kCombScale, kCombScale, kCombScale, kCombScale,
+                                                                  kCombScale, kCombScale, kCombScale, kCombScale,
+                                                                  kCombScale, kCombScale, kCombScale, kCombScale };
+    alignas(kCacheLineBytes) float mCombGainStep[kCombLanes] = {};
+
+    DelayLine mAllPassRing[kAllPasses];
+    int mAllPassLength[kAllPasses] = {};
+    int mAllPassHead[kAllPasses]   = {};  // write index
+};
+
+using FreeverbBank = FreeverbBankT<float>;
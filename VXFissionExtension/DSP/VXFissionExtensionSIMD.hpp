@@ -0,0 +1,258 @@
+//
+//  VXFissionExtensionSIMD.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+
+// Define VXFISSION_SIMD_FORCE_SCALAR to build the plain-float fallback on any target.
+#if defined(VXFISSION_SIMD_FORCE_SCALAR)
+    #define VXFISSION_SIMD_SCALAR 1
+#elif defined(__AVX2__)
+    #include <immintrin.h>
+    #define VXFISSION_SIMD_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define VXFISSION_SIMD_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define VXFISSION_SIMD_NEON 1
+#else
+    #define VXFISSION_SIMD_SCALAR 1
+#endif
+
+/*
+ SIMDFloat
+ Thin wrapper over the widest float vector the target was compiled for:
+ AVX2 (8 lanes), SSE2 / NEON (4 lanes), or a plain float as the fallback.
+ Only the handful of operations the DSP actually uses are provided.
+ */
+struct SIMDFloat {
+#if VXFISSION_SIMD_AVX2
+    static constexpr int kWidth = 8;
+    __m256 v;
+    static SIMDFloat load(const float *p)           { return { _mm256_loadu_ps(p) }; }
+    static SIMDFloat broadcast(float x)             { return { _mm256_set1_ps(x) }; }
+    void store(float *p) const                      { _mm256_storeu_ps(p, v); }
+    // p[offsets[i]] for each lane.
+    static SIMDFloat gather(const float *p, const int32_t *offsets) {
+        return { _mm256_i32gather_ps(p, _mm256_loadu_si256((const __m256i *)offsets), 4) };
+    }
+    friend SIMDFloat operator+(SIMDFloat a, SIMDFloat b) { return { _mm256_add_ps(a.v, b.v) }; }
+    friend SIMDFloat operator-(SIMDFloat a, SIMDFloat b) { return { _mm256_sub_ps(a.v, b.v) }; }
+    friend SIMDFloat operator*(SIMDFloat a, SIMDFloat b) { return { _mm256_mul_ps(a.v, b.v) }; }
+    static SIMDFloat max(SIMDFloat a, SIMDFloat b)       { return { _mm256_max_ps(a.v, b.v) }; }
+    SIMDFloat abs() const { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v) }; }
+    float sum() const {
+        __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+        return _mm_cvtss_f32(s);
+    }
+    // Sums of lanes [0, W/2) and [W/2, W), each reduced in the same order as sum().
+    void halfSums(float &lower, float &upper) const {
+        auto reduce = [](__m128 s) {
+            s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+            s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+            return _mm_cvtss_f32(s);
+        };
+        lower = reduce(_mm256_castps256_ps128(v));
+        upper = reduce(_mm256_extractf128_ps(v, 1));
+    }
+    float maxElement() const {
+        __m128 m = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+        m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+        return _mm_cvtss_f32(m);
+    }
+#elif VXFISSION_SIMD_SSE
+    static constexpr int kWidth = 4;
+    __m128 v;
+    static SIMDFloat load(const float *p)           { return { _mm_loadu_ps(p) }; }
+    static SIMDFloat broadcast(float x)             { return { _mm_set1_ps(x) }; }
+    void store(float *p) const                      { _mm_storeu_ps(p, v); }
+    static SIMDFloat gather(const float *p, const int32_t *offsets) {
+        return { _mm_setr_ps(p[offsets[0]], p[offsets[1]], p[offsets[2]], p[offsets[3]]) };
+    }
+    friend SIMDFloat operator+(SIMDFloat a, SIMDFloat b) { return { _mm_add_ps(a.v, b.v) }; }
+    friend SIMDFloat operator-(SIMDFloat a, SIMDFloat b) { return { _mm_sub_ps(a.v, b.v) }; }
+    friend SIMDFloat operator*(SIMDFloat a, SIMDFloat b) { return { _mm_mul_ps(a.v, b.v) }; }
+    static SIMDFloat max(SIMDFloat a, SIMDFloat b)       { return { _mm_max_ps(a.v, b.v) }; }
+    SIMDFloat abs() const { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), v) }; }
+    float sum() const {
+        __m128 s = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+        return _mm_cvtss_f32(s);
+    }
+    void halfSums(float &lower, float &upper) const {
+        __m128 s = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+        lower = _mm_cvtss_f32(s);
+        upper = _mm_cvtss_f32(_mm_movehl_ps(s, s));
+    }
+    float maxElement() const {
+        __m128 m = _mm_max_ps(v, _mm_movehl_ps(v, v));
+        m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+        return _mm_cvtss_f32(m);
+    }
+#elif VXFISSION_SIMD_NEON
+    static constexpr int kWidth = 4;
+    float32x4_t v;
+    static SIMDFloat load(const float *p)           { return { vld1q_f32(p) }; }
+    static SIMDFloat broadcast(float x)             { return { vdupq_n_f32(x) }; }
+    void store(float *p) const                      { vst1q_f32(p, v); }
+    static SIMDFloat gather(const float *p, const int32_t *offsets) {
+        float32x4_t r = vdupq_n_f32(0.0f);
+        r = vld1q_lane_f32(p + offsets[0], r, 0);
+        r = vld1q_lane_f32(p + offsets[1], r, 1);
+        r = vld1q_lane_f32(p + offsets[2], r, 2);
+        r = vld1q_lane_f32(p + offsets[3], r, 3);
+        return { r };
+    }
+    friend SIMDFloat operator+(SIMDFloat a, SIMDFloat b) { return { vaddq_f32(a.v, b.v) }; }
+    friend SIMDFloat operator-(SIMDFloat a, SIMDFloat b) { return { vsubq_f32(a.v, b.v) }; }
+    friend SIMDFloat operator*(SIMDFloat a, SIMDFloat b) { return { vmulq_f32(a.v, b.v) }; }
+    static SIMDFloat max(SIMDFloat a, SIMDFloat b)       { return { vmaxq_f32(a.v, b.v) }; }
+    SIMDFloat abs() const { return { vabsq_f32(v) }; }
+    float sum() const {
+    #if defined(__aarch64__)
+        return vaddvq_f32(v);
+    #else
+        float32x2_t s = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+        return vget_lane_f32(vpadd_f32(s, s), 0);
+    #endif
+    }
+    void halfSums(float &lower, float &upper) const {
+        float32x2_t s = vpadd_f32(vget_low_f32(v), vget_high_f32(v));
+        lower = vget_lane_f32(s, 0);
+        upper = vget_lane_f32(s, 1);
+    }
+    float maxElement() const {
+    #if defined(__aarch64__)
+        return vmaxvq_f32(v);
+    #else
+        float32x2_t m = vmax_f32(vget_low_f32(v), vget_high_f32(v));
+        return vget_lane_f32(vpmax_f32(m, m), 0);
+    #endif
+    }
+#else
+    static constexpr int kWidth = 1;
+    float v;
+    static SIMDFloat load(const float *p)           { return { *p }; }
+    static SIMDFloat broadcast(float x)             { return { x }; }
+    void store(float *p) const                      { *p = v; }
+    static SIMDFloat gather(const float *p, const int32_t *offsets) { return { p[offsets[0]] }; }
+    friend SIMDFloat operator+(SIMDFloat a, SIMDFloat b) { return { a.v + b.v }; }
+    friend SIMDFloat operator-(SIMDFloat a, SIMDFloat b) { return { a.v - b.v }; }
+    friend SIMDFloat operator*(SIMDFloat a, SIMDFloat b) { return { a.v * b.v }; }
+    static SIMDFloat max(SIMDFloat a, SIMDFloat b)       { return { a.v > b.v ? a.v : b.v }; }
+    SIMDFloat abs() const { return { v < 0.0f ? -v : v }; }
+    float sum() const { return v; }
+    void halfSums(float &lower, float &upper) const { lower = v; upper = 0.0f; }
+    float maxElement() const { return v; }
+#endif
+};
+
+// Largest |x[i]| over n samples.
+inline float peakAbs(const float *x, size_t n) {
+    constexpr size_t W = SIMDFloat::kWidth;
+    SIMDFloat peak = SIMDFloat::broadcast(0.0f);
+    size_t i = 0;
+    for (; i + W <= n; i += W) peak = SIMDFloat::max(peak, SIMDFloat::load(x + i).abs());
+    float result = peak.maxElement();
+    for (; i < n; ++i) result = std::max(result, std::fabs(x[i]));
+    return result;
+}
+
+// Σ x[i]² over n samples.
+inline float sumOfSquares(const float *x, size_t n) {
+    constexpr size_t W = SIMDFloat::kWidth;
+    SIMDFloat acc = SIMDFloat::broadcast(0.0f);
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+        SIMDFloat v = SIMDFloat::load(x + i);
+        acc = acc + v * v;
+    }
+    float result = acc.sum();
+    for (; i < n; ++i) result += x[i] * x[i];
+    return result;
+}
+
+inline const char *simdInstructionSetName() {
+#if VXFISSION_SIMD_AVX2
+    return "AVX2";
+#elif VXFISSION_SIMD_SSE
+    return "SSE2";
+#elif VXFISSION_SIMD_NEON
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+// ─── Cache-line aligned storage ──────────────────────────────────────────────
+
+constexpr size_t kCacheLineBytes = 64;
+constexpr size_t kFloatsPerCacheLine = kCacheLineBytes / sizeof(float);
+
+// Rounds a float count up to a whole number of cache lines.
+constexpr size_t roundUpToCacheLine(size_t floats) {
+    return (floats + kFloatsPerCacheLine - 1) / kFloatsPerCacheLine * kFloatsPerCacheLine;
+}
+
+/*
+ AlignedFloatBuffer
+ A single zero-initialised, cache-line aligned float allocation. assign()
+ only allocates when the new size exceeds what is already held, so resizing
+ down and back up reuses the block; clear() just zeroes. Copies are deep.
+ */
+class AlignedFloatBuffer {
+public:
+    AlignedFloatBuffer() = default;
+    AlignedFloatBuffer(const AlignedFloatBuffer &other) { *this = other; }
+    AlignedFloatBuffer &operator=(const AlignedFloatBuffer &other) {
+        if (this != &other) {
+            assign(other.mSize);
+            if (mSize) std::memcpy(mData.get(), other.mData.get(), mSize * sizeof(float));
+        }
+        return *this;
+    }
+
+    void assign(size_t count) {
+        if (count > mCapacity) {
+            mData.reset(static_cast<float *>(::operator new(count * sizeof(float), std::align_val_t(kCacheLineBytes))));
+            mCapacity = count;
+        }
+        mSize = count;
+        clear();
+    }
+    void release() {
+        mData.reset();
+        mSize     = 0;
+        mCapacity = 0;
+    }
+    void clear() {
+        if (mSize) std::memset(mData.get(), 0, mSize * sizeof(float));
+    }
+    float       *data()       { return mData.get(); }
+    const float *data() const { return mData.get(); }
+    size_t size() const       { return mSize; }
+    bool empty() const        { return mSize == 0; }
+
+private:
+    struct Deleter {
+        void operator()(float *p) const { ::operator delete(p, std::align_val_t(kCacheLineBytes)); }
+    };
+    std::unique_ptr<float, Deleter> mData;
+    size_t mSize     = 0;
+    size_t mCapacity = 0;
+};
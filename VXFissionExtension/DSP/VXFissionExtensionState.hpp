@@ -0,0 +1,83 @@
+//
+//  VXFissionExtensionState.hpp
+//  VXFissionExtension
+//
+//  Created by Taylor Page on 1/22/26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// ─── State snapshots ─────────────────────────────────────────────────────────
+// The running state of the signal path — rings, filter histories, envelopes,
+// LFO, smoothers — written as a flat run of native-endian bytes. Each stateful
+// class has a saveState() / loadState() pair that writes and reads its fields
+// in the same order. There are no per-field tags: the owner checks a layout
+// key and the total length before loading, so a snapshot only ever goes back
+// into a signal path laid out exactly like the one that wrote it, and a load
+// that has passed those checks cannot run short. Offline only: writing
+// allocates.
+
+class VXFissionStateWriter {
+public:
+    explicit VXFissionStateWriter(std::vector<uint8_t> &bytes) : mBytes(bytes) {}
+
+    template <typename T>
+    void value(const T &v) {
+        static_assert(std::is_trivially_copyable_v<T>, "state values are copied as bytes");
+        bytes(&v, sizeof(T));
+    }
+
+    void floats(const float *data, size_t count) {
+        bytes(data, count * sizeof(float));
+    }
+
+    void bytes(const void *data, size_t count) {
+        const uint8_t *first = static_cast<const uint8_t *>(data);
+        mBytes.insert(mBytes.end(), first, first + count);
+    }
+
+    size_t size() const { return mBytes.size(); }
+
+private:
+    std::vector<uint8_t> &mBytes;
+};
+
+class VXFissionStateReader {
+public:
+    explicit VXFissionStateReader(std::span<const uint8_t> bytes) : mBytes(bytes) {}
+
+    template <typename T>
+    void value(T &v) {
+        static_assert(std::is_trivially_copyable_v<T>, "state values are copied as bytes");
+        bytes(&v, sizeof(T));
+    }
+
+    void floats(float *data, size_t count) {
+        bytes(data, count * sizeof(float));
+    }
+
+    void bytes(void *data, size_t count) {
+        if (!mOk || count > remaining()) {
+            mOk = false;
+            return;
+        }
+        std::memcpy(data, mBytes.data() + mPosition, count);
+        mPosition += count;
+    }
+
+    // False once a read has run past the end; the value read is left as it was.
+    bool ok() const { return mOk; }
+    size_t remaining() const { return mBytes.size() - mPosition; }
+
+private:
+    std::span<const uint8_t> mBytes;
+    size_t mPosition = 0;
+    bool   mOk       = true;
+};
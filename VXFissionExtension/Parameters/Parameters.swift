@@ -26,6 +26,38 @@ let VXFissionExtensionParameterSpecs = ParameterTreeSpec {
             valueRange: 0.0...1.0,
             defaultValue: 0.0
         )
+        ParameterSpec(
+            address: .oversampling,
+            identifier: "oversampling",
+            name: "Oversampling",
+            units: .indexed,
+            valueRange: 0.0...2.0,
+            defaultValue: 0.0,
+            valueStrings: ["Off", "2x", "4x"]
+        )
+        // Auto steps the tier down when this instance's render time nears a
+        // quarter of each buffer period (VXFissionGovernorSettings.budgetShare).
+        // It cannot see the rest of the host's graph, so a session that is late
+        // because of other plugins is not caught.
+        ParameterSpec(
+            address: .quality,
+            identifier: "quality",
+            name: "Quality",
+            units: .indexed,
+            valueRange: 0.0...3.0,
+            defaultValue: 0.0,
+            valueStrings: ["Auto", "Eco", "Standard", "High"]
+        )
+        ParameterSpec(
+            address: .qualityTier,
+            identifier: "qualityTier",
+            name: "Quality Tier",
+            units: .indexed,
+            valueRange: 0.0...2.0,
+            defaultValue: 1.0,
+            flags: [AudioUnitParameterOptions.flag_IsReadable, AudioUnitParameterOptions.flag_MeterReadOnly],
+            valueStrings: ["Eco", "Standard", "High"]
+        )
     }
 }
 
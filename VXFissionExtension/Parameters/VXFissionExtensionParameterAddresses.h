@@ -10,6 +10,9 @@
 #include <AudioToolbox/AUParameters.h>
 
 typedef NS_ENUM(AUParameterAddress, VXFissionExtensionParameterAddress) {
-    delayTime = 0,
-    bypass    = 1
+    delayTime    = 0,
+    bypass       = 1,
+    oversampling = 2,  // compressor oversampling: 0 = off, 1 = 2x, 2 = 4x
+    quality      = 3,  // wet-bus quality: 0 = auto, 1 = eco, 2 = standard, 3 = high
+    qualityTier  = 4   // read-only: the tier rendering now, 0 = eco, 1 = standard, 2 = high
 };
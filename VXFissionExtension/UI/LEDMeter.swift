@@ -2,16 +2,20 @@
 //  LEDMeter.swift
 //  VXFissionExtension
 //
-//  A horizontal LED meter that lights up based on delay amount.
+//  A horizontal LED meter showing the plugin's output peak level.
 //  Layout: [R] [Y] [G] [G] [G] [B] [G] [G] [G] [Y] [R]
-//  Blue center = plugin active. LEDs fill outward as gain increases.
+//  Blue center = plugin active. The left half meters the left channel and the
+//  right half the right channel; LEDs fill outward as the level rises.
 //
 
 import SwiftUI
 
 struct LEDMeter: View {
-    let delayParam: ObservableAUParameter
     let bypassParam: ObservableAUParameter
+    // Polled at display rate; returns levels rendered since the previous call.
+    let readMeters: () -> VXFissionMeterSnapshot?
+
+    @State private var ballistics = MeterBallistics()
 
     private struct LEDSpec {
         let distance: Int   // distance from center; 0 = blue, 1–3 = green, 4 = yellow, 5 = red
@@ -35,11 +39,12 @@ struct LEDMeter: View {
     // Plugin is active when not bypassed
     var isActive: Bool { !bypassParam.boolValue }
 
-    // Maps abs(delay time) to a level 0–5; center (0 ms) = 0, full deflection = 5
-    var level: Int {
-        let absMs = Double(abs(delayParam.value))
-        let maxMs = Double(delayParam.max) // 50.0
-        return min(Int((absMs / maxMs) * 5.0), 5)
+    // Peak level (dBFS) at which each LED distance lights: green, green, green, yellow, red
+    private static let thresholdsDb: [Double] = [-36, -24, -12, -6, -1]
+
+    // Maps a peak level in dBFS to a level 0–5
+    private static func level(forDb db: Double) -> Int {
+        thresholdsDb.filter { db >= $0 }.count
     }
 
     private let imageWidth: CGFloat = 300
@@ -71,13 +76,22 @@ struct LEDMeter: View {
                     )
             }
 
-            // LEDs centered over the holes
-            HStack(spacing: ledSpacing) {
-                ForEach(0..<11, id: \.self) { i in
-                    let spec = specs[i]
-                    let isCenter = spec.distance == 0
-                    let isLit = isActive && (isCenter || level >= spec.distance)
-                    ledView(color: spec.color, isLit: isLit)
+            // LEDs centered over the holes, refreshed at display rate. The meters
+            // are read once per tick, outside body, which must stay side-effect free.
+            TimelineView(.animation(minimumInterval: 1.0 / 30.0)) { context in
+                let leftLevel = Self.level(forDb: ballistics.leftDb)
+                let rightLevel = Self.level(forDb: ballistics.rightDb)
+                HStack(spacing: ledSpacing) {
+                    ForEach(0..<11, id: \.self) { i in
+                        let spec = specs[i]
+                        let isCenter = spec.distance == 0
+                        let level = i < 5 ? leftLevel : rightLevel
+                        let isLit = isActive && (isCenter || level >= spec.distance)
+                        ledView(color: spec.color, isLit: isLit)
+                    }
+                }
+                .onChange(of: context.date, initial: true) { _, date in
+                    ballistics.update(readMeters(), at: date)
                 }
             }
             .offset(y: ledOffsetY)
@@ -191,3 +205,27 @@ struct LEDMeter: View {
         .shadow(color: isLit ? color.opacity(0.4) : .clear, radius: 9)
     }
 }
+
+/// Peak hold with a fixed release, so the LEDs fall smoothly between polls
+/// instead of flickering with every render window. A value type, so each
+/// update is a state change SwiftUI sees.
+private struct MeterBallistics {
+    private(set) var leftDb: Double = MeterBallistics.floorDb
+    private(set) var rightDb: Double = MeterBallistics.floorDb
+    private var lastUpdate: Date?
+
+    private static let floorDb = -120.0
+    private static let releaseDbPerSecond = 24.0
+
+    mutating func update(_ snapshot: VXFissionMeterSnapshot?, at date: Date) {
+        let elapsed = lastUpdate.map { date.timeIntervalSince($0) } ?? 0
+        lastUpdate = date
+        let fall = Self.releaseDbPerSecond * max(elapsed, 0)
+        leftDb = max(leftDb - fall, Self.decibels(snapshot?.peakL ?? 0))
+        rightDb = max(rightDb - fall, Self.decibels(snapshot?.peakR ?? 0))
+    }
+
+    private static func decibels(_ linear: Float) -> Double {
+        linear > 0 ? max(20 * log10(Double(linear)), floorDb) : floorDb
+    }
+}
@@ -12,6 +12,7 @@ private let extensionBundle = Bundle(for: BundleToken.self)
 
 struct VXFissionExtensionMainView: View {
     var parameterTree: ObservableAUParameterGroup
+    var readMeters: () -> VXFissionMeterSnapshot? = { nil }
 
     var body: some View {
         ZStack {
@@ -42,8 +43,8 @@ struct VXFissionExtensionMainView: View {
             // LED meter top-center
             VStack {
                 LEDMeter(
-                    delayParam: parameterTree.global.delayTime,
-                    bypassParam: parameterTree.global.bypass
+                    bypassParam: parameterTree.global.bypass,
+                    readMeters: readMeters
                 )
                 .padding(.top, 50)
 Spacer()